@@ -114,7 +114,7 @@ Error HTTPClient::request_raw(Method p_method, const String &p_url, const Vector
 
 	ERR_FAIL_INDEX_V(p_method, METHOD_MAX, ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(!p_url.begins_with("/"), ERR_INVALID_PARAMETER);
-	ERR_FAIL_COND_V(status != STATUS_CONNECTED, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!_can_request(), ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(connection.is_null(), ERR_INVALID_DATA);
 
 	String request = String(_methods[p_method]) + " " + p_url + " HTTP/1.1\r\n";
@@ -172,8 +172,10 @@ Error HTTPClient::request_raw(Method p_method, const String &p_url, const Vector
 		return err;
 	}
 
-	status = STATUS_REQUESTING;
-	head_request = p_method == METHOD_HEAD;
+	if (status == STATUS_CONNECTED) {
+		status = STATUS_REQUESTING;
+	}
+	pending_requests.push_back(p_method == METHOD_HEAD);
 
 	return OK;
 }
@@ -182,7 +184,7 @@ Error HTTPClient::request(Method p_method, const String &p_url, const Vector<Str
 
 	ERR_FAIL_INDEX_V(p_method, METHOD_MAX, ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(!p_url.begins_with("/"), ERR_INVALID_PARAMETER);
-	ERR_FAIL_COND_V(status != STATUS_CONNECTED, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!_can_request(), ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(connection.is_null(), ERR_INVALID_DATA);
 
 	String request = String(_methods[p_method]) + " " + p_url + " HTTP/1.1\r\n";
@@ -228,12 +230,33 @@ Error HTTPClient::request(Method p_method, const String &p_url, const Vector<Str
 		return err;
 	}
 
-	status = STATUS_REQUESTING;
-	head_request = p_method == METHOD_HEAD;
+	if (status == STATUS_CONNECTED) {
+		status = STATUS_REQUESTING;
+	}
+	pending_requests.push_back(p_method == METHOD_HEAD);
 
 	return OK;
 }
 
+bool HTTPClient::_can_request() const {
+
+	// The server said it will close the connection after its last response.
+	if (!keep_alive)
+		return false;
+
+	if (status == STATUS_CONNECTED)
+		return true;
+
+	// Further requests can be queued on the connection while earlier
+	// responses are still being received.
+	return pipelining && (status == STATUS_REQUESTING || status == STATUS_BODY);
+}
+
+void HTTPClient::_response_done() {
+
+	status = pending_requests.empty() ? STATUS_CONNECTED : STATUS_REQUESTING;
+}
+
 bool HTTPClient::has_response() const {
 
 	return response_headers.size() != 0;
@@ -272,6 +295,8 @@ void HTTPClient::close() {
 	connection.unref();
 	status = STATUS_DISCONNECTED;
 	head_request = false;
+	keep_alive = true;
+	pending_requests.clear();
 	if (resolving != IP::RESOLVER_INVALID_ID) {
 
 		IP::get_singleton()->erase_resolve_item(resolving);
@@ -439,10 +464,18 @@ Error HTTPClient::poll() {
 					response_headers.clear();
 					response_num = RESPONSE_OK;
 
+					head_request = false;
+					if (!pending_requests.empty()) {
+						head_request = pending_requests.front()->get();
+						pending_requests.pop_front();
+					}
+
 					// Per the HTTP 1.1 spec, keep-alive is the default.
 					// Not following that specification breaks standard implementations.
 					// Broken web servers should be fixed.
-					bool keep_alive = true;
+					// Once a response says otherwise, it sticks until the connection is closed.
+					bool http_1_0 = responses.size() && responses[0].begins_with("HTTP/1.0");
+					bool keep_alive_header = false;
 
 					for (int i = 0; i < responses.size(); i++) {
 
@@ -461,6 +494,8 @@ Error HTTPClient::poll() {
 							}
 						} else if (s.begins_with("connection: close")) {
 							keep_alive = false;
+						} else if (s.begins_with("connection: keep-alive")) {
+							keep_alive_header = true;
 						}
 
 						if (i == 0 && responses[i].begins_with("HTTP")) {
@@ -473,6 +508,10 @@ Error HTTPClient::poll() {
 						}
 					}
 
+					if (http_1_0 && !keep_alive_header) {
+						keep_alive = false;
+					}
+
 					// This is a HEAD request, we wont receive anything.
 					if (head_request) {
 						body_size = 0;
@@ -488,7 +527,7 @@ Error HTTPClient::poll() {
 						status = STATUS_BODY;
 					} else {
 
-						status = STATUS_CONNECTED;
+						_response_done();
 					}
 					return OK;
 				}
@@ -543,7 +582,7 @@ PoolByteArray HTTPClient::read_response_body_chunk() {
 					if (cs == 2) {
 						// Finally over
 						chunk_trailer_part = false;
-						status = STATUS_CONNECTED;
+						_response_done();
 						chunk.clear();
 						break;
 					} else {
@@ -670,7 +709,7 @@ PoolByteArray HTTPClient::read_response_body_chunk() {
 		}
 	} else if (body_left == 0 && !chunked && !read_until_eof) {
 
-		status = STATUS_CONNECTED;
+		_response_done();
 	}
 
 	return ret;
@@ -728,6 +767,26 @@ int HTTPClient::get_read_chunk_size() const {
 	return read_chunk_size;
 }
 
+void HTTPClient::set_pipelining_enabled(bool p_enable) {
+
+	pipelining = p_enable;
+}
+
+bool HTTPClient::is_pipelining_enabled() const {
+
+	return pipelining;
+}
+
+int HTTPClient::get_pending_request_count() const {
+
+	return pending_requests.size();
+}
+
+bool HTTPClient::is_keep_alive() const {
+
+	return keep_alive;
+}
+
 HTTPClient::HTTPClient() {
 
 	tcp_connection.instance();
@@ -745,6 +804,8 @@ HTTPClient::HTTPClient() {
 	ssl = false;
 	blocking = false;
 	handshaking = false;
+	pipelining = false;
+	keep_alive = true;
 	read_chunk_size = 4096;
 }
 
@@ -833,6 +894,9 @@ void HTTPClient::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("read_response_body_chunk"), &HTTPClient::read_response_body_chunk);
 	ClassDB::bind_method(D_METHOD("set_read_chunk_size", "bytes"), &HTTPClient::set_read_chunk_size);
 	ClassDB::bind_method(D_METHOD("get_read_chunk_size"), &HTTPClient::get_read_chunk_size);
+	ClassDB::bind_method(D_METHOD("set_pipelining_enabled", "enabled"), &HTTPClient::set_pipelining_enabled);
+	ClassDB::bind_method(D_METHOD("is_pipelining_enabled"), &HTTPClient::is_pipelining_enabled);
+	ClassDB::bind_method(D_METHOD("get_pending_request_count"), &HTTPClient::get_pending_request_count);
 
 	ClassDB::bind_method(D_METHOD("set_blocking_mode", "enabled"), &HTTPClient::set_blocking_mode);
 	ClassDB::bind_method(D_METHOD("is_blocking_mode_enabled"), &HTTPClient::is_blocking_mode_enabled);
@@ -844,6 +908,7 @@ void HTTPClient::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "blocking_mode_enabled"), "set_blocking_mode", "is_blocking_mode_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "connection", PROPERTY_HINT_RESOURCE_TYPE, "StreamPeer", 0), "set_connection", "get_connection");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "pipelining_enabled"), "set_pipelining_enabled", "is_pipelining_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "read_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_read_chunk_size", "get_read_chunk_size");
 
 	BIND_ENUM_CONSTANT(METHOD_GET);
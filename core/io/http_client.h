@@ -167,6 +167,9 @@ private:
 	bool blocking;
 	bool handshaking;
 	bool head_request;
+	bool pipelining;
+	bool keep_alive; // False once a response said the server will close the connection.
+	List<bool> pending_requests; // Whether each request still waiting for its response was a HEAD.
 
 	Vector<uint8_t> response_str;
 
@@ -186,6 +189,8 @@ private:
 	int read_chunk_size;
 
 	Error _get_http_data(uint8_t *p_buffer, int p_bytes, int &r_received);
+	bool _can_request() const;
+	void _response_done();
 
 #else
 #include "platform/javascript/http_client.h.inc"
@@ -223,6 +228,11 @@ public:
 	void set_read_chunk_size(int p_size);
 	int get_read_chunk_size() const;
 
+	void set_pipelining_enabled(bool p_enable); // Allow requests before the previous responses are read
+	bool is_pipelining_enabled() const;
+	int get_pending_request_count() const;
+	bool is_keep_alive() const; // Whether more requests can be sent on this connection
+
 	Error poll();
 
 	String query_string_from_dict(const Dictionary &p_dict);
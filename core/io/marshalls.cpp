@@ -1387,3 +1387,569 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+// Same encoding as String::utf8(), written in place. Returns the byte count.
+static int _encode_utf8(const CharType *p_str, int p_len, uint8_t *r_dst) {
+
+	uint8_t *dst = r_dst;
+
+	for (int i = 0; i < p_len; i++) {
+
+		uint32_t c = p_str[i];
+
+		if (c <= 0x7f) {
+			*(dst++) = c;
+		} else if (c <= 0x7ff) {
+			*(dst++) = uint32_t(0xc0 | ((c >> 6) & 0x1f));
+			*(dst++) = uint32_t(0x80 | (c & 0x3f));
+		} else if (c <= 0xffff) {
+			*(dst++) = uint32_t(0xe0 | ((c >> 12) & 0x0f));
+			*(dst++) = uint32_t(0x80 | ((c >> 6) & 0x3f));
+			*(dst++) = uint32_t(0x80 | (c & 0x3f));
+		} else if (c <= 0x001fffff) {
+			*(dst++) = uint32_t(0xf0 | ((c >> 18) & 0x07));
+			*(dst++) = uint32_t(0x80 | ((c >> 12) & 0x3f));
+			*(dst++) = uint32_t(0x80 | ((c >> 6) & 0x3f));
+			*(dst++) = uint32_t(0x80 | (c & 0x3f));
+		} else if (c <= 0x03ffffff) {
+			*(dst++) = uint32_t(0xf8 | ((c >> 24) & 0x03));
+			*(dst++) = uint32_t(0x80 | ((c >> 18) & 0x3f));
+			*(dst++) = uint32_t(0x80 | ((c >> 12) & 0x3f));
+			*(dst++) = uint32_t(0x80 | ((c >> 6) & 0x3f));
+			*(dst++) = uint32_t(0x80 | (c & 0x3f));
+		} else if (c <= 0x7fffffff) {
+			*(dst++) = uint32_t(0xfc | ((c >> 30) & 0x01));
+			*(dst++) = uint32_t(0x80 | ((c >> 24) & 0x3f));
+			*(dst++) = uint32_t(0x80 | ((c >> 18) & 0x3f));
+			*(dst++) = uint32_t(0x80 | ((c >> 12) & 0x3f));
+			*(dst++) = uint32_t(0x80 | ((c >> 6) & 0x3f));
+			*(dst++) = uint32_t(0x80 | (c & 0x3f));
+		}
+	}
+
+	return dst - r_dst;
+}
+
+// Returns NULL once the value would grow past max_size. The helpers below then
+// skip their writes and write() reports the overflow at the end.
+uint8_t *VariantEncoder::_reserve(int p_bytes) {
+
+	if (unlikely(int64_t(size) + p_bytes > buffer.size())) {
+		int64_t needed = int64_t(size) + p_bytes;
+		if (needed > max_size) {
+			overflow = true;
+			return NULL;
+		}
+		int64_t grown = next_power_of_2(uint32_t(needed));
+		if (buffer.resize(MIN(grown, int64_t(max_size))) != OK) {
+			overflow = true;
+			return NULL;
+		}
+	}
+	return buffer.ptrw() + size;
+}
+
+void VariantEncoder::_put_u32(uint32_t p_value) {
+
+	uint8_t *w = _reserve(4);
+	if (!w)
+		return;
+	encode_uint32(p_value, w);
+	size += 4;
+}
+
+void VariantEncoder::_put_string(const String &p_string, bool p_terminate) {
+
+	int len = p_string.length();
+	// Worst case of six bytes per character, plus terminator and padding.
+	uint8_t *w = _reserve(4 + len * 6 + 4);
+	if (!w)
+		return;
+	int bytes = len ? _encode_utf8(p_string.ptr(), len, w + 4) : 0;
+	if (p_terminate) {
+		w[4 + bytes++] = 0;
+	}
+	encode_uint32(bytes, w);
+	size += 4 + bytes;
+	_pad();
+}
+
+void VariantEncoder::_pad() {
+
+	int pad = (4 - (size % 4)) % 4;
+	if (pad) {
+		uint8_t *w = _reserve(pad);
+		if (!w)
+			return;
+		for (int i = 0; i < pad; i++) {
+			w[i] = 0;
+		}
+		size += pad;
+	}
+}
+
+Error VariantEncoder::_write(const Variant &p_variant) {
+
+	if (overflow) {
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	uint32_t flags = 0;
+
+	switch (p_variant.get_type()) {
+
+		case Variant::INT: {
+			int64_t val = p_variant;
+			if (val > (int64_t)INT_MAX || val < (int64_t)INT_MIN) {
+				flags |= ENCODE_FLAG_64;
+			}
+		} break;
+		case Variant::REAL: {
+
+			double d = p_variant;
+			float f = d;
+			if (double(f) != d) {
+				flags |= ENCODE_FLAG_64;
+			}
+		} break;
+		case Variant::OBJECT: {
+#ifdef DEBUG_ENABLED
+			Object *obj = p_variant;
+			if (!obj || !ObjectDB::instance_validate(obj)) {
+				_put_u32(Variant::NIL);
+				return OK;
+			}
+#endif // DEBUG_ENABLED
+			if (!full_objects) {
+				flags |= ENCODE_FLAG_OBJECT_AS_ID;
+			}
+		} break;
+		default: {
+		}
+	}
+
+	_put_u32(p_variant.get_type() | flags);
+
+	switch (p_variant.get_type()) {
+
+		case Variant::NIL:
+		case Variant::_RID: {
+
+		} break;
+		case Variant::BOOL: {
+
+			_put_u32(p_variant.operator bool());
+		} break;
+		case Variant::INT: {
+
+			if (flags & ENCODE_FLAG_64) {
+				uint8_t *w = _reserve(8);
+				if (!w)
+					return ERR_OUT_OF_MEMORY;
+				encode_uint64(p_variant.operator int64_t(), w);
+				size += 8;
+			} else {
+				_put_u32(p_variant.operator int32_t());
+			}
+		} break;
+		case Variant::REAL: {
+
+			if (flags & ENCODE_FLAG_64) {
+				uint8_t *w = _reserve(8);
+				if (!w)
+					return ERR_OUT_OF_MEMORY;
+				encode_double(p_variant.operator double(), w);
+				size += 8;
+			} else {
+				uint8_t *w = _reserve(4);
+				if (!w)
+					return ERR_OUT_OF_MEMORY;
+				encode_float(p_variant.operator float(), w);
+				size += 4;
+			}
+		} break;
+		case Variant::STRING: {
+
+			_put_string(p_variant, false);
+		} break;
+		case Variant::NODE_PATH: {
+
+			NodePath np = p_variant;
+			_put_u32(uint32_t(np.get_name_count()) | 0x80000000); //for compatibility with the old format
+			_put_u32(np.get_subname_count());
+			_put_u32(np.is_absolute() ? 1 : 0);
+
+			for (int i = 0; i < np.get_name_count(); i++) {
+				_put_string(np.get_name(i), false);
+			}
+			for (int i = 0; i < np.get_subname_count(); i++) {
+				_put_string(np.get_subname(i), false);
+			}
+		} break;
+		case Variant::VECTOR2: {
+
+			Vector2 v2 = p_variant;
+			uint8_t *w = _reserve(2 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(v2.x, &w[0]);
+			encode_float(v2.y, &w[4]);
+			size += 2 * 4;
+		} break;
+		case Variant::RECT2: {
+
+			Rect2 r2 = p_variant;
+			uint8_t *w = _reserve(4 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(r2.position.x, &w[0]);
+			encode_float(r2.position.y, &w[4]);
+			encode_float(r2.size.x, &w[8]);
+			encode_float(r2.size.y, &w[12]);
+			size += 4 * 4;
+		} break;
+		case Variant::VECTOR3: {
+
+			Vector3 v3 = p_variant;
+			uint8_t *w = _reserve(3 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(v3.x, &w[0]);
+			encode_float(v3.y, &w[4]);
+			encode_float(v3.z, &w[8]);
+			size += 3 * 4;
+		} break;
+		case Variant::TRANSFORM2D: {
+
+			Transform2D val = p_variant;
+			uint8_t *w = _reserve(6 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 2; j++) {
+					encode_float(val.elements[i][j], &w[(i * 2 + j) * 4]);
+				}
+			}
+			size += 6 * 4;
+		} break;
+		case Variant::PLANE: {
+
+			Plane p = p_variant;
+			uint8_t *w = _reserve(4 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(p.normal.x, &w[0]);
+			encode_float(p.normal.y, &w[4]);
+			encode_float(p.normal.z, &w[8]);
+			encode_float(p.d, &w[12]);
+			size += 4 * 4;
+		} break;
+		case Variant::QUAT: {
+
+			Quat q = p_variant;
+			uint8_t *w = _reserve(4 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(q.x, &w[0]);
+			encode_float(q.y, &w[4]);
+			encode_float(q.z, &w[8]);
+			encode_float(q.w, &w[12]);
+			size += 4 * 4;
+		} break;
+		case Variant::AABB: {
+
+			AABB aabb = p_variant;
+			uint8_t *w = _reserve(6 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(aabb.position.x, &w[0]);
+			encode_float(aabb.position.y, &w[4]);
+			encode_float(aabb.position.z, &w[8]);
+			encode_float(aabb.size.x, &w[12]);
+			encode_float(aabb.size.y, &w[16]);
+			encode_float(aabb.size.z, &w[20]);
+			size += 6 * 4;
+		} break;
+		case Variant::BASIS: {
+
+			Basis val = p_variant;
+			uint8_t *w = _reserve(9 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					encode_float(val.elements[i][j], &w[(i * 3 + j) * 4]);
+				}
+			}
+			size += 9 * 4;
+		} break;
+		case Variant::TRANSFORM: {
+
+			Transform val = p_variant;
+			uint8_t *w = _reserve(12 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					encode_float(val.basis.elements[i][j], &w[(i * 3 + j) * 4]);
+				}
+			}
+			encode_float(val.origin.x, &w[36]);
+			encode_float(val.origin.y, &w[40]);
+			encode_float(val.origin.z, &w[44]);
+			size += 12 * 4;
+		} break;
+		case Variant::COLOR: {
+
+			Color c = p_variant;
+			uint8_t *w = _reserve(4 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			encode_float(c.r, &w[0]);
+			encode_float(c.g, &w[4]);
+			encode_float(c.b, &w[8]);
+			encode_float(c.a, &w[12]);
+			size += 4 * 4;
+		} break;
+		case Variant::OBJECT: {
+
+			Object *obj = p_variant;
+
+			if (!full_objects) {
+				ObjectID id = 0;
+				if (obj && ObjectDB::instance_validate(obj)) {
+					id = obj->get_instance_id();
+				}
+				uint8_t *w = _reserve(8);
+				if (!w)
+					return ERR_OUT_OF_MEMORY;
+				encode_uint64(id, w);
+				size += 8;
+
+			} else if (!obj) {
+				_put_u32(0);
+
+			} else {
+				_put_string(obj->get_class(), false);
+
+				List<PropertyInfo> props;
+				obj->get_property_list(&props);
+
+				int pc = 0;
+				for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
+					if (E->get().usage & PROPERTY_USAGE_STORAGE)
+						pc++;
+				}
+				_put_u32(pc);
+
+				for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
+
+					if (!(E->get().usage & PROPERTY_USAGE_STORAGE))
+						continue;
+
+					_put_string(E->get().name, false);
+					Error err = _write(obj->get(E->get().name));
+					if (err)
+						return err;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+
+			Dictionary d = p_variant;
+			_put_u32(uint32_t(d.size()));
+
+			for (const Variant *K = d.next(); K; K = d.next(K)) {
+
+				Error err = _write(*K);
+				if (err)
+					return err;
+				const Variant *v = d.getptr(*K);
+				ERR_FAIL_COND_V(!v, ERR_BUG);
+				err = _write(*v);
+				if (err)
+					return err;
+			}
+		} break;
+		case Variant::ARRAY: {
+
+			Array a = p_variant;
+			_put_u32(uint32_t(a.size()));
+
+			for (int i = 0; i < a.size(); i++) {
+
+				Error err = _write(a[i]);
+				if (err)
+					return err;
+			}
+		} break;
+		case Variant::POOL_BYTE_ARRAY: {
+
+			PoolVector<uint8_t> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			if (len) {
+				uint8_t *w = _reserve(len);
+				if (!w)
+					return ERR_OUT_OF_MEMORY;
+				PoolVector<uint8_t>::Read r = data.read();
+				copymem(w, r.ptr(), len);
+				size += len;
+			}
+			_pad();
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+
+			PoolVector<int> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			PoolVector<int>::Read r = data.read();
+			uint8_t *w = _reserve(len * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < len; i++) {
+				encode_uint32(r[i], &w[i * 4]);
+			}
+			size += len * 4;
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+
+			PoolVector<real_t> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			PoolVector<real_t>::Read r = data.read();
+			uint8_t *w = _reserve(len * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < len; i++) {
+				encode_float(r[i], &w[i * 4]);
+			}
+			size += len * 4;
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+
+			PoolVector<String> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			PoolVector<String>::Read r = data.read();
+			for (int i = 0; i < len; i++) {
+				_put_string(r[i], true);
+			}
+		} break;
+		case Variant::POOL_VECTOR2_ARRAY: {
+
+			PoolVector<Vector2> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			PoolVector<Vector2>::Read r = data.read();
+			uint8_t *w = _reserve(len * 4 * 2);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < len; i++) {
+				encode_float(r[i].x, &w[0]);
+				encode_float(r[i].y, &w[4]);
+				w += 4 * 2;
+			}
+			size += len * 4 * 2;
+		} break;
+		case Variant::POOL_VECTOR3_ARRAY: {
+
+			PoolVector<Vector3> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			PoolVector<Vector3>::Read r = data.read();
+			uint8_t *w = _reserve(len * 4 * 3);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < len; i++) {
+				encode_float(r[i].x, &w[0]);
+				encode_float(r[i].y, &w[4]);
+				encode_float(r[i].z, &w[8]);
+				w += 4 * 3;
+			}
+			size += len * 4 * 3;
+		} break;
+		case Variant::POOL_COLOR_ARRAY: {
+
+			PoolVector<Color> data = p_variant;
+			int len = data.size();
+			_put_u32(len);
+			PoolVector<Color>::Read r = data.read();
+			uint8_t *w = _reserve(len * 4 * 4);
+			if (!w)
+				return ERR_OUT_OF_MEMORY;
+			for (int i = 0; i < len; i++) {
+				encode_float(r[i].r, &w[0]);
+				encode_float(r[i].g, &w[4]);
+				encode_float(r[i].b, &w[8]);
+				encode_float(r[i].a, &w[12]);
+				w += 4 * 4;
+			}
+			size += len * 4 * 4;
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+
+	return OK;
+}
+
+Error VariantEncoder::write(const Variant &p_variant) {
+
+	int start = size;
+	overflow = false;
+	Error err = _write(p_variant);
+	if (err == OK && overflow) {
+		err = ERR_OUT_OF_MEMORY;
+	}
+	if (err != OK) {
+		size = start; // Drop the partially written value.
+	}
+	return err;
+}
+
+VariantEncoder::VariantEncoder(bool p_full_objects) :
+		size(0),
+		max_size(INT_MAX),
+		full_objects(p_full_objects),
+		overflow(false) {
+}
+
+Error VariantDecoder::read(Variant &r_variant) {
+
+	ERR_FAIL_COND_V(position >= size, ERR_FILE_EOF);
+
+	int len = 0;
+	Error err = decode_variant(r_variant, data + position, size - position, &len, allow_objects);
+	if (err != OK)
+		return err;
+
+	position += len;
+	return OK;
+}
+
+VariantDecoder::VariantDecoder(const uint8_t *p_data, int p_size, bool p_allow_objects) :
+		data(p_data),
+		size(p_size),
+		position(0),
+		allow_objects(p_allow_objects) {
+}
+
+VariantDecoder::VariantDecoder(const PoolVector<uint8_t> &p_data, int p_from, int p_size, bool p_allow_objects) :
+		data(NULL),
+		size(0),
+		position(0),
+		allow_objects(p_allow_objects) {
+
+	if (p_size < 0) {
+		p_size = p_data.size() - p_from;
+	}
+	ERR_FAIL_COND(p_from < 0 || p_size < 0 || p_from + p_size > p_data.size());
+
+	if (p_size > 0) {
+		lock = p_data.read();
+		data = lock.ptr() + p_from;
+		size = p_size;
+	}
+}
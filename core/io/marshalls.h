@@ -202,4 +202,65 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = NULL, bool p_allow_objects = false);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
 
+/**
+  * Single pass encoder producing the same format as encode_variant().
+  * Values are appended to an internal buffer that is kept between
+  * uses, so once it has grown to fit the largest message no more
+  * allocations happen. Strings are written as UTF-8 straight into it.
+  * write() fails with ERR_OUT_OF_MEMORY instead of growing the buffer
+  * past max_size.
+  */
+class VariantEncoder {
+
+	Vector<uint8_t> buffer;
+	int size;
+	int max_size;
+	bool full_objects;
+	bool overflow;
+
+	uint8_t *_reserve(int p_bytes);
+	void _put_u32(uint32_t p_value);
+	void _put_string(const String &p_string, bool p_terminate);
+	void _pad();
+	Error _write(const Variant &p_variant);
+
+public:
+	Error write(const Variant &p_variant);
+	void clear() { size = 0; }
+
+	const uint8_t *get_data() const { return buffer.ptr(); }
+	int get_size() const { return size; }
+
+	void set_full_objects(bool p_enable) { full_objects = p_enable; }
+	bool is_full_objects() const { return full_objects; }
+
+	void set_max_size(int p_max_size) { max_size = p_max_size; }
+	int get_max_size() const { return max_size; }
+
+	VariantEncoder(bool p_full_objects = false);
+};
+
+/**
+  * Decodes consecutive values from a view over encoded data, such as
+  * a slice of a PoolByteArray, without copying it first.
+  */
+class VariantDecoder {
+
+	PoolVector<uint8_t>::Read lock;
+	const uint8_t *data;
+	int size;
+	int position;
+	bool allow_objects;
+
+public:
+	Error read(Variant &r_variant);
+
+	int get_position() const { return position; }
+	int get_remaining() const { return size - position; }
+	bool is_at_end() const { return position >= size; }
+
+	VariantDecoder(const uint8_t *p_data, int p_size, bool p_allow_objects = false);
+	VariantDecoder(const PoolVector<uint8_t> &p_data, int p_from = 0, int p_size = -1, bool p_allow_objects = false);
+};
+
 #endif
@@ -31,11 +31,10 @@
 #include "multiplayer_api.h"
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "core/sort_array.h"
 #include "scene/main/node.h"
 
-#ifdef DEBUG_ENABLED
-#include "core/os/os.h"
-#endif
 
 _FORCE_INLINE_ bool _should_call_local(MultiplayerAPI::RPCMode mode, bool is_master, bool &r_skip_rpc) {
 
@@ -92,11 +91,410 @@ _FORCE_INLINE_ bool _can_call_mode(Node *p_node, MultiplayerAPI::RPCMode mode, i
 	return false;
 }
 
+// RPC payloads use a compact encoding: a one byte tag, then varints and
+// unpadded floats for the common types. Everything else falls back to
+// encode_variant().
+enum CompactVariantTag {
+	COMPACT_VARIANT_NIL,
+	COMPACT_VARIANT_FALSE,
+	COMPACT_VARIANT_TRUE,
+	COMPACT_VARIANT_INT,
+	COMPACT_VARIANT_FLOAT,
+	COMPACT_VARIANT_DOUBLE,
+	COMPACT_VARIANT_STRING,
+	COMPACT_VARIANT_VECTOR2,
+	COMPACT_VARIANT_VECTOR3,
+	COMPACT_VARIANT_QUAT,
+	COMPACT_VARIANT_COLOR,
+	COMPACT_VARIANT_GENERIC,
+	// Replication only, components are varints scaled by the property quantization.
+	COMPACT_VARIANT_QUANTIZED_REAL,
+	COMPACT_VARIANT_QUANTIZED_VECTOR2,
+	COMPACT_VARIANT_QUANTIZED_VECTOR3,
+};
+
+static _FORCE_INLINE_ void _make_room(Vector<uint8_t> &r_buffer, int p_size) {
+	if (r_buffer.size() < p_size)
+		r_buffer.resize(p_size);
+}
+
+static int _encode_varint(uint64_t p_value, uint8_t *p_buffer) {
+
+	int len = 0;
+	do {
+		uint8_t b = p_value & 0x7F;
+		p_value >>= 7;
+		if (p_value)
+			b |= 0x80;
+		if (p_buffer)
+			p_buffer[len] = b;
+		len++;
+	} while (p_value);
+	return len;
+}
+
+static int _decode_varint(const uint8_t *p_buffer, int p_len, uint64_t &r_value) {
+
+	r_value = 0;
+	for (int i = 0; i < p_len && i < 10; i++) {
+		r_value |= uint64_t(p_buffer[i] & 0x7F) << (7 * i);
+		if (!(p_buffer[i] & 0x80))
+			return i + 1;
+	}
+	return -1;
+}
+
+static _FORCE_INLINE_ void _put_varint(Vector<uint8_t> &r_buffer, int &r_ofs, uint64_t p_value) {
+	_make_room(r_buffer, r_ofs + 10);
+	r_ofs += _encode_varint(p_value, &r_buffer.write[r_ofs]);
+}
+
+// Zigzag keeps small negative values short.
+static _FORCE_INLINE_ uint64_t _zigzag_encode(int64_t p_value) {
+	return (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63);
+}
+
+static _FORCE_INLINE_ int64_t _zigzag_decode(uint64_t p_value) {
+	return int64_t(p_value >> 1) ^ -int64_t(p_value & 1);
+}
+
+// Paths and names are either a cached ID or inline UTF-8, the low bit tells them apart.
+static void _put_cached_reference(Vector<uint8_t> &r_buffer, int &r_ofs, int p_id, const String &p_inline) {
+
+	if (p_id >= 0) {
+		_put_varint(r_buffer, r_ofs, uint64_t(p_id) << 1);
+		return;
+	}
+
+	CharString utf8 = p_inline.utf8();
+	_put_varint(r_buffer, r_ofs, (uint64_t(utf8.length()) << 1) | 1);
+	_make_room(r_buffer, r_ofs + utf8.length());
+	copymem(&r_buffer.write[r_ofs], utf8.get_data(), utf8.length());
+	r_ofs += utf8.length();
+}
+
+static _FORCE_INLINE_ void _put_floats(Vector<uint8_t> &r_buffer, int &r_ofs, const real_t *p_values, int p_count) {
+	_make_room(r_buffer, r_ofs + p_count * 4);
+	for (int i = 0; i < p_count; i++) {
+		r_ofs += encode_float(p_values[i], &r_buffer.write[r_ofs]);
+	}
+}
+
+static Error _encode_compact_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_ofs, bool p_allow_objects) {
+
+	_make_room(r_buffer, r_ofs + 1);
+
+	switch (p_variant.get_type()) {
+
+		case Variant::NIL: {
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_NIL;
+		} break;
+		case Variant::BOOL: {
+			r_buffer.write[r_ofs++] = bool(p_variant) ? COMPACT_VARIANT_TRUE : COMPACT_VARIANT_FALSE;
+		} break;
+		case Variant::INT: {
+			int64_t value = p_variant;
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_INT;
+			_put_varint(r_buffer, r_ofs, _zigzag_encode(value));
+		} break;
+		case Variant::REAL: {
+			double d = p_variant;
+			float f = d;
+			if (double(f) == d) {
+				r_buffer.write[r_ofs++] = COMPACT_VARIANT_FLOAT;
+				_make_room(r_buffer, r_ofs + 4);
+				r_ofs += encode_float(f, &r_buffer.write[r_ofs]);
+			} else {
+				r_buffer.write[r_ofs++] = COMPACT_VARIANT_DOUBLE;
+				_make_room(r_buffer, r_ofs + 8);
+				r_ofs += encode_double(d, &r_buffer.write[r_ofs]);
+			}
+		} break;
+		case Variant::STRING: {
+			CharString utf8 = String(p_variant).utf8();
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_STRING;
+			_put_varint(r_buffer, r_ofs, utf8.length());
+			_make_room(r_buffer, r_ofs + utf8.length());
+			copymem(&r_buffer.write[r_ofs], utf8.get_data(), utf8.length());
+			r_ofs += utf8.length();
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_variant;
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_VECTOR2;
+			_put_floats(r_buffer, r_ofs, &v.x, 2);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_variant;
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_VECTOR3;
+			_put_floats(r_buffer, r_ofs, &v.x, 3);
+		} break;
+		case Variant::QUAT: {
+			Quat q = p_variant;
+			real_t values[4] = { q.x, q.y, q.z, q.w };
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_QUAT;
+			_put_floats(r_buffer, r_ofs, values, 4);
+		} break;
+		case Variant::COLOR: {
+			Color c = p_variant;
+			real_t values[4] = { c.r, c.g, c.b, c.a };
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_COLOR;
+			_put_floats(r_buffer, r_ofs, values, 4);
+		} break;
+		default: {
+			int len;
+			Error err = encode_variant(p_variant, NULL, len, p_allow_objects);
+			ERR_FAIL_COND_V(err != OK, err);
+			r_buffer.write[r_ofs++] = COMPACT_VARIANT_GENERIC;
+			_put_varint(r_buffer, r_ofs, len);
+			_make_room(r_buffer, r_ofs + len);
+			encode_variant(p_variant, &r_buffer.write[r_ofs], len, p_allow_objects);
+			r_ofs += len;
+		} break;
+	}
+
+	return OK;
+}
+
+static Error _decode_compact_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects) {
+
+	ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+
+	int ofs = 1;
+
+#define NEED_BYTES(m_amount) \
+	ERR_FAIL_COND_V(p_len - ofs < (m_amount), ERR_INVALID_DATA);
+
+	switch (p_buffer[0]) {
+
+		case COMPACT_VARIANT_NIL: {
+			r_variant = Variant();
+		} break;
+		case COMPACT_VARIANT_FALSE: {
+			r_variant = false;
+		} break;
+		case COMPACT_VARIANT_TRUE: {
+			r_variant = true;
+		} break;
+		case COMPACT_VARIANT_INT: {
+			uint64_t value;
+			int len = _decode_varint(&p_buffer[ofs], p_len - ofs, value);
+			ERR_FAIL_COND_V(len < 0, ERR_INVALID_DATA);
+			r_variant = _zigzag_decode(value);
+			ofs += len;
+		} break;
+		case COMPACT_VARIANT_FLOAT: {
+			NEED_BYTES(4);
+			r_variant = decode_float(&p_buffer[ofs]);
+			ofs += 4;
+		} break;
+		case COMPACT_VARIANT_DOUBLE: {
+			NEED_BYTES(8);
+			r_variant = decode_double(&p_buffer[ofs]);
+			ofs += 8;
+		} break;
+		case COMPACT_VARIANT_STRING: {
+			uint64_t size;
+			int len = _decode_varint(&p_buffer[ofs], p_len - ofs, size);
+			ERR_FAIL_COND_V(len < 0, ERR_INVALID_DATA);
+			ofs += len;
+			NEED_BYTES(int64_t(size));
+			r_variant = String::utf8((const char *)&p_buffer[ofs], size);
+			ofs += size;
+		} break;
+		case COMPACT_VARIANT_VECTOR2: {
+			NEED_BYTES(8);
+			r_variant = Vector2(decode_float(&p_buffer[ofs]), decode_float(&p_buffer[ofs + 4]));
+			ofs += 8;
+		} break;
+		case COMPACT_VARIANT_VECTOR3: {
+			NEED_BYTES(12);
+			r_variant = Vector3(decode_float(&p_buffer[ofs]), decode_float(&p_buffer[ofs + 4]), decode_float(&p_buffer[ofs + 8]));
+			ofs += 12;
+		} break;
+		case COMPACT_VARIANT_QUAT: {
+			NEED_BYTES(16);
+			r_variant = Quat(decode_float(&p_buffer[ofs]), decode_float(&p_buffer[ofs + 4]), decode_float(&p_buffer[ofs + 8]), decode_float(&p_buffer[ofs + 12]));
+			ofs += 16;
+		} break;
+		case COMPACT_VARIANT_COLOR: {
+			NEED_BYTES(16);
+			r_variant = Color(decode_float(&p_buffer[ofs]), decode_float(&p_buffer[ofs + 4]), decode_float(&p_buffer[ofs + 8]), decode_float(&p_buffer[ofs + 12]));
+			ofs += 16;
+		} break;
+		case COMPACT_VARIANT_GENERIC: {
+			uint64_t size;
+			int len = _decode_varint(&p_buffer[ofs], p_len - ofs, size);
+			ERR_FAIL_COND_V(len < 0, ERR_INVALID_DATA);
+			ofs += len;
+			NEED_BYTES(int64_t(size));
+			Error err = decode_variant(r_variant, &p_buffer[ofs], size, NULL, p_allow_objects);
+			ERR_FAIL_COND_V(err != OK, err);
+			ofs += size;
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_INVALID_DATA);
+		}
+	}
+
+#undef NEED_BYTES
+
+	if (r_len)
+		*r_len = ofs;
+
+	return OK;
+}
+
+static Variant _quantize_value(const Variant &p_value, real_t p_step) {
+
+	if (p_step <= 0)
+		return p_value;
+
+	switch (p_value.get_type()) {
+		case Variant::REAL: {
+			return Math::round(real_t(p_value) / p_step) * p_step;
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			return Vector2(Math::round(v.x / p_step), Math::round(v.y / p_step)) * p_step;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			return Vector3(Math::round(v.x / p_step), Math::round(v.y / p_step), Math::round(v.z / p_step)) * p_step;
+		} break;
+		default: {
+			return p_value;
+		}
+	}
+}
+
+// Spatial and Node2D both expose a global transform property, reading it through
+// the object keeps the scene classes out of core.
+static bool _get_node_position(const Node *p_node, Vector3 &r_position) {
+
+	bool valid = false;
+	Variant transform = p_node->get(SNAME("global_transform"), &valid);
+	if (!valid)
+		return false;
+
+	switch (transform.get_type()) {
+		case Variant::TRANSFORM: {
+			Transform global_transform = transform;
+			r_position = global_transform.origin;
+			return true;
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D global_transform = transform;
+			Vector2 position = global_transform.get_origin();
+			r_position = Vector3(position.x, position.y, 0);
+			return true;
+		} break;
+		default: {
+			return false;
+		}
+	}
+}
+
+static Error _encode_replicated_value(const Variant &p_value, real_t p_step, Vector<uint8_t> &r_buffer, int &r_ofs, bool p_allow_objects) {
+
+	if (p_step > 0) {
+
+		real_t components[3];
+		int count = 0;
+		uint8_t tag = COMPACT_VARIANT_NIL;
+
+		switch (p_value.get_type()) {
+			case Variant::REAL: {
+				components[0] = p_value;
+				count = 1;
+				tag = COMPACT_VARIANT_QUANTIZED_REAL;
+			} break;
+			case Variant::VECTOR2: {
+				Vector2 v = p_value;
+				components[0] = v.x;
+				components[1] = v.y;
+				count = 2;
+				tag = COMPACT_VARIANT_QUANTIZED_VECTOR2;
+			} break;
+			case Variant::VECTOR3: {
+				Vector3 v = p_value;
+				components[0] = v.x;
+				components[1] = v.y;
+				components[2] = v.z;
+				count = 3;
+				tag = COMPACT_VARIANT_QUANTIZED_VECTOR3;
+			} break;
+			default: {
+			}
+		}
+
+		if (count) {
+			_make_room(r_buffer, r_ofs + 1);
+			r_buffer.write[r_ofs++] = tag;
+			for (int i = 0; i < count; i++) {
+				_put_varint(r_buffer, r_ofs, _zigzag_encode(int64_t(Math::round(components[i] / p_step))));
+			}
+			return OK;
+		}
+	}
+
+	return _encode_compact_variant(p_value, r_buffer, r_ofs, p_allow_objects);
+}
+
+static Error _decode_replicated_value(Variant &r_value, const uint8_t *p_buffer, int p_len, int *r_len, real_t p_step, bool p_allow_objects) {
+
+	ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+
+	int count;
+	switch (p_buffer[0]) {
+		case COMPACT_VARIANT_QUANTIZED_REAL: {
+			count = 1;
+		} break;
+		case COMPACT_VARIANT_QUANTIZED_VECTOR2: {
+			count = 2;
+		} break;
+		case COMPACT_VARIANT_QUANTIZED_VECTOR3: {
+			count = 3;
+		} break;
+		default: {
+			return _decode_compact_variant(r_value, p_buffer, p_len, r_len, p_allow_objects);
+		}
+	}
+
+	real_t components[3];
+	int ofs = 1;
+	for (int i = 0; i < count; i++) {
+		uint64_t value;
+		int len = _decode_varint(&p_buffer[ofs], p_len - ofs, value);
+		ERR_FAIL_COND_V(len < 0, ERR_INVALID_DATA);
+		components[i] = _zigzag_decode(value) * p_step;
+		ofs += len;
+	}
+
+	if (count == 1) {
+		r_value = components[0];
+	} else if (count == 2) {
+		r_value = Vector2(components[0], components[1]);
+	} else {
+		r_value = Vector3(components[0], components[1], components[2]);
+	}
+
+	if (r_len)
+		*r_len = ofs;
+
+	return OK;
+}
+
 void MultiplayerAPI::poll() {
 
 	if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED)
 		return;
 
+	// SceneTree flushes at the end of every frame, this catches rpcs queued since then
+	// (or all of them when polling manually) before the peer is serviced.
+	flush_rpc_batches();
+
+	_replication_poll();
+
 	network_peer->poll();
 
 	if (!network_peer.is_valid()) // It's possible that polling might have resulted in a disconnection, so check here.
@@ -128,8 +526,20 @@ void MultiplayerAPI::clear() {
 	connected_peers.clear();
 	path_get_cache.clear();
 	path_send_cache.clear();
+	name_send_cache.clear();
 	packet_cache.clear();
+	rpc_args_cache.clear();
+	rpc_batches[0].clear();
+	rpc_batches[1].clear();
 	last_send_cache_id = 1;
+	last_send_name_id = 1;
+	replication_peers.clear();
+	for (int i = 0; i < REPLICATION_HISTORY; i++) {
+		replication_received[i] = ReplicationReceived();
+	}
+	replication_tick = 0;
+	replication_last_received = 0;
+	replication_last_usec = 0;
 }
 
 void MultiplayerAPI::set_root_node(Node *p_node) {
@@ -180,16 +590,27 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	}
 #endif
 
+	if (p_packet[0] == NETWORK_COMMAND_BATCH) {
+		_process_batch(p_from, p_packet, p_packet_len);
+	} else {
+		_process_message(p_from, p_packet, p_packet_len);
+	}
+}
+
+void MultiplayerAPI::_process_message(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
 	uint8_t packet_type = p_packet[0];
 
 	switch (packet_type) {
 
-		case NETWORK_COMMAND_SIMPLIFY_PATH: {
+		case NETWORK_COMMAND_SIMPLIFY_PATH:
+		case NETWORK_COMMAND_SIMPLIFY_NAME: {
 
 			_process_simplify_path(p_from, p_packet, p_packet_len);
 		} break;
 
-		case NETWORK_COMMAND_CONFIRM_PATH: {
+		case NETWORK_COMMAND_CONFIRM_PATH:
+		case NETWORK_COMMAND_CONFIRM_NAME: {
 
 			_process_confirm_path(p_from, p_packet, p_packet_len);
 		} break;
@@ -197,31 +618,25 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 		case NETWORK_COMMAND_REMOTE_CALL:
 		case NETWORK_COMMAND_REMOTE_SET: {
 
-			ERR_FAIL_COND_MSG(p_packet_len < 6, "Invalid packet received. Size too small.");
+			ERR_FAIL_COND_MSG(p_packet_len < 3, "Invalid packet received. Size too small.");
 
-			Node *node = _process_get_node(p_from, p_packet, p_packet_len);
+			int ofs = 1;
+			Node *node = _process_get_node(p_from, p_packet, p_packet_len, ofs);
 
 			ERR_FAIL_COND_MSG(node == NULL, "Invalid packet received. Requested node was not found.");
 
-			// Detect cstring end.
-			int len_end = 5;
-			for (; len_end < p_packet_len; len_end++) {
-				if (p_packet[len_end] == 0) {
-					break;
-				}
-			}
-
-			ERR_FAIL_COND_MSG(len_end >= p_packet_len, "Invalid packet received. Size too small.");
+			StringName name;
+			bool valid = _process_get_name(p_from, p_packet, p_packet_len, ofs, name);
 
-			StringName name = String::utf8((const char *)&p_packet[5]);
+			ERR_FAIL_COND_MSG(!valid, "Invalid packet received. Unable to get the remote call/set name.");
 
 			if (packet_type == NETWORK_COMMAND_REMOTE_CALL) {
 
-				_process_rpc(node, name, p_from, p_packet, p_packet_len, len_end + 1);
+				_process_rpc(node, name, p_from, p_packet, p_packet_len, ofs);
 
 			} else {
 
-				_process_rset(node, name, p_from, p_packet, p_packet_len, len_end + 1);
+				_process_rset(node, name, p_from, p_packet, p_packet_len, ofs);
 			}
 
 		} break;
@@ -230,50 +645,113 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+
+		case NETWORK_COMMAND_REPLICATE: {
+
+			_process_replicate(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_REPLICATE_ACK: {
+
+			_process_replicate_ack(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
-Node *MultiplayerAPI::_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len) {
+void MultiplayerAPI::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
 
-	uint32_t target = decode_uint32(&p_packet[1]);
-	Node *node = NULL;
+	int ofs = 1;
+	while (ofs < p_packet_len) {
 
-	if (target & 0x80000000) {
-		// Use full path (not cached yet).
+		uint64_t len;
+		int header = _decode_varint(&p_packet[ofs], p_packet_len - ofs, len);
+		ERR_FAIL_COND_MSG(header < 0 || len == 0 || len > uint64_t(p_packet_len - ofs - header), "Invalid packet received. Batched message size is invalid.");
+		ofs += header;
+
+		ERR_FAIL_COND_MSG(p_packet[ofs] == NETWORK_COMMAND_BATCH, "Invalid packet received. Batches can't be nested.");
+		_process_message(p_from, &p_packet[ofs], len);
+		ofs += len;
+
+		if (!network_peer.is_valid()) {
+			break; // A batched message caused a disconnection.
+		}
+	}
+}
 
-		int ofs = target & 0x7FFFFFFF;
+bool MultiplayerAPI::_process_get_path(int p_from, const uint8_t *p_packet, int p_packet_len, int &r_ofs, NodePath &r_path) {
 
-		ERR_FAIL_COND_V_MSG(ofs >= p_packet_len, NULL, "Invalid packet received. Size smaller than declared.");
+	uint64_t target;
+	int len = _decode_varint(&p_packet[r_ofs], p_packet_len - r_ofs, target);
+	ERR_FAIL_COND_V_MSG(len < 0, false, "Invalid packet received. Size too small.");
+	r_ofs += len;
 
-		String paths;
-		paths.parse_utf8((const char *)&p_packet[ofs], p_packet_len - ofs);
+	if (target & 1) {
+		// Use full path (not cached yet).
 
-		NodePath np = paths;
+		uint64_t path_len = target >> 1;
+		ERR_FAIL_COND_V_MSG(path_len > uint64_t(p_packet_len - r_ofs), false, "Invalid packet received. Size smaller than declared.");
 
-		node = root_node->get_node(np);
+		String paths;
+		paths.parse_utf8((const char *)&p_packet[r_ofs], path_len);
+		r_ofs += path_len;
 
-		if (!node)
-			ERR_PRINTS("Failed to get path from RPC: " + String(np) + ".");
+		r_path = paths;
 	} else {
 		// Use cached path.
-		int id = target;
+		int id = target >> 1;
 
 		Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
-		ERR_FAIL_COND_V_MSG(!E, NULL, "Invalid packet received. Requests invalid peer cache.");
+		ERR_FAIL_COND_V_MSG(!E, false, "Invalid packet received. Requests invalid peer cache.");
 
 		Map<int, PathGetCache::NodeInfo>::Element *F = E->get().nodes.find(id);
-		ERR_FAIL_COND_V_MSG(!F, NULL, "Invalid packet received. Unabled to find requested cached node.");
-
-		PathGetCache::NodeInfo *ni = &F->get();
-		// Do proper caching later.
+		ERR_FAIL_COND_V_MSG(!F, false, "Invalid packet received. Unabled to find requested cached node.");
 
-		node = root_node->get_node(ni->path);
-		if (!node)
-			ERR_PRINTS("Failed to get cached path from RPC: " + String(ni->path) + ".");
+		r_path = F->get().path;
 	}
+	return true;
+}
+
+Node *MultiplayerAPI::_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len, int &r_ofs) {
+
+	NodePath path;
+	if (!_process_get_path(p_from, p_packet, p_packet_len, r_ofs, path))
+		return NULL;
+
+	// Do proper caching later.
+	Node *node = root_node->get_node(path);
+	if (!node)
+		ERR_PRINTS("Failed to get path from RPC: " + String(path) + ".");
+
 	return node;
 }
 
+bool MultiplayerAPI::_process_get_name(int p_from, const uint8_t *p_packet, int p_packet_len, int &r_ofs, StringName &r_name) {
+
+	uint64_t target;
+	int len = _decode_varint(&p_packet[r_ofs], p_packet_len - r_ofs, target);
+	ERR_FAIL_COND_V(len < 0, false);
+	r_ofs += len;
+
+	if (target & 1) {
+		// Full name (not cached yet).
+		uint64_t name_len = target >> 1;
+		ERR_FAIL_COND_V(name_len > uint64_t(p_packet_len - r_ofs), false);
+
+		r_name = String::utf8((const char *)&p_packet[r_ofs], name_len);
+		r_ofs += name_len;
+		return true;
+	}
+
+	Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
+	ERR_FAIL_COND_V(!E, false);
+
+	Map<int, StringName>::Element *F = E->get().names.find(target >> 1);
+	ERR_FAIL_COND_V(!F, false);
+
+	r_name = F->get();
+	return true;
+}
+
 void MultiplayerAPI::_process_rpc(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset) {
 
 	ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
@@ -311,7 +789,7 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const StringName &p_name, int p_
 		ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
 
 		int vlen;
-		Error err = decode_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
+		Error err = _decode_compact_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
 		ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RPC argument.");
 
 		argp.write[i] = &args[i];
@@ -353,7 +831,7 @@ void MultiplayerAPI::_process_rset(Node *p_node, const StringName &p_name, int p
 #endif
 
 	Variant value;
-	Error err = decode_variant(value, &p_packet[p_offset], p_packet_len - p_offset, NULL, allow_object_decoding || network_peer->is_object_decoding_allowed());
+	Error err = _decode_compact_variant(value, &p_packet[p_offset], p_packet_len - p_offset, NULL, allow_object_decoding || network_peer->is_object_decoding_allowed());
 
 	ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RSET value.");
 
@@ -374,31 +852,37 @@ void MultiplayerAPI::_process_simplify_path(int p_from, const uint8_t *p_packet,
 	String paths;
 	paths.parse_utf8((const char *)&p_packet[5], p_packet_len - 5);
 
-	NodePath path = paths;
-
 	if (!path_get_cache.has(p_from)) {
 		path_get_cache[p_from] = PathGetCache();
 	}
 
-	PathGetCache::NodeInfo ni;
-	ni.path = path;
-	ni.instance = 0;
+	NetworkCommands confirm_command;
 
-	path_get_cache[p_from].nodes[id] = ni;
+	if (p_packet[0] == NETWORK_COMMAND_SIMPLIFY_NAME) {
+
+		path_get_cache[p_from].names[id] = paths;
+		confirm_command = NETWORK_COMMAND_CONFIRM_NAME;
+	} else {
+
+		PathGetCache::NodeInfo ni;
+		ni.path = paths;
+		ni.instance = 0;
+
+		path_get_cache[p_from].nodes[id] = ni;
+		confirm_command = NETWORK_COMMAND_CONFIRM_PATH;
+	}
 
 	// Encode path to send ack.
-	CharString pname = String(path).utf8();
+	CharString pname = paths.utf8();
 	int len = encode_cstring(pname.get_data(), NULL);
 
 	Vector<uint8_t> packet;
 
 	packet.resize(1 + len);
-	packet.write[0] = NETWORK_COMMAND_CONFIRM_PATH;
+	packet.write[0] = confirm_command;
 	encode_cstring(pname.get_data(), &packet.write[1]);
 
-	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-	network_peer->set_target_peer(p_from);
-	network_peer->put_packet(packet.ptr(), packet.size());
+	_put_packet(p_from, false, packet.ptr(), packet.size());
 }
 
 void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -408,9 +892,12 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
 	String paths;
 	paths.parse_utf8((const char *)&p_packet[1], p_packet_len - 1);
 
-	NodePath path = paths;
-
-	PathSentCache *psc = path_send_cache.getptr(path);
+	PathSentCache *psc;
+	if (p_packet[0] == NETWORK_COMMAND_CONFIRM_NAME) {
+		psc = name_send_cache.getptr(paths);
+	} else {
+		psc = path_send_cache.getptr(NodePath(paths));
+	}
 	ERR_FAIL_COND_MSG(!psc, "Invalid packet received. Tries to confirm a path which was not found in cache.");
 
 	Map<int, bool>::Element *E = psc->confirmed_peers.find(p_from);
@@ -418,7 +905,7 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
 	E->get() = true;
 }
 
-bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int p_target) {
+bool MultiplayerAPI::_send_confirm_path(const String &p_path, PathSentCache *psc, int p_target, NetworkCommands p_command) {
 	bool has_all_peers = true;
 	List<int> peers_to_add; // If one is missing, take note to add it.
 
@@ -447,20 +934,18 @@ bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int
 
 	for (List<int>::Element *E = peers_to_add.front(); E; E = E->next()) {
 
-		// Encode function name.
-		CharString pname = String(p_path).utf8();
+		// Encode path or function name.
+		CharString pname = p_path.utf8();
 		int len = encode_cstring(pname.get_data(), NULL);
 
 		Vector<uint8_t> packet;
 
 		packet.resize(1 + 4 + len);
-		packet.write[0] = NETWORK_COMMAND_SIMPLIFY_PATH;
+		packet.write[0] = p_command;
 		encode_uint32(psc->id, &packet.write[1]);
 		encode_cstring(pname.get_data(), &packet.write[5]);
 
-		network_peer->set_target_peer(E->get()); // To all of you.
-		network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-		network_peer->put_packet(packet.ptr(), packet.size());
+		_put_packet(E->get(), false, packet.ptr(), packet.size());
 
 		psc->confirmed_peers.insert(E->get(), false); // Insert into confirmed, but as false since it was not confirmed.
 	}
@@ -496,103 +981,420 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		psc->id = last_send_cache_id++;
 	}
 
-	// Create base packet, lots of hardcode because it must be tight.
-
-	int ofs = 0;
-
-#define MAKE_ROOM(m_amount) \
-	if (packet_cache.size() < m_amount) packet_cache.resize(m_amount);
-
-	// Encode type.
-	MAKE_ROOM(1);
-	packet_cache.write[0] = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
-	ofs += 1;
+	// See if the name is cached.
+	PathSentCache *nsc = name_send_cache.getptr(p_name);
+	if (!nsc) {
+		// Name is not cached, create.
+		name_send_cache[p_name] = PathSentCache();
+		nsc = name_send_cache.getptr(p_name);
+		nsc->id = last_send_name_id++;
+	}
 
-	// Encode ID.
-	MAKE_ROOM(ofs + 4);
-	encode_uint32(psc->id, &(packet_cache.write[ofs]));
-	ofs += 4;
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
 
-	// Encode function name.
-	CharString name = String(p_name).utf8();
-	int len = encode_cstring(name.get_data(), NULL);
-	MAKE_ROOM(ofs + len);
-	encode_cstring(name.get_data(), &(packet_cache.write[ofs]));
-	ofs += len;
+	// Encode arguments once, every peer gets the same payload.
+	int args_len = 0;
 
 	if (p_set) {
 		// Set argument.
-		Error err = encode_variant(*p_arg[0], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
+		Error err = _encode_compact_variant(*p_arg[0], rpc_args_cache, args_len, allow_objects);
 		ERR_FAIL_COND_MSG(err != OK, "Unable to encode RSET value. THIS IS LIKELY A BUG IN THE ENGINE!");
-		MAKE_ROOM(ofs + len);
-		encode_variant(*p_arg[0], &(packet_cache.write[ofs]), len, allow_object_decoding || network_peer->is_object_decoding_allowed());
-		ofs += len;
 
 	} else {
 		// Call arguments.
-		MAKE_ROOM(ofs + 1);
-		packet_cache.write[ofs] = p_argcount;
-		ofs += 1;
+		_make_room(rpc_args_cache, 1);
+		rpc_args_cache.write[0] = p_argcount;
+		args_len = 1;
 		for (int i = 0; i < p_argcount; i++) {
-			Error err = encode_variant(*p_arg[i], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
+			Error err = _encode_compact_variant(*p_arg[i], rpc_args_cache, args_len, allow_objects);
 			ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
-			MAKE_ROOM(ofs + len);
-			encode_variant(*p_arg[i], &(packet_cache.write[ofs]), len, allow_object_decoding || network_peer->is_object_decoding_allowed());
-			ofs += len;
 		}
 	}
 
+	// See if all peers have cached path and name (is so, call can be fast).
+	bool has_all_peers = _send_confirm_path(from_path, psc, p_to, NETWORK_COMMAND_SIMPLIFY_PATH);
+	has_all_peers = _send_confirm_path(p_name, nsc, p_to, NETWORK_COMMAND_SIMPLIFY_NAME) && has_all_peers;
+
+	if (has_all_peers) {
+
+		// They all have verified paths, so send fast. Batched under the original
+		// target too, so a broadcast still goes out as a single packet.
+		int ofs = _make_remote_packet(p_set, from_path, psc->id, p_name, nsc->id, args_len);
+		_send_packet(p_to, p_unreliable, packet_cache.ptr(), ofs); // A message with love.
+		return;
+	}
+
+	// Not all verified path, so send one by one.
+	for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+
+		if (p_to < 0 && E->get() == -p_to)
+			continue; // Continue, excluded.
+
+		if (p_to > 0 && E->get() != p_to)
+			continue; // Continue, not for this peer.
+
+		Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
+		ERR_CONTINUE(!F); // Should never happen.
+		Map<int, bool>::Element *G = nsc->confirmed_peers.find(E->get());
+		ERR_CONTINUE(!G); // Should never happen.
+
+		// Peers that did not confirm yet get the entire path or name (sorry!).
+		int ofs = _make_remote_packet(p_set, from_path, F->get() ? psc->id : -1, p_name, G->get() ? nsc->id : -1, args_len);
+		_send_packet(E->get(), p_unreliable, packet_cache.ptr(), ofs);
+	}
+}
+
+int MultiplayerAPI::_make_remote_packet(bool p_set, const NodePath &p_path, int p_path_id, const StringName &p_name, int p_name_id, int p_args_len) {
+
+	// Create base packet, lots of hardcode because it must be tight.
+
+	int ofs = 0;
+
+	// Encode type.
+	_make_room(packet_cache, 1);
+	packet_cache.write[0] = p_set ? NETWORK_COMMAND_REMOTE_SET : NETWORK_COMMAND_REMOTE_CALL;
+	ofs += 1;
+
+	// Encode path and function name.
+	_put_cached_reference(packet_cache, ofs, p_path_id, p_path);
+	_put_cached_reference(packet_cache, ofs, p_name_id, p_name);
+
+	_make_room(packet_cache, ofs + p_args_len);
+	copymem(&packet_cache.write[ofs], rpc_args_cache.ptr(), p_args_len);
+	ofs += p_args_len;
+
+	return ofs;
+}
+
+// Whether a peer can be in both targets, 0 being everyone and -id everyone but id.
+static _FORCE_INLINE_ bool _targets_overlap(int p_a, int p_b) {
+
+	if (p_a > 0 && p_b > 0)
+		return p_a == p_b;
+	if (p_a > 0 && p_b < 0)
+		return p_a != -p_b;
+	if (p_a < 0 && p_b > 0)
+		return p_b != -p_a;
+	return true;
+}
+
+void MultiplayerAPI::_send_packet(int p_to, bool p_unreliable, const uint8_t *p_packet, int p_packet_len) {
+
+	if (rpc_batching) {
+
+		// Each peer must get messages in the order they were sent, so batches for
+		// other targets sharing some of its peers go out first.
+		Map<int, RPCBatch> &batches = rpc_batches[p_unreliable ? 1 : 0];
+		for (Map<int, RPCBatch>::Element *E = batches.front(); E; E = E->next()) {
+			if (E->key() != p_to && E->get().size > 0 && _targets_overlap(E->key(), p_to)) {
+				_flush_rpc_batch(E->key(), p_unreliable);
+			}
+		}
+
+		RPCBatch &batch = batches[p_to];
+		int header = _encode_varint(p_packet_len, NULL);
+
+		if (batch.size > 0 && batch.size + header + p_packet_len > RPC_BATCH_MAX_SIZE) {
+			_put_packet(p_to, p_unreliable, batch.data.ptr(), batch.size);
+			batch.size = 0;
+		}
+
+		if (1 + header + p_packet_len <= RPC_BATCH_MAX_SIZE) {
+			if (batch.size == 0) {
+				_make_room(batch.data, 1);
+				batch.data.write[0] = NETWORK_COMMAND_BATCH;
+				batch.size = 1;
+			}
+			_make_room(batch.data, batch.size + header + p_packet_len);
+			batch.size += _encode_varint(p_packet_len, &batch.data.write[batch.size]);
+			copymem(&batch.data.write[batch.size], p_packet, p_packet_len);
+			batch.size += p_packet_len;
+			return;
+		}
+
+		// Too big to share a packet, send it on its own.
+	}
+
+	_put_packet(p_to, p_unreliable, p_packet, p_packet_len);
+}
+
+void MultiplayerAPI::_put_packet(int p_to, bool p_unreliable, const uint8_t *p_packet, int p_packet_len) {
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].timestamp = OS::get_singleton()->get_ticks_msec();
-		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].packet_size = ofs;
+		bandwidth_outgoing_data.write[bandwidth_outgoing_pointer].packet_size = p_packet_len;
 		bandwidth_outgoing_pointer = (bandwidth_outgoing_pointer + 1) % bandwidth_outgoing_data.size();
 	}
 #endif
 
-	// See if all peers have cached path (is so, call can be fast).
-	bool has_all_peers = _send_confirm_path(from_path, psc, p_to);
-
-	// Take chance and set transfer mode, since all send methods will use it.
 	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	network_peer->set_target_peer(p_to);
+	network_peer->put_packet(p_packet, p_packet_len);
+}
 
-	if (has_all_peers) {
+void MultiplayerAPI::_flush_rpc_batch(int p_to, bool p_unreliable) {
+
+	Map<int, RPCBatch>::Element *E = rpc_batches[p_unreliable ? 1 : 0].find(p_to);
+	if (!E || E->get().size == 0)
+		return;
+
+	RPCBatch &batch = E->get();
+	uint64_t len;
+	int header = _decode_varint(&batch.data[1], batch.size - 1, len);
+	if (1 + header + int(len) == batch.size) {
+		// A single message doesn't need the batch header.
+		_put_packet(p_to, p_unreliable, &batch.data[1 + header], len);
+	} else {
+		_put_packet(p_to, p_unreliable, batch.data.ptr(), batch.size);
+	}
+	batch.size = 0;
+}
+
+void MultiplayerAPI::flush_rpc_batches() {
+
+	if (!network_peer.is_valid() || network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED)
+		return;
+
+	for (int i = 0; i < 2; i++) {
+		for (Map<int, RPCBatch>::Element *E = rpc_batches[i].front(); E; E = E->next()) {
+			_flush_rpc_batch(E->key(), i == 1);
+		}
+	}
+}
 
-		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+void MultiplayerAPI::_replication_poll() {
+
+	if (replication_tick_rate <= 0 || replicated_nodes.empty() || !network_peer->is_server())
+		return;
+
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	uint64_t interval = 1000000 / replication_tick_rate;
+
+	if (replication_last_usec != 0 && now - replication_last_usec < interval)
+		return;
+
+	// Keep a steady rate, but don't try to catch up after a long stall.
+	if (replication_last_usec == 0 || now - replication_last_usec >= interval * 2) {
+		replication_last_usec = now;
 	} else {
-		// Not all verified path, so send one by one.
+		replication_last_usec += interval;
+	}
+
+	send_replication_snapshot();
+}
+
+struct _ReplicationCandidate {
+	int index;
+	uint32_t priority;
+	uint64_t mask;
+
+	bool operator<(const _ReplicationCandidate &p_other) const { return priority > p_other.priority; }
+};
+
+void MultiplayerAPI::send_replication_snapshot() {
 
-		// Append path at the end, since we will need it for some packets.
-		CharString pname = String(from_path).utf8();
-		int path_len = encode_cstring(pname.get_data(), NULL);
-		MAKE_ROOM(ofs + path_len);
-		encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
+	ERR_FAIL_COND_MSG(!network_peer.is_valid(), "Trying to send a replication snapshot while no network peer is active.");
+	ERR_FAIL_COND_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, "Trying to send a replication snapshot via a network peer which is not connected.");
+	ERR_FAIL_COND_MSG(!network_peer->is_server(), "Only the server sends replication snapshots.");
+	ERR_FAIL_COND_MSG(root_node == NULL, "Multiplayer root node was not initialized.");
 
-		for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+	replication_tick++;
 
-			if (p_to < 0 && E->get() == -p_to)
-				continue; // Continue, excluded.
+	// Gather the current (quantized) state once, every peer is compared against it.
+	struct Entity {
+		ObjectID id;
+		NodePath path;
+		Vector<Variant> values;
+		Vector3 position;
+		bool positional;
+		const ReplicatedNode *replicated;
+	};
 
-			if (p_to > 0 && E->get() != p_to)
-				continue; // Continue, not for this peer.
+	Vector<Entity> entities;
+	entities.resize(replicated_nodes.size());
+	int entity_count = 0;
 
-			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
-			ERR_CONTINUE(!F); // Should never happen.
+	NodePath root_path = root_node->get_path();
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
+	for (Map<ObjectID, ReplicatedNode>::Element *E = replicated_nodes.front(); E;) {
 
-			if (F->get()) {
-				// This one confirmed path, so use id.
-				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
+		Map<ObjectID, ReplicatedNode>::Element *N = E->next();
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(E->key()));
+
+		if (!node) {
+			// Freed, forget it so baselines don't carry it forever.
+			for (Map<int, ReplicationPeer>::Element *P = replication_peers.front(); P; P = P->next()) {
+				P->get().priorities.erase(E->key());
+				for (int i = 0; i < REPLICATION_HISTORY; i++) {
+					P->get().history[i].states.erase(E->key());
+				}
+			}
+			replicated_nodes.erase(E);
+			E = N;
+			continue;
+		}
+
+		if (!node->is_inside_tree()) {
+			E = N;
+			continue;
+		}
+
+		Entity &entity = entities.write[entity_count++];
+		entity.id = E->key();
+		entity.path = root_path.rel_path_to(node->get_path());
+		entity.replicated = &E->get();
+
+		const Vector<ReplicatedProperty> &properties = E->get().properties;
+		entity.values.resize(properties.size());
+		for (int i = 0; i < properties.size(); i++) {
+			entity.values.write[i] = _quantize_value(node->get(properties[i].name), properties[i].quantization);
+		}
+
+		entity.positional = _get_node_position(node, entity.position);
+
+		E = N;
+	}
+
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+	real_t radius_squared = replication_relevancy_radius * replication_relevancy_radius;
+
+	Vector<_ReplicationCandidate> candidates;
+
+	for (Set<int>::Element *P = connected_peers.front(); P; P = P->next()) {
+
+		int peer_id = P->get();
+		ReplicationPeer &peer = replication_peers[peer_id];
+
+		const ReplicationSnapshot *baseline = NULL;
+		if (peer.acked_tick != 0) {
+			const ReplicationSnapshot &snapshot = peer.history[peer.acked_tick % REPLICATION_HISTORY];
+			if (snapshot.tick == peer.acked_tick) {
+				baseline = &snapshot;
+			}
+		}
+
+		bool has_viewer = false;
+		Vector3 viewer_position;
+		if (radius_squared > 0 && peer.viewer != 0) {
+			Node *viewer = Object::cast_to<Node>(ObjectDB::get_instance(peer.viewer));
+			if (viewer && viewer->is_inside_tree()) {
+				has_viewer = _get_node_position(viewer, viewer_position);
+			}
+		}
+
+		// Relevant entities that changed since the baseline the peer acknowledged.
+		candidates.resize(0);
+
+		for (int i = 0; i < entity_count; i++) {
+
+			const Entity &entity = entities[i];
+
+			if (entity.replicated->hidden_peers.has(peer_id))
+				continue;
+			if (has_viewer && entity.positional && viewer_position.distance_squared_to(entity.position) > radius_squared)
+				continue;
+
+			const Vector<Variant> *base_values = baseline ? baseline->states.getptr(entity.id) : NULL;
+
+			uint64_t mask = 0;
+			for (int j = 0; j < entity.values.size(); j++) {
+				if (!base_values || j >= base_values->size() || (*base_values)[j] != entity.values[j]) {
+					mask |= uint64_t(1) << j;
+				}
+			}
+
+			if (!mask)
+				continue;
+
+			uint32_t *priority = peer.priorities.getptr(entity.id);
+			if (!priority) {
+				peer.priorities[entity.id] = 0;
+				priority = peer.priorities.getptr(entity.id);
+			}
+			(*priority)++; // Grows while the budget keeps the entity waiting.
+
+			_ReplicationCandidate candidate;
+			candidate.index = i;
+			candidate.priority = *priority;
+			candidate.mask = mask;
+			candidates.push_back(candidate);
+		}
+
+		if (replication_budget > 0) {
+			candidates.sort();
+		}
+
+		int ofs = 0;
+		_make_room(packet_cache, 1);
+		packet_cache.write[ofs++] = NETWORK_COMMAND_REPLICATE;
+		_put_varint(packet_cache, ofs, replication_tick);
+		_put_varint(packet_cache, ofs, baseline ? baseline->tick : 0);
+
+		int count = 0;
+
+		for (int i = 0; i < candidates.size(); i++) {
+
+			_ReplicationCandidate candidate = candidates[i];
+			const Entity &entity = entities[candidate.index];
+
+			PathSentCache *psc = path_send_cache.getptr(entity.path);
+			if (!psc) {
+				// Path is not cached, create.
+				path_send_cache[entity.path] = PathSentCache();
+				psc = path_send_cache.getptr(entity.path);
+				psc->id = last_send_cache_id++;
+			}
+
+			Map<int, bool>::Element *F = psc->confirmed_peers.find(peer_id);
+			if (!F) {
+				_send_confirm_path(entity.path, psc, peer_id, NETWORK_COMMAND_SIMPLIFY_PATH);
+				F = psc->confirmed_peers.find(peer_id);
+				ERR_CONTINUE(!F); // Should never happen.
+			}
+
+			int entity_ofs = ofs;
+			_put_cached_reference(packet_cache, ofs, F->get() ? psc->id : -1, entity.path);
+			_put_varint(packet_cache, ofs, candidate.mask);
+
+			for (int j = 0; j < entity.values.size(); j++) {
+				if (candidate.mask & (uint64_t(1) << j)) {
+					Error err = _encode_replicated_value(entity.values[j], entity.replicated->properties[j].quantization, packet_cache, ofs, allow_objects);
+					ERR_FAIL_COND_MSG(err != OK, "Unable to encode replicated property. THIS IS LIKELY A BUG IN THE ENGINE!");
+				}
+			}
+
+			if (replication_budget > 0 && count > 0 && ofs > replication_budget) {
+				ofs = entity_ofs; // Over budget, the rest waits with a higher priority.
+				break;
+			}
+
+			peer.priorities[entity.id] = 0;
+			candidates.write[count++] = candidate; // Sent ones are kept at the front.
+		}
+
+		if (count == 0)
+			continue; // Nothing changed, no snapshot is stored so the baseline stays in history.
+
+		// Keep what the peer will have once it gets this packet.
+		ReplicationSnapshot &snapshot = peer.history[replication_tick % REPLICATION_HISTORY];
+		if (&snapshot != baseline) {
+			if (baseline) {
+				snapshot.states = baseline->states;
 			} else {
-				// This one did not confirm path yet, so use entire path (sorry!).
-				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+				snapshot.states.clear();
 			}
 		}
+		snapshot.tick = replication_tick;
+
+		snapshot.sent.resize(count);
+		for (int i = 0; i < count; i++) {
+			const Entity &entity = entities[candidates[i].index];
+			snapshot.states[entity.id] = entity.values;
+			snapshot.sent.write[i] = entity.id;
+		}
+
+		_put_packet(peer_id, true, packet_cache.ptr(), ofs);
 	}
 }
 
@@ -614,6 +1416,16 @@ void MultiplayerAPI::_del_peer(int p_id) {
 		PathSentCache *psc = path_send_cache.getptr(E->get());
 		psc->confirmed_peers.erase(p_id);
 	}
+	List<StringName> names;
+	name_send_cache.get_key_list(&names);
+	for (List<StringName>::Element *E = names.front(); E; E = E->next()) {
+		PathSentCache *nsc = name_send_cache.getptr(E->get());
+		nsc->confirmed_peers.erase(p_id);
+	}
+	// Rpcs queued for it alone can't be delivered anymore.
+	rpc_batches[0].erase(p_id);
+	rpc_batches[1].erase(p_id);
+	replication_peers.erase(p_id);
 	emit_signal("network_peer_disconnected", p_id);
 }
 
@@ -784,7 +1596,10 @@ Error MultiplayerAPI::send_bytes(PoolVector<uint8_t> p_data, int p_to, Networked
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), ERR_UNCONFIGURED, "Trying to send a raw packet while no network peer is active.");
 	ERR_FAIL_COND_V_MSG(network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED, ERR_UNCONFIGURED, "Trying to send a raw packet via a network peer which is not connected.");
 
-	MAKE_ROOM(p_data.size() + 1);
+	// Keep raw packets ordered after the rpcs queued before them.
+	flush_rpc_batches();
+
+	_make_room(packet_cache, p_data.size() + 1);
 	PoolVector<uint8_t>::Read r = p_data.read();
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
 	memcpy(&packet_cache.write[1], &r[0], p_data.size());
@@ -809,6 +1624,147 @@ void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_pac
 	emit_signal("network_peer_packet", p_from, out);
 }
 
+void MultiplayerAPI::_process_replicate(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_FAIL_COND_MSG(network_peer->is_server() || p_from != 1, "Invalid packet received. Only the server sends replication snapshots.");
+
+	int ofs = 1;
+	uint64_t tick;
+	uint64_t baseline_tick;
+
+	int len = _decode_varint(&p_packet[ofs], p_packet_len - ofs, tick);
+	ERR_FAIL_COND_MSG(len < 0 || tick == 0, "Invalid packet received. Invalid replication tick.");
+	ofs += len;
+	len = _decode_varint(&p_packet[ofs], p_packet_len - ofs, baseline_tick);
+	ERR_FAIL_COND_MSG(len < 0 || baseline_tick >= tick, "Invalid packet received. Invalid replication baseline.");
+	ofs += len;
+
+	if (tick <= replication_last_received)
+		return; // Snapshots are unreliable, drop the ones arriving late.
+
+	const ReplicationReceived *baseline = NULL;
+	if (baseline_tick != 0) {
+		baseline = &replication_received[baseline_tick % REPLICATION_HISTORY];
+		if (baseline->tick != baseline_tick)
+			return; // Baseline is gone, wait for one built on a newer acknowledgement.
+	}
+
+	HashMap<NodePath, Vector<Variant> > states;
+	if (baseline) {
+		states = baseline->states;
+	}
+
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+
+	// Entities (by their order in the packet) that couldn't be applied.
+	Vector<uint8_t> ack;
+	int ack_len = 0;
+	_make_room(ack, 1);
+	ack.write[ack_len++] = NETWORK_COMMAND_REPLICATE_ACK;
+	_put_varint(ack, ack_len, tick);
+
+	for (int index = 0; ofs < p_packet_len; index++) {
+
+		NodePath path;
+		bool valid = _process_get_path(p_from, p_packet, p_packet_len, ofs, path);
+		ERR_FAIL_COND_MSG(!valid, "Invalid packet received. Unable to get replicated node path.");
+
+		uint64_t mask;
+		len = _decode_varint(&p_packet[ofs], p_packet_len - ofs, mask);
+		ERR_FAIL_COND_MSG(len < 0, "Invalid packet received. Size too small.");
+		ofs += len;
+
+		// Unknown or unregistered nodes are still decoded, to skip their values.
+		Node *node = root_node->get_node_or_null(path);
+		Map<ObjectID, ReplicatedNode>::Element *R = node ? replicated_nodes.find(node->get_instance_id()) : NULL;
+		const ReplicatedNode *replicated = R ? &R->get() : NULL;
+
+		Vector<Variant> *values = states.getptr(path);
+		if (!values) {
+			states[path] = Vector<Variant>();
+			values = states.getptr(path);
+		}
+
+		bool resolved = true;
+
+		for (int i = 0; i < REPLICATION_MAX_PROPERTIES && (mask >> i); i++) {
+
+			if (!(mask & (uint64_t(1) << i)))
+				continue;
+
+			bool known = replicated && i < replicated->properties.size();
+			if (!known) {
+				resolved = false;
+			}
+
+			Variant value;
+			Error err = _decode_replicated_value(value, &p_packet[ofs], p_packet_len - ofs, &len, known ? replicated->properties[i].quantization : 1.0, allow_objects);
+			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode replicated property.");
+			ofs += len;
+
+			if (values->size() <= i) {
+				values->resize(i + 1);
+			}
+			values->write[i] = value;
+
+			if (known) {
+				node->set(replicated->properties[i].name, value);
+			}
+		}
+
+		if (!resolved) {
+			// A node that isn't spawned or registered yet skipped its values. Leave it out
+			// of the baseline and tell the server, so it keeps sending it in full until the
+			// node shows up, while the rest goes on as deltas.
+			states.erase(path);
+			_put_varint(ack, ack_len, index);
+		}
+	}
+
+	replication_last_received = tick;
+
+	ReplicationReceived &received = replication_received[tick % REPLICATION_HISTORY];
+	received.tick = tick;
+	received.states = states;
+
+	// Acknowledge, so the server can use it as baseline.
+	_put_packet(p_from, true, ack.ptr(), ack_len);
+}
+
+void MultiplayerAPI::_process_replicate_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	int ofs = 1;
+	uint64_t tick;
+	int len = _decode_varint(&p_packet[ofs], p_packet_len - ofs, tick);
+	ERR_FAIL_COND_MSG(len < 0, "Invalid packet received. Size too small.");
+	ofs += len;
+
+	Map<int, ReplicationPeer>::Element *E = replication_peers.find(p_from);
+	if (!E)
+		return;
+
+	ReplicationPeer &peer = E->get();
+	if (tick <= peer.acked_tick || tick > replication_tick)
+		return;
+
+	ReplicationSnapshot &snapshot = peer.history[tick % REPLICATION_HISTORY];
+	if (snapshot.tick != tick)
+		return; // Too old to be used as baseline anyway.
+
+	// Entities the peer couldn't apply don't count as received.
+	while (ofs < p_packet_len) {
+
+		uint64_t index;
+		len = _decode_varint(&p_packet[ofs], p_packet_len - ofs, index);
+		ERR_FAIL_COND_MSG(len < 0 || index >= uint64_t(snapshot.sent.size()), "Invalid packet received. Invalid replication acknowledgement.");
+		ofs += len;
+
+		snapshot.states.erase(snapshot.sent[index]);
+	}
+
+	peer.acked_tick = tick;
+}
+
 int MultiplayerAPI::get_network_unique_id() const {
 
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), 0, "No network peer is assigned. Unable to get unique network ID.");
@@ -856,6 +1812,110 @@ bool MultiplayerAPI::is_object_decoding_allowed() const {
 	return allow_object_decoding;
 }
 
+void MultiplayerAPI::set_rpc_batching_enabled(bool p_enable) {
+
+	if (rpc_batching && !p_enable) {
+		flush_rpc_batches();
+	}
+	rpc_batching = p_enable;
+}
+
+bool MultiplayerAPI::is_rpc_batching_enabled() const {
+
+	return rpc_batching;
+}
+
+Error MultiplayerAPI::replicate_property(Node *p_node, const StringName &p_property, real_t p_quantization) {
+
+	ERR_FAIL_NULL_V(p_node, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_quantization < 0, ERR_INVALID_PARAMETER);
+
+	ReplicatedNode &replicated = replicated_nodes[p_node->get_instance_id()];
+
+	for (int i = 0; i < replicated.properties.size(); i++) {
+		if (replicated.properties[i].name == p_property) {
+			replicated.properties.write[i].quantization = p_quantization;
+			return OK;
+		}
+	}
+
+	ERR_FAIL_COND_V_MSG(replicated.properties.size() >= REPLICATION_MAX_PROPERTIES, ERR_OUT_OF_MEMORY, "Too many replicated properties on node " + String(p_node->get_name()) + ", the limit is " + itos(REPLICATION_MAX_PROPERTIES) + ".");
+
+	ReplicatedProperty property;
+	property.name = p_property;
+	property.quantization = p_quantization;
+	replicated.properties.push_back(property);
+
+	return OK;
+}
+
+void MultiplayerAPI::stop_replicating(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	replicated_nodes.erase(p_node->get_instance_id());
+}
+
+void MultiplayerAPI::set_replication_visibility(Node *p_node, int p_peer, bool p_visible) {
+
+	ERR_FAIL_NULL(p_node);
+	Map<ObjectID, ReplicatedNode>::Element *E = replicated_nodes.find(p_node->get_instance_id());
+	ERR_FAIL_COND_MSG(!E, "Node " + String(p_node->get_name()) + " has no replicated properties.");
+
+	if (p_visible) {
+		E->get().hidden_peers.erase(p_peer);
+	} else {
+		E->get().hidden_peers.insert(p_peer);
+	}
+}
+
+bool MultiplayerAPI::get_replication_visibility(Node *p_node, int p_peer) const {
+
+	ERR_FAIL_NULL_V(p_node, false);
+	const Map<ObjectID, ReplicatedNode>::Element *E = replicated_nodes.find(p_node->get_instance_id());
+	ERR_FAIL_COND_V_MSG(!E, false, "Node " + String(p_node->get_name()) + " has no replicated properties.");
+
+	return !E->get().hidden_peers.has(p_peer);
+}
+
+void MultiplayerAPI::set_replication_viewer(int p_peer, Node *p_viewer) {
+
+	ERR_FAIL_COND_MSG(!connected_peers.has(p_peer), "Attempt to set the replication viewer of unexisting ID: " + itos(p_peer) + ".");
+	replication_peers[p_peer].viewer = p_viewer ? p_viewer->get_instance_id() : 0;
+}
+
+void MultiplayerAPI::set_replication_tick_rate(int p_rate) {
+
+	ERR_FAIL_COND(p_rate < 0);
+	replication_tick_rate = p_rate;
+}
+
+int MultiplayerAPI::get_replication_tick_rate() const {
+
+	return replication_tick_rate;
+}
+
+void MultiplayerAPI::set_replication_relevancy_radius(real_t p_radius) {
+
+	ERR_FAIL_COND(p_radius < 0);
+	replication_relevancy_radius = p_radius;
+}
+
+real_t MultiplayerAPI::get_replication_relevancy_radius() const {
+
+	return replication_relevancy_radius;
+}
+
+void MultiplayerAPI::set_replication_budget(int p_bytes) {
+
+	ERR_FAIL_COND(p_bytes < 0);
+	replication_budget = p_bytes;
+}
+
+int MultiplayerAPI::get_replication_budget() const {
+
+	return replication_budget;
+}
+
 void MultiplayerAPI::profiling_start() {
 #ifdef DEBUG_ENABLED
 	profiling = true;
@@ -967,10 +2027,29 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enable"), &MultiplayerAPI::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &MultiplayerAPI::is_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("flush_rpc_batches"), &MultiplayerAPI::flush_rpc_batches);
+	ClassDB::bind_method(D_METHOD("replicate_property", "node", "property", "quantization"), &MultiplayerAPI::replicate_property, DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("stop_replicating", "node"), &MultiplayerAPI::stop_replicating);
+	ClassDB::bind_method(D_METHOD("set_replication_visibility", "node", "peer_id", "visible"), &MultiplayerAPI::set_replication_visibility);
+	ClassDB::bind_method(D_METHOD("get_replication_visibility", "node", "peer_id"), &MultiplayerAPI::get_replication_visibility);
+	ClassDB::bind_method(D_METHOD("set_replication_viewer", "peer_id", "viewer"), &MultiplayerAPI::set_replication_viewer);
+	ClassDB::bind_method(D_METHOD("send_replication_snapshot"), &MultiplayerAPI::send_replication_snapshot);
+	ClassDB::bind_method(D_METHOD("set_replication_tick_rate", "rate"), &MultiplayerAPI::set_replication_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_replication_tick_rate"), &MultiplayerAPI::get_replication_tick_rate);
+	ClassDB::bind_method(D_METHOD("set_replication_relevancy_radius", "radius"), &MultiplayerAPI::set_replication_relevancy_radius);
+	ClassDB::bind_method(D_METHOD("get_replication_relevancy_radius"), &MultiplayerAPI::get_replication_relevancy_radius);
+	ClassDB::bind_method(D_METHOD("set_replication_budget", "bytes"), &MultiplayerAPI::set_replication_budget);
+	ClassDB::bind_method(D_METHOD("get_replication_budget"), &MultiplayerAPI::get_replication_budget);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_budget", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), "set_replication_budget", "get_replication_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "replication_relevancy_radius", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater"), "set_replication_relevancy_radius", "get_replication_relevancy_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_tick_rate", PROPERTY_HINT_RANGE, "0,120,1"), "set_replication_tick_rate", "get_replication_tick_rate");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
 	ADD_PROPERTY_DEFAULT("refuse_new_network_connections", false);
 
 	ADD_SIGNAL(MethodInfo("network_peer_connected", PropertyInfo(Variant::INT, "id")));
@@ -992,7 +2071,11 @@ void MultiplayerAPI::_bind_methods() {
 }
 
 MultiplayerAPI::MultiplayerAPI() :
-		allow_object_decoding(false) {
+		allow_object_decoding(false),
+		rpc_batching(true),
+		replication_tick_rate(20),
+		replication_relevancy_radius(0),
+		replication_budget(0) {
 	rpc_sender_id = 0;
 	root_node = NULL;
 #ifdef DEBUG_ENABLED
@@ -39,6 +39,19 @@ class MultiplayerAPI : public Reference {
 	GDCLASS(MultiplayerAPI, Reference);
 
 public:
+	enum NetworkCommands {
+		NETWORK_COMMAND_REMOTE_CALL,
+		NETWORK_COMMAND_REMOTE_SET,
+		NETWORK_COMMAND_SIMPLIFY_PATH,
+		NETWORK_COMMAND_CONFIRM_PATH,
+		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_SIMPLIFY_NAME,
+		NETWORK_COMMAND_CONFIRM_NAME,
+		NETWORK_COMMAND_BATCH,
+		NETWORK_COMMAND_REPLICATE,
+		NETWORK_COMMAND_REPLICATE_ACK,
+	};
+
 	struct ProfilingInfo {
 		ObjectID node;
 		String node_path;
@@ -63,6 +76,63 @@ private:
 		};
 
 		Map<int, NodeInfo> nodes;
+		Map<int, StringName> names;
+	};
+
+	//rpcs queued for a target (a peer, 0 for all or -id for all but one) until the end of the frame or the next poll
+	struct RPCBatch {
+		Vector<uint8_t> data;
+		int size;
+
+		RPCBatch() :
+				size(0) {}
+	};
+
+	enum {
+		RPC_BATCH_MAX_SIZE = 1200, // Keep batches under a typical MTU.
+		REPLICATION_HISTORY = 32, // Snapshots kept as delta baselines.
+		REPLICATION_MAX_PROPERTIES = 64, // Changed properties are sent as a 64 bits mask.
+	};
+
+	//replicated properties of a node, in registration order
+	struct ReplicatedProperty {
+		StringName name;
+		real_t quantization;
+	};
+
+	struct ReplicatedNode {
+		Vector<ReplicatedProperty> properties;
+		Set<int> hidden_peers;
+	};
+
+	//snapshot sent to a peer, kept until it can't be acknowledged anymore
+	struct ReplicationSnapshot {
+		uint32_t tick;
+		HashMap<ObjectID, Vector<Variant> > states;
+		Vector<ObjectID> sent; // In packet order, acknowledgements refer to them by index.
+
+		ReplicationSnapshot() :
+				tick(0) {}
+	};
+
+	struct ReplicationPeer {
+		uint32_t acked_tick;
+		ObjectID viewer;
+		HashMap<ObjectID, uint32_t> priorities;
+		ReplicationSnapshot history[REPLICATION_HISTORY];
+
+		ReplicationPeer() :
+				acked_tick(0),
+				viewer(0) {}
+	};
+
+	//snapshot received from the server, kept as baseline for the next ones
+	struct ReplicationReceived {
+		uint32_t tick;
+		HashMap<NodePath, Vector<Variant> > states;
+
+		ReplicationReceived() :
+				tick(0) {}
 	};
 
 #ifdef DEBUG_ENABLED
@@ -88,33 +158,51 @@ private:
 	HashMap<NodePath, PathSentCache> path_send_cache;
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id;
+	HashMap<StringName, PathSentCache> name_send_cache;
+	int last_send_name_id;
 	Vector<uint8_t> packet_cache;
+	Vector<uint8_t> rpc_args_cache;
+	Map<int, RPCBatch> rpc_batches[2]; // Reliable, unreliable.
 	Node *root_node;
 	bool allow_object_decoding;
+	bool rpc_batching;
+
+	Map<ObjectID, ReplicatedNode> replicated_nodes;
+	Map<int, ReplicationPeer> replication_peers;
+	ReplicationReceived replication_received[REPLICATION_HISTORY];
+	uint32_t replication_tick;
+	uint32_t replication_last_received;
+	uint64_t replication_last_usec;
+	int replication_tick_rate;
+	real_t replication_relevancy_radius;
+	int replication_budget;
 
 protected:
 	static void _bind_methods();
 
 	void _process_packet(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_message(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_simplify_path(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len);
-	Node *_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len);
+	Node *_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len, int &r_ofs);
+	bool _process_get_name(int p_from, const uint8_t *p_packet, int p_packet_len, int &r_ofs, StringName &r_name);
 	void _process_rpc(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_replicate(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_replicate_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
+	bool _process_get_path(int p_from, const uint8_t *p_packet, int p_packet_len, int &r_ofs, NodePath &r_path);
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
-	bool _send_confirm_path(NodePath p_path, PathSentCache *psc, int p_target);
+	bool _send_confirm_path(const String &p_path, PathSentCache *psc, int p_target, NetworkCommands p_command);
+	int _make_remote_packet(bool p_set, const NodePath &p_path, int p_path_id, const StringName &p_name, int p_name_id, int p_args_len);
+	void _send_packet(int p_to, bool p_unreliable, const uint8_t *p_packet, int p_packet_len);
+	void _put_packet(int p_to, bool p_unreliable, const uint8_t *p_packet, int p_packet_len);
+	void _flush_rpc_batch(int p_to, bool p_unreliable);
+	void _replication_poll();
 
 public:
-	enum NetworkCommands {
-		NETWORK_COMMAND_REMOTE_CALL,
-		NETWORK_COMMAND_REMOTE_SET,
-		NETWORK_COMMAND_SIMPLIFY_PATH,
-		NETWORK_COMMAND_CONFIRM_PATH,
-		NETWORK_COMMAND_RAW,
-	};
-
 	enum RPCMode {
 
 		RPC_MODE_DISABLED, // No rpc for this method, calls to this will be blocked (default)
@@ -129,6 +217,7 @@ public:
 	};
 
 	void poll();
+	void flush_rpc_batches();
 	void clear();
 	void set_root_node(Node *p_node);
 	void set_network_peer(const Ref<NetworkedMultiplayerPeer> &p_peer);
@@ -157,6 +246,23 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void set_rpc_batching_enabled(bool p_enable);
+	bool is_rpc_batching_enabled() const;
+
+	Error replicate_property(Node *p_node, const StringName &p_property, real_t p_quantization = 0.0);
+	void stop_replicating(Node *p_node);
+	void set_replication_visibility(Node *p_node, int p_peer, bool p_visible);
+	bool get_replication_visibility(Node *p_node, int p_peer) const;
+	void set_replication_viewer(int p_peer, Node *p_viewer);
+	void send_replication_snapshot();
+
+	void set_replication_tick_rate(int p_rate);
+	int get_replication_tick_rate() const;
+	void set_replication_relevancy_radius(real_t p_radius);
+	real_t get_replication_relevancy_radius() const;
+	void set_replication_budget(int p_bytes);
+	int get_replication_budget() const;
+
 	void profiling_start();
 	void profiling_end();
 
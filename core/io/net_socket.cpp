@@ -40,3 +40,48 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return NULL;
 }
+
+Error NetSocket::recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_count) {
+
+	r_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		Datagram &d = r_datagrams[i];
+		int read = 0;
+		Error err = recvfrom(d.buffer, d.size, read, d.ip, d.port);
+		if (err != OK) {
+			if (r_count && err == ERR_BUSY)
+				break;
+			return err;
+		}
+		d.size = read;
+		r_count++;
+	}
+	return OK;
+}
+
+Error NetSocket::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count) {
+
+	r_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		const Datagram &d = p_datagrams[i];
+		int sent = 0;
+		Error err = d.ip.is_valid() ? sendto(d.buffer, d.size, sent, d.ip, d.port) : send(d.buffer, d.size, sent);
+		if (err != OK) {
+			if (r_count && err == ERR_BUSY)
+				break;
+			return err;
+		}
+		r_count++;
+	}
+	return OK;
+}
+
+NetSocketPoller *(*NetSocketPoller::_create)() = NULL;
+
+NetSocketPoller *NetSocketPoller::create() {
+
+	if (_create)
+		return _create();
+
+	return NULL;
+}
@@ -66,6 +66,19 @@ public:
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) = 0;
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port) = 0;
 
+	struct Datagram {
+		uint8_t *buffer;
+		int size; // Buffer capacity when receiving, replaced by the datagram size.
+		IP_Address ip; // Left invalid when sending on a connected socket.
+		uint16_t port;
+	};
+
+	// Move several datagrams in one call where the platform supports it,
+	// the defaults loop over recvfrom/sendto. Return ERR_BUSY only if
+	// nothing could be moved, otherwise OK with the count in r_count.
+	virtual Error recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_count);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count);
+
 	virtual bool is_open() const = 0;
 	virtual int get_available_bytes() const = 0;
 
@@ -78,4 +91,30 @@ public:
 	virtual Error leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 };
 
+class NetSocketPoller : public Reference {
+
+protected:
+	static NetSocketPoller *(*_create)();
+
+public:
+	static NetSocketPoller *create(); // Returns NULL if the platform has none, callers must fall back to NetSocket::poll.
+
+	struct Event {
+		void *userdata;
+		bool readable;
+		bool writable;
+		bool error; // Hang up or socket error, the owner should check the connection.
+	};
+
+	// Sockets must be removed before they are closed.
+	virtual Error add(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata) = 0;
+	virtual Error modify(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type) = 0;
+	virtual void remove(const Ref<NetSocket> &p_socket) = 0;
+	virtual int get_socket_count() const = 0;
+
+	// Waits up to p_timeout msecs (-1 blocks, 0 returns immediately) for any
+	// socket to become ready. Returns the number of events written or -1.
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout) = 0;
+};
+
 #endif // NET_SOCKET_H
@@ -39,6 +39,8 @@ PacketPeer::PacketPeer() :
 		last_get_error(OK),
 		allow_object_decoding(false),
 		encode_buffer_max_size(8 * 1024 * 1024) {
+
+	encode_buffer.set_max_size(encode_buffer_max_size);
 }
 
 void PacketPeer::set_allow_object_decoding(bool p_enable) {
@@ -56,7 +58,8 @@ void PacketPeer::set_encode_buffer_max_size(int p_max_size) {
 	ERR_FAIL_COND_MSG(p_max_size < 1024, "Max encode buffer must be at least 1024 bytes");
 	ERR_FAIL_COND_MSG(p_max_size > 256 * 1024 * 1024, "Max encode buffer cannot exceed 256 MiB");
 	encode_buffer_max_size = next_power_of_2(p_max_size);
-	encode_buffer.resize(0);
+	encode_buffer = VariantEncoder();
+	encode_buffer.set_max_size(encode_buffer_max_size);
 }
 
 int PacketPeer::get_encode_buffer_max_size() const {
@@ -106,26 +109,13 @@ Error PacketPeer::get_var(Variant &r_variant, bool p_allow_objects) {
 
 Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
 
-	int len;
-	Error err = encode_variant(p_packet, NULL, len, p_full_objects || allow_object_decoding); // compute len first
-	if (err)
-		return err;
-
-	if (len == 0)
-		return OK;
-
-	ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
-
-	if (unlikely(encode_buffer.size() < len)) {
-		encode_buffer.resize(0); // Avoid realloc
-		encode_buffer.resize(next_power_of_2(len));
-	}
-
-	PoolVector<uint8_t>::Write w = encode_buffer.write();
-	err = encode_variant(p_packet, w.ptr(), len, p_full_objects || allow_object_decoding);
+	encode_buffer.clear();
+	encode_buffer.set_full_objects(p_full_objects || allow_object_decoding);
+	Error err = encode_buffer.write(p_packet);
+	ERR_FAIL_COND_V_MSG(err == ERR_OUT_OF_MEMORY, err, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
 	ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
 
-	return put_packet(w.ptr(), len);
+	return put_packet(encode_buffer.get_data(), encode_buffer.get_size());
 }
 
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
@@ -31,6 +31,7 @@
 #ifndef PACKET_PEER_H
 #define PACKET_PEER_H
 
+#include "core/io/marshalls.h"
 #include "core/io/stream_peer.h"
 #include "core/object.h"
 #include "core/ring_buffer.h"
@@ -52,7 +53,7 @@ class PacketPeer : public Reference {
 	bool allow_object_decoding;
 
 	int encode_buffer_max_size;
-	PoolVector<uint8_t> encode_buffer;
+	VariantEncoder encode_buffer;
 
 public:
 	virtual int get_available_packet_count() const = 0;
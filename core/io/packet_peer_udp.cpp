@@ -97,22 +97,23 @@ int PacketPeerUDP::get_available_packet_count() const {
 
 Error PacketPeerUDP::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 
+	packet_held = false; // The previous packet is gone now, its slot can be reused.
+
 	Error err = _poll();
 	if (err != OK)
 		return err;
 	if (queue_count == 0)
 		return ERR_UNAVAILABLE;
 
-	uint32_t size = 0;
-	uint8_t ipv6[16];
-	rb.read(ipv6, 16, true);
-	packet_ip.set_ipv6(ipv6);
-	rb.read((uint8_t *)&packet_port, 4, true);
-	rb.read((uint8_t *)&size, 4, true);
-	rb.read(packet_buffer, size, true);
+	const QueueSlot &slot = queue_slots[queue_head];
+	packet_ip = slot.ip;
+	packet_port = slot.port;
+	*r_buffer = queue_buffer.ptr() + queue_head * PACKET_BUFFER_SIZE;
+	r_buffer_size = slot.size;
+
+	queue_head = (queue_head + 1) % queue_slots.size();
 	--queue_count;
-	*r_buffer = packet_buffer;
-	r_buffer_size = size;
+	packet_held = true;
 	return OK;
 }
 
@@ -153,6 +154,47 @@ Error PacketPeerUDP::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	return OK;
 }
 
+Error PacketPeerUDP::put_packets(const uint8_t *const *p_buffers, const int *p_sizes, int p_count) {
+
+	ERR_FAIL_COND_V(!_sock.is_valid(), ERR_UNAVAILABLE);
+	ERR_FAIL_COND_V(!peer_addr.is_valid(), ERR_UNCONFIGURED);
+
+	if (!_sock->is_open()) {
+		IP::Type ip_type = peer_addr.is_ipv4() ? IP::TYPE_IPV4 : IP::TYPE_IPV6;
+		Error err = _sock->open(NetSocket::TYPE_UDP, ip_type);
+		ERR_FAIL_COND_V(err != OK, err);
+		_sock->set_blocking_enabled(false);
+		_sock->set_broadcasting_enabled(broadcast);
+	}
+
+	NetSocket::Datagram batch[64];
+	int done = 0;
+
+	while (done < p_count) {
+		int count = MIN(p_count - done, 64);
+		for (int i = 0; i < count; i++) {
+			batch[i].buffer = const_cast<uint8_t *>(p_buffers[done + i]);
+			batch[i].size = p_sizes[done + i];
+			batch[i].ip = connected ? IP_Address() : peer_addr;
+			batch[i].port = peer_port;
+		}
+
+		int sent = 0;
+		Error err = _sock->sendto_batch(batch, count, sent);
+		if (err != OK) {
+			if (err != ERR_BUSY)
+				return FAILED;
+			else if (!blocking)
+				return ERR_BUSY;
+			// Keep trying to send the rest
+			continue;
+		}
+		done += sent;
+	}
+
+	return OK;
+}
+
 int PacketPeerUDP::get_max_packet_size() const {
 
 	return 512; // uhm maybe not
@@ -184,7 +226,7 @@ Error PacketPeerUDP::listen(int p_port, const IP_Address &p_bind_address, int p_
 		_sock->close();
 		return err;
 	}
-	rb.resize(nearest_shift(p_recv_buffer_size));
+	_setup_queue(p_recv_buffer_size / 4096);
 	return OK;
 }
 
@@ -194,7 +236,7 @@ Error PacketPeerUDP::connect_socket(Ref<NetSocket> p_sock) {
 	uint16_t r_port;
 	IP_Address r_ip;
 
-	err = p_sock->recvfrom(recv_buffer, sizeof(recv_buffer), read, r_ip, r_port, true);
+	err = p_sock->recvfrom(queue_buffer.ptrw(), PACKET_BUFFER_SIZE, read, r_ip, r_port, true);
 	ERR_FAIL_COND_V(err != OK, err);
 	err = p_sock->connect_to_host(r_ip, r_port);
 	ERR_FAIL_COND_V(err != OK, err);
@@ -236,7 +278,9 @@ Error PacketPeerUDP::connect_to_host(const IP_Address &p_host, int p_port) {
 	peer_port = p_port;
 
 	// Flush any packet we might still have in queue.
-	rb.clear();
+	queue_head = 0;
+	queue_count = 0;
+	packet_held = false;
 	return OK;
 }
 
@@ -248,8 +292,9 @@ void PacketPeerUDP::close() {
 
 	if (_sock.is_valid())
 		_sock->close();
-	rb.resize(16);
+	queue_head = 0;
 	queue_count = 0;
+	packet_held = false;
 	connected = false;
 }
 
@@ -259,6 +304,17 @@ Error PacketPeerUDP::wait() {
 	return _sock->poll(NetSocket::POLL_TYPE_IN, -1);
 }
 
+void PacketPeerUDP::_setup_queue(int p_slots) {
+
+	int slots = CLAMP(p_slots, (int)QUEUE_SLOTS_MIN, (int)QUEUE_SLOTS_MAX);
+	queue_buffer.resize(slots * PACKET_BUFFER_SIZE);
+	queue_slots.resize(slots);
+	recv_batch.resize(slots);
+	queue_head = 0;
+	queue_count = 0;
+	packet_held = false;
+}
+
 Error PacketPeerUDP::_poll() {
 
 	ERR_FAIL_COND_V(!_sock.is_valid(), ERR_UNAVAILABLE);
@@ -267,43 +323,45 @@ Error PacketPeerUDP::_poll() {
 		return FAILED;
 	}
 
-	Error err;
-	int read;
-	IP_Address ip;
-	uint16_t port;
+	int slots = queue_slots.size();
+	uint8_t *buffer = queue_buffer.ptrw();
+	NetSocket::Datagram *batch = recv_batch.ptrw();
 
 	while (true) {
-		if (connected) {
-			err = _sock->recv(recv_buffer, sizeof(recv_buffer), read);
-			ip = peer_addr;
-			port = peer_port;
-		} else {
-			err = _sock->recvfrom(recv_buffer, sizeof(recv_buffer), read, ip, port);
+		// When the queue is full the rest waits in the OS socket buffer.
+		int free = slots - queue_count - (packet_held ? 1 : 0);
+		if (free <= 0)
+			break;
+
+		int first = (queue_head + queue_count) % slots;
+		for (int i = 0; i < free; i++) {
+			batch[i].buffer = buffer + ((first + i) % slots) * PACKET_BUFFER_SIZE;
+			batch[i].size = PACKET_BUFFER_SIZE;
 		}
 
+		int received = 0;
+		Error err = _sock->recvfrom_batch(batch, free, received);
 		if (err != OK) {
 			if (err == ERR_BUSY)
 				break;
 			return FAILED;
 		}
 
-		if (rb.space_left() < read + 24) {
-#ifdef TOOLS_ENABLED
-			WARN_PRINTS("Buffer full, dropping packets!");
-#endif
-			continue;
+		for (int i = 0; i < received; i++) {
+			QueueSlot &slot = queue_slots.write[(first + i) % slots];
+			slot.size = batch[i].size;
+			slot.ip = connected ? peer_addr : batch[i].ip;
+			slot.port = connected ? peer_port : batch[i].port;
 		}
+		queue_count += received;
 
-		uint32_t port32 = port;
-		rb.write(ip.get_ipv6(), 16);
-		rb.write((uint8_t *)&port32, 4);
-		rb.write((uint8_t *)&read, 4);
-		rb.write(recv_buffer, read);
-		++queue_count;
+		if (received == 0)
+			break;
 	}
 
 	return OK;
 }
+
 bool PacketPeerUDP::is_listening() const {
 
 	return _sock.is_valid() && _sock->is_open();
@@ -343,14 +401,16 @@ void PacketPeerUDP::_bind_methods() {
 }
 
 PacketPeerUDP::PacketPeerUDP() :
-		packet_port(0),
+		queue_head(0),
 		queue_count(0),
+		packet_held(false),
+		packet_port(0),
 		peer_port(0),
 		connected(false),
 		blocking(true),
 		broadcast(false),
 		_sock(Ref<NetSocket>(NetSocket::create())) {
-	rb.resize(16);
+	_setup_queue(16);
 }
 
 PacketPeerUDP::~PacketPeerUDP() {
@@ -40,15 +40,28 @@ class PacketPeerUDP : public PacketPeer {
 
 protected:
 	enum {
-		PACKET_BUFFER_SIZE = 65536
+		PACKET_BUFFER_SIZE = 65536,
+		QUEUE_SLOTS_MIN = 2,
+		QUEUE_SLOTS_MAX = 256
 	};
 
-	RingBuffer<uint8_t> rb;
-	uint8_t recv_buffer[PACKET_BUFFER_SIZE];
-	uint8_t packet_buffer[PACKET_BUFFER_SIZE];
+	// Datagrams are received in batches straight into fixed size slots and
+	// get_packet() returns them from there. Only the pages actually written
+	// by a datagram get committed, so big slots stay cheap.
+	struct QueueSlot {
+		int size;
+		IP_Address ip;
+		uint16_t port;
+	};
+
+	Vector<uint8_t> queue_buffer;
+	Vector<QueueSlot> queue_slots;
+	Vector<NetSocket::Datagram> recv_batch;
+	int queue_head;
+	int queue_count;
+	bool packet_held; // The slot before queue_head is what get_packet() returned last.
 	IP_Address packet_ip;
 	int packet_port;
-	int queue_count;
 
 	IP_Address peer_addr;
 	int peer_port;
@@ -62,6 +75,7 @@ protected:
 	String _get_packet_ip() const;
 
 	Error _set_dest_address(const String &p_address, int p_port);
+	void _setup_queue(int p_slots);
 	Error _poll();
 
 public:
@@ -81,6 +95,7 @@ public:
 	void set_dest_address(const IP_Address &p_address, int p_port);
 
 	Error put_packet(const uint8_t *p_buffer, int p_buffer_size);
+	Error put_packets(const uint8_t *const *p_buffers, const int *p_sizes, int p_count); // Same destination, as few syscalls as the platform allows.
 	Error get_packet(const uint8_t **r_buffer, int &r_buffer_size);
 	int get_available_packet_count() const;
 	int get_max_packet_size() const;
@@ -223,13 +223,12 @@ void StreamPeer::put_utf8_string(const String &p_string) {
 }
 void StreamPeer::put_var(const Variant &p_variant, bool p_full_objects) {
 
-	int len = 0;
-	Vector<uint8_t> buf;
-	encode_variant(p_variant, NULL, len, p_full_objects);
-	buf.resize(len);
-	put_32(len);
-	encode_variant(p_variant, buf.ptrw(), len, p_full_objects);
-	put_data(buf.ptr(), buf.size());
+	var_encoder.clear();
+	var_encoder.set_full_objects(p_full_objects);
+	Error err = var_encoder.write(p_variant);
+	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
+	put_32(var_encoder.get_size());
+	put_data(var_encoder.get_data(), var_encoder.get_size());
 }
 
 uint8_t StreamPeer::get_u8() {
@@ -362,14 +361,24 @@ String StreamPeer::get_utf8_string(int p_bytes) {
 Variant StreamPeer::get_var(bool p_allow_objects) {
 
 	int len = get_32();
-	Vector<uint8_t> var;
-	Error err = var.resize(len);
-	ERR_FAIL_COND_V(err != OK, Variant());
-	err = get_data(var.ptrw(), len);
-	ERR_FAIL_COND_V(err != OK, Variant());
+	ERR_FAIL_COND_V(len < 0, Variant());
+	if (var_buffer.size() < len) {
+		// Round small sizes up so the buffer settles quickly, larger ones are only kept
+		// for this value, and next_power_of_2() would overflow near 2^31 anyway.
+		Error err = var_buffer.resize(len <= VAR_BUFFER_MAX_KEPT ? next_power_of_2(len) : len);
+		ERR_FAIL_COND_V(err != OK, Variant());
+	}
+	Error err = get_data(var_buffer.ptrw(), len);
 
 	Variant ret;
-	err = decode_variant(ret, var.ptr(), len, NULL, p_allow_objects);
+	if (err == OK) {
+		err = decode_variant(ret, var_buffer.ptr(), len, NULL, p_allow_objects);
+	}
+
+	if (var_buffer.size() > VAR_BUFFER_MAX_KEPT) {
+		var_buffer.clear(); // Don't hold on to the memory of one oversized value.
+	}
+
 	ERR_FAIL_COND_V_MSG(err != OK, Variant(), "Error when trying to decode Variant.");
 
 	return ret;
@@ -31,6 +31,7 @@
 #ifndef STREAM_PEER_H
 #define STREAM_PEER_H
 
+#include "core/io/marshalls.h"
 #include "core/reference.h"
 
 class StreamPeer : public Reference {
@@ -49,6 +50,13 @@ protected:
 
 	bool big_endian;
 
+	enum {
+		VAR_BUFFER_MAX_KEPT = 1024 * 1024 // get_var() frees bigger buffers after use
+	};
+
+	VariantEncoder var_encoder;
+	Vector<uint8_t> var_buffer;
+
 public:
 	virtual Error put_data(const uint8_t *p_data, int p_bytes) = 0; ///< put a whole chunk of data, blocking until it sent
 	virtual Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) = 0; ///< put as much data as possible, without blocking.
@@ -78,6 +78,8 @@ public:
 
 	void set_no_delay(bool p_enabled);
 
+	Ref<NetSocket> get_net_socket() const { return _sock; } // For registering with a NetSocketPoller.
+
 	// Read/Write from StreamPeer
 	Error put_data(const uint8_t *p_data, int p_bytes);
 	Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent);
@@ -70,8 +70,16 @@ struct MemoryPool {
 	static uint32_t alloc_count;
 	static uint32_t allocs_used;
 	static Mutex *alloc_mutex;
-	static size_t total_memory;
-	static size_t max_memory;
+	static uint64_t total_memory;
+	static uint64_t max_memory;
+
+	// Debug memory accounting is done with atomics, so resizing never has to take alloc_mutex.
+	_FORCE_INLINE_ static void _add_memory(size_t p_size) {
+		atomic_exchange_if_greater(&max_memory, atomic_add(&total_memory, (uint64_t)p_size));
+	}
+	_FORCE_INLINE_ static void _remove_memory(size_t p_size) {
+		atomic_sub(&total_memory, (uint64_t)p_size);
+	}
 
 	static void setup(uint32_t p_max_allocs = (1 << 16));
 	static void cleanup();
@@ -115,15 +123,12 @@ class PoolVector {
 		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
 		alloc->lock = 0;
 
+		MemoryPool::alloc_mutex->unlock();
+
 #ifdef DEBUG_ENABLED
-		MemoryPool::total_memory += alloc->size;
-		if (MemoryPool::total_memory > MemoryPool::max_memory) {
-			MemoryPool::max_memory = MemoryPool::total_memory;
-		}
+		MemoryPool::_add_memory(alloc->size);
 #endif
 
-		MemoryPool::alloc_mutex->unlock();
-
 		if (MemoryPool::memory_pool) {
 
 		} else {
@@ -148,9 +153,7 @@ class PoolVector {
 			//this should never happen but..
 
 #ifdef DEBUG_ENABLED
-			MemoryPool::alloc_mutex->lock();
-			MemoryPool::total_memory -= old_alloc->size;
-			MemoryPool::alloc_mutex->unlock();
+			MemoryPool::_remove_memory(old_alloc->size);
 #endif
 
 			{
@@ -227,9 +230,7 @@ class PoolVector {
 		}
 
 #ifdef DEBUG_ENABLED
-		MemoryPool::alloc_mutex->lock();
-		MemoryPool::total_memory -= alloc->size;
-		MemoryPool::alloc_mutex->unlock();
+		MemoryPool::_remove_memory(alloc->size);
 #endif
 
 		if (MemoryPool::memory_pool) {
@@ -454,6 +455,30 @@ public:
 
 	bool is_locked() const { return alloc && alloc->lock > 0; }
 
+	// True if other PoolVectors (or Variants, or servers) reference the same buffer,
+	// in which case the next write() will copy it.
+	bool is_shared() const { return alloc && alloc->refcount.get() > 1; }
+
+	/* Direct access, without Read/Write lock objects.
+	 * The pointers stay valid until the PoolVector is resized or destroyed,
+	 * so they are meant for single-owner buffers that are filled or consumed
+	 * in one go (mesh, image and physics data). ptrw() still copies the
+	 * buffer first if it is shared, like write() does.
+	 * They don't take the lock, so resize() can't tell if one is still held.
+	 * Not available with the memory pool, which may move the buffer anytime.
+	 */
+	_FORCE_INLINE_ const T *ptr() const {
+		ERR_FAIL_COND_V_MSG(MemoryPool::memory_pool, NULL, "PoolVector direct access is not available with the memory pool, use read().");
+		return alloc ? (const T *)alloc->mem : NULL;
+	}
+	T *ptrw() {
+		ERR_FAIL_COND_V_MSG(MemoryPool::memory_pool, NULL, "PoolVector direct access is not available with the memory pool, use write().");
+		if (!alloc)
+			return NULL;
+		_copy_on_write();
+		return (T *)alloc->mem;
+	}
+
 	inline T operator[](int p_index) const;
 
 	Error resize(int p_size);
@@ -461,11 +486,23 @@ public:
 	void invert();
 
 	void operator=(const PoolVector &p_pool_vector) { _reference(p_pool_vector); }
+	void operator=(PoolVector &&p_pool_vector) {
+		if (alloc == p_pool_vector.alloc)
+			return;
+		_unreference();
+		// Steal the reference, no refcount traffic and the buffer stays unique.
+		alloc = p_pool_vector.alloc;
+		p_pool_vector.alloc = NULL;
+	}
 	PoolVector() { alloc = NULL; }
 	PoolVector(const PoolVector &p_pool_vector) {
 		alloc = NULL;
 		_reference(p_pool_vector);
 	}
+	PoolVector(PoolVector &&p_pool_vector) {
+		alloc = p_pool_vector.alloc;
+		p_pool_vector.alloc = NULL;
+	}
 	~PoolVector() { _unreference(); }
 };
 
@@ -559,13 +596,8 @@ Error PoolVector<T>::resize(int p_size) {
 	_copy_on_write(); // make it unique
 
 #ifdef DEBUG_ENABLED
-	MemoryPool::alloc_mutex->lock();
-	MemoryPool::total_memory -= alloc->size;
-	MemoryPool::total_memory += new_size;
-	if (MemoryPool::total_memory > MemoryPool::max_memory) {
-		MemoryPool::max_memory = MemoryPool::total_memory;
-	}
-	MemoryPool::alloc_mutex->unlock();
+	MemoryPool::_remove_memory(alloc->size);
+	MemoryPool::_add_memory(new_size);
 #endif
 
 	int cur_elements = alloc->size / sizeof(T);
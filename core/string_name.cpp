@@ -36,10 +36,22 @@
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
+	scs.hash = 0;
+	scs.hashed = false;
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+StaticCString StaticCString::create(const char *p_ptr, uint32_t p_hash) {
+	StaticCString scs;
+	scs.ptr = p_ptr;
+	scs.hash = p_hash;
+	scs.hashed = true;
+	return scs;
+}
+
+StringName::_Shard StringName::_shards[STRING_TABLE_SHARDS];
+uint32_t StringName::lock_contentions = 0;
+uint32_t StringName::table_resizes = 0;
 
 StringName _scs_create(const char *p_chr) {
 
@@ -47,49 +59,137 @@ StringName _scs_create(const char *p_chr) {
 }
 
 bool StringName::configured = false;
-Mutex *StringName::lock = NULL;
 
 void StringName::setup() {
 
-	lock = Mutex::create();
-
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		_table[i] = NULL;
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+
+		_Shard &shard = _shards[i];
+		shard.lock = Mutex::create();
+		shard.bits = STRING_TABLE_SHARD_MIN_BITS;
+		shard.count = 0;
+		shard.table = memnew_arr(_Data *, 1 << shard.bits);
+		for (int j = 0; j < (1 << shard.bits); j++) {
+			shard.table[j] = NULL;
+		}
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
 
-	lock->lock();
-
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+
+		_Shard &shard = _shards[i];
+		shard.lock->lock();
 
-		while (_table[i]) {
+		for (int j = 0; j < (1 << shard.bits); j++) {
 
-			_Data *d = _table[i];
-			lost_strings++;
-			if (OS::get_singleton()->is_stdout_verbose()) {
-				if (d->cname) {
-					print_line("Orphan StringName: " + String(d->cname));
-				} else {
-					print_line("Orphan StringName: " + String(d->name));
+			while (shard.table[j]) {
+
+				_Data *d = shard.table[j];
+				lost_strings++;
+				if (OS::get_singleton()->is_stdout_verbose()) {
+					if (d->cname) {
+						print_line("Orphan StringName: " + String(d->cname));
+					} else {
+						print_line("Orphan StringName: " + String(d->name));
+					}
 				}
-			}
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+				shard.table[j] = shard.table[j]->next;
+				memdelete(d);
+			}
 		}
+
+		memdelete_arr(shard.table);
+		shard.table = NULL;
+		shard.count = 0;
+
+		shard.lock->unlock();
+		memdelete(shard.lock);
+		shard.lock = NULL;
 	}
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
-	lock->unlock();
+	print_verbose("StringName: " + itos(lock_contentions) + " contended table locks, " + itos(table_resizes) + " table resizes.");
+
+	configured = false;
+}
+
+void StringName::_lock_shard(_Shard &p_shard) {
+
+	if (p_shard.lock->try_lock() != OK) {
+		atomic_increment(&lock_contentions);
+		p_shard.lock->lock();
+	}
+}
+
+void StringName::_grow_shard(_Shard &p_shard) {
+
+	uint32_t new_bits = p_shard.bits + 1;
+	uint32_t new_len = 1 << new_bits;
+	uint32_t new_mask = new_len - 1;
+
+	_Data **new_table = memnew_arr(_Data *, new_len);
+	for (uint32_t i = 0; i < new_len; i++) {
+		new_table[i] = NULL;
+	}
+
+	for (uint32_t i = 0; i < (1U << p_shard.bits); i++) {
+
+		_Data *d = p_shard.table[i];
+		while (d) {
+			_Data *next = d->next;
+			uint32_t idx = d->hash & new_mask;
+
+			d->prev = NULL;
+			d->next = new_table[idx];
+			if (new_table[idx])
+				new_table[idx]->prev = d;
+			new_table[idx] = d;
+
+			d = next;
+		}
+	}
+
+	memdelete_arr(p_shard.table);
+	p_shard.table = new_table;
+	p_shard.bits = new_bits;
+
+	atomic_increment(&table_resizes);
+}
+
+StringName::_Data *StringName::_insert(_Shard &p_shard, _Data *p_data) {
+
+	// Must be called with the shard locked.
+	uint32_t idx = p_data->hash & ((1 << p_shard.bits) - 1);
+
+	p_data->refcount.init();
+	p_data->next = p_shard.table[idx];
+	p_data->prev = NULL;
+	if (p_shard.table[idx])
+		p_shard.table[idx]->prev = p_data;
+	p_shard.table[idx] = p_data;
+
+	p_shard.count++;
+	if (p_shard.count > ((1U << p_shard.bits) * STRING_TABLE_MAX_LOAD) && p_shard.bits < STRING_TABLE_SHARD_MAX_BITS) {
+		_grow_shard(p_shard);
+	}
 
-	memdelete(lock);
+	return p_data;
+}
+
+int StringName::get_name_count() {
+
+	int count = 0;
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+		count += _shards[i].count;
+	}
+	return count;
 }
 
 void StringName::unref() {
@@ -98,22 +198,25 @@ void StringName::unref() {
 
 	if (_data && _data->refcount.unref()) {
 
-		lock->lock();
+		_Shard &shard = _get_shard(_data->hash);
+		_lock_shard(shard);
 
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			if (_table[_data->idx] != _data) {
+			uint32_t idx = _data->hash & ((1 << shard.bits) - 1);
+			if (shard.table[idx] != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			shard.table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
+		shard.count--;
 		memdelete(_data);
-		lock->unlock();
+		shard.lock->unlock();
 	}
 
 	_data = NULL;
@@ -184,13 +287,12 @@ StringName::StringName(const char *p_name) {
 	if (!p_name || p_name[0] == 0)
 		return; //empty, ignore
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	_lock_shard(shard);
 
-	_data = _table[idx];
+	_data = shard.table[hash & ((1 << shard.bits) - 1)];
 
 	while (_data) {
 
@@ -203,24 +305,18 @@ StringName::StringName(const char *p_name) {
 	if (_data) {
 		if (_data->refcount.ref()) {
 			// exists
-			lock->unlock();
+			shard.lock->unlock();
 			return;
 		}
 	}
 
 	_data = memnew(_Data);
 	_data->name = p_name;
-	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(shard, _data);
 
-	lock->unlock();
+	shard.lock->unlock();
 }
 
 StringName::StringName(const StaticCString &p_static_string) {
@@ -231,13 +327,12 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_static_string.ptr);
+	uint32_t hash = p_static_string.hashed ? p_static_string.hash : String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	_lock_shard(shard);
 
-	_data = _table[idx];
+	_data = shard.table[hash & ((1 << shard.bits) - 1)];
 
 	while (_data) {
 
@@ -250,24 +345,17 @@ StringName::StringName(const StaticCString &p_static_string) {
 	if (_data) {
 		if (_data->refcount.ref()) {
 			// exists
-			lock->unlock();
+			shard.lock->unlock();
 			return;
 		}
 	}
 
 	_data = memnew(_Data);
-
-	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(shard, _data);
 
-	lock->unlock();
+	shard.lock->unlock();
 }
 
 StringName::StringName(const String &p_name) {
@@ -279,13 +367,12 @@ StringName::StringName(const String &p_name) {
 	if (p_name == String())
 		return;
 
-	lock->lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	_lock_shard(shard);
 
-	_data = _table[idx];
+	_data = shard.table[hash & ((1 << shard.bits) - 1)];
 
 	while (_data) {
 
@@ -297,24 +384,18 @@ StringName::StringName(const String &p_name) {
 	if (_data) {
 		if (_data->refcount.ref()) {
 			// exists
-			lock->unlock();
+			shard.lock->unlock();
 			return;
 		}
 	}
 
 	_data = memnew(_Data);
 	_data->name = p_name;
-	_data->refcount.init();
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_insert(shard, _data);
 
-	lock->unlock();
+	shard.lock->unlock();
 }
 
 StringName StringName::search(const char *p_name) {
@@ -325,13 +406,12 @@ StringName StringName::search(const char *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	_lock_shard(shard);
 
-	_Data *_data = _table[idx];
+	_Data *_data = shard.table[hash & ((1 << shard.bits) - 1)];
 
 	while (_data) {
 
@@ -342,12 +422,12 @@ StringName StringName::search(const char *p_name) {
 	}
 
 	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+		shard.lock->unlock();
 
 		return StringName(_data);
 	}
 
-	lock->unlock();
+	shard.lock->unlock();
 	return StringName(); //does not exist
 }
 
@@ -359,13 +439,12 @@ StringName StringName::search(const CharType *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	_lock_shard(shard);
 
-	_Data *_data = _table[idx];
+	_Data *_data = shard.table[hash & ((1 << shard.bits) - 1)];
 
 	while (_data) {
 
@@ -376,24 +455,23 @@ StringName StringName::search(const CharType *p_name) {
 	}
 
 	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+		shard.lock->unlock();
 		return StringName(_data);
 	}
 
-	lock->unlock();
+	shard.lock->unlock();
 	return StringName(); //does not exist
 }
 StringName StringName::search(const String &p_name) {
 
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	lock->lock();
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Shard &shard = _get_shard(hash);
+	_lock_shard(shard);
 
-	_Data *_data = _table[idx];
+	_Data *_data = shard.table[hash & ((1 << shard.bits) - 1)];
 
 	while (_data) {
 
@@ -404,11 +482,11 @@ StringName StringName::search(const String &p_name) {
 	}
 
 	if (_data && _data->refcount.ref()) {
-		lock->unlock();
+		shard.lock->unlock();
 		return StringName(_data);
 	}
 
-	lock->unlock();
+	shard.lock->unlock();
 	return StringName(); //does not exist
 }
 
@@ -419,5 +497,8 @@ StringName::StringName() {
 
 StringName::~StringName() {
 
-	unref();
+	// Function-local static names (see SNAME) are destroyed after the table is gone.
+	if (configured) {
+		unref();
+	}
 }
@@ -38,16 +38,37 @@
 struct StaticCString {
 
 	const char *ptr;
+	uint32_t hash;
+	bool hashed;
 	static StaticCString create(const char *p_ptr);
+	static StaticCString create(const char *p_ptr, uint32_t p_hash);
+
+	// Same function as String::hash(const char *), usable in constant expressions.
+	static constexpr uint32_t compute_hash(const char *p_cstr) {
+
+		uint32_t hashv = 5381;
+		while (*p_cstr) {
+			hashv = ((hashv << 5) + hashv) + (uint32_t)*p_cstr; /* hash * 33 + c */
+			p_cstr++;
+		}
+		return hashv;
+	}
 };
 
 class StringName {
 
+	// The table is split in shards, each one with its own lock and its own
+	// bucket array, which grows as names are added. Threads interning
+	// unrelated names (resource loading, script compilation) rarely end up
+	// fighting over the same lock.
 	enum {
 
-		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARDS = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_SHARD_MASK = STRING_TABLE_SHARDS - 1,
+		STRING_TABLE_SHARD_MIN_BITS = 6,
+		STRING_TABLE_SHARD_MAX_BITS = 20,
+		STRING_TABLE_MAX_LOAD = 2
 	};
 
 	struct _Data {
@@ -56,19 +77,36 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
 		uint32_t hash;
 		_Data *prev;
 		_Data *next;
 		_Data() {
 			cname = NULL;
 			next = prev = NULL;
-			idx = 0;
 			hash = 0;
 		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct _Shard {
+		Mutex *lock;
+		_Data **table;
+		uint32_t bits;
+		uint32_t count;
+	};
+
+	static _Shard _shards[STRING_TABLE_SHARDS];
+
+	static uint32_t lock_contentions;
+	static uint32_t table_resizes;
+
+	_FORCE_INLINE_ static _Shard &_get_shard(uint32_t p_hash) {
+		// Fibonacci hashing, so shard selection is independent from the bucket bits.
+		return _shards[((p_hash * 2654435769U) >> (32 - STRING_TABLE_SHARD_BITS)) & STRING_TABLE_SHARD_MASK];
+	}
+
+	static void _lock_shard(_Shard &p_shard);
+	static void _grow_shard(_Shard &p_shard);
+	static _Data *_insert(_Shard &p_shard, _Data *p_data);
 
 	_Data *_data;
 
@@ -82,7 +120,6 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 
-	static Mutex *lock;
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -132,6 +169,11 @@ public:
 	static StringName search(const CharType *p_name);
 	static StringName search(const String &p_name);
 
+	// Interning statistics, for profiling multi-threaded loading.
+	static uint32_t get_lock_contention_count() { return lock_contentions; }
+	static uint32_t get_table_resize_count() { return table_resizes; }
+	static int get_name_count();
+
 	struct AlphCompare {
 
 		_FORCE_INLINE_ bool operator()(const StringName &l, const StringName &r) const {
@@ -166,4 +208,12 @@ public:
 
 StringName _scs_create(const char *p_chr);
 
+// Returns a StringName for a string literal, hashed at compile time and
+// interned only once. Meant for literals used in hot engine code paths.
+#define SNAME(m_arg) ([]() -> const StringName & {                                 \
+	static constexpr uint32_t sname_hash = StaticCString::compute_hash(m_arg);      \
+	static const StringName sname = StaticCString::create(m_arg, sname_hash);       \
+	return sname;                                                                   \
+})()
+
 #endif // STRING_NAME_H
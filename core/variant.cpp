@@ -2450,6 +2450,42 @@ Variant::Variant(const PoolVector<Color> &p_color_array) {
 	memnew_placement(_data._mem, PoolVector<Color>(p_color_array));
 }
 
+Variant::Variant(PoolVector<uint8_t> &&p_raw_array) {
+
+	type = POOL_BYTE_ARRAY;
+	memnew_placement(_data._mem, PoolVector<uint8_t>(static_cast<PoolVector<uint8_t> &&>(p_raw_array)));
+}
+Variant::Variant(PoolVector<int> &&p_int_array) {
+
+	type = POOL_INT_ARRAY;
+	memnew_placement(_data._mem, PoolVector<int>(static_cast<PoolVector<int> &&>(p_int_array)));
+}
+Variant::Variant(PoolVector<real_t> &&p_real_array) {
+
+	type = POOL_REAL_ARRAY;
+	memnew_placement(_data._mem, PoolVector<real_t>(static_cast<PoolVector<real_t> &&>(p_real_array)));
+}
+Variant::Variant(PoolVector<String> &&p_string_array) {
+
+	type = POOL_STRING_ARRAY;
+	memnew_placement(_data._mem, PoolVector<String>(static_cast<PoolVector<String> &&>(p_string_array)));
+}
+Variant::Variant(PoolVector<Vector2> &&p_vector2_array) {
+
+	type = POOL_VECTOR2_ARRAY;
+	memnew_placement(_data._mem, PoolVector<Vector2>(static_cast<PoolVector<Vector2> &&>(p_vector2_array)));
+}
+Variant::Variant(PoolVector<Vector3> &&p_vector3_array) {
+
+	type = POOL_VECTOR3_ARRAY;
+	memnew_placement(_data._mem, PoolVector<Vector3>(static_cast<PoolVector<Vector3> &&>(p_vector3_array)));
+}
+Variant::Variant(PoolVector<Color> &&p_color_array) {
+
+	type = POOL_COLOR_ARRAY;
+	memnew_placement(_data._mem, PoolVector<Color>(static_cast<PoolVector<Color> &&>(p_color_array)));
+}
+
 Variant::Variant(const PoolVector<Face3> &p_face_array) {
 
 	PoolVector<Vector3> vertices;
@@ -307,6 +307,16 @@ public:
 	Variant(const Vector<Vector2> &p_array); // helper
 	Variant(const PoolVector<Vector2> &p_vector2_array); // helper
 
+	// Moving a pool array in keeps its buffer unique, so writing to it after
+	// extracting it back does not trigger a copy.
+	Variant(PoolVector<uint8_t> &&p_raw_array);
+	Variant(PoolVector<int> &&p_int_array);
+	Variant(PoolVector<real_t> &&p_real_array);
+	Variant(PoolVector<String> &&p_string_array);
+	Variant(PoolVector<Vector2> &&p_vector2_array);
+	Variant(PoolVector<Vector3> &&p_vector3_array);
+	Variant(PoolVector<Color> &&p_color_array);
+
 	Variant(const IP_Address &p_address);
 
 	// If this changes the table in variant_op must be updated
@@ -2507,8 +2507,12 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 	}
 #endif
 
-	surface->data = array;
-	surface->index_data = p_index_array;
+	// Surfaces updated in place would make this copy stale, and holding a reference to the
+	// caller's buffer forces a full copy each time it writes to it again.
+	if (!(p_format & VS::ARRAY_FLAG_USE_DYNAMIC_UPDATE)) {
+		surface->data = array;
+		surface->index_data = p_index_array;
+	}
 	surface->total_data_size += surface->array_byte_size + surface->index_array_byte_size;
 
 	for (int i = 0; i < surface->skeleton_bone_used.size(); i++) {
@@ -2534,7 +2538,7 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 
 			glGenBuffers(1, &surface->index_id);
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surface->index_id);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_array_size, ir.ptr(), GL_STATIC_DRAW);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_array_size, ir.ptr(), (p_format & VS::ARRAY_FLAG_USE_DYNAMIC_UPDATE) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 		} else {
 			surface->index_id = 0;
@@ -2616,6 +2620,23 @@ void RasterizerStorageGLES2::mesh_surface_update_region(RID p_mesh, int p_surfac
 	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 }
 
+void RasterizerStorageGLES2::mesh_surface_update_index_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) {
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(!mesh->surfaces[p_surface]->index_id);
+
+	int total_size = p_data.size();
+	ERR_FAIL_COND(p_offset + total_size > mesh->surfaces[p_surface]->index_array_byte_size);
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->surfaces[p_surface]->index_id);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, p_offset, total_size, r.ptr());
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+}
+
 void RasterizerStorageGLES2::mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
 	ERR_FAIL_COND(!mesh);
@@ -2671,6 +2692,7 @@ PoolVector<uint8_t> RasterizerStorageGLES2::mesh_surface_get_array(RID p_mesh, i
 #ifndef TOOLS_ENABLED
 	ERR_PRINT("OpenGL ES 2.0 does not allow retrieving mesh array data");
 #endif
+	ERR_FAIL_COND_V_MSG(surface->format & VS::ARRAY_FLAG_USE_DYNAMIC_UPDATE, PoolVector<uint8_t>(), "OpenGL ES 2.0 does not keep the array data of surfaces with dynamic updates.");
 	return surface->data;
 }
 
@@ -2680,6 +2702,7 @@ PoolVector<uint8_t> RasterizerStorageGLES2::mesh_surface_get_index_array(RID p_m
 	ERR_FAIL_INDEX_V(p_surface, mesh->surfaces.size(), PoolVector<uint8_t>());
 
 	Surface *surface = mesh->surfaces[p_surface];
+	ERR_FAIL_COND_V_MSG(surface->format & VS::ARRAY_FLAG_USE_DYNAMIC_UPDATE, PoolVector<uint8_t>(), "OpenGL ES 2.0 does not keep the index data of surfaces with dynamic updates.");
 
 	return surface->index_data;
 }
@@ -3683,6 +3706,23 @@ Transform RasterizerStorageGLES2::skeleton_bone_get_transform(RID p_skeleton, in
 
 	return ret;
 }
+
+void RasterizerStorageGLES2::skeleton_set_as_bulk_array(RID p_skeleton, const PoolVector<float> &p_array) {
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+	ERR_FAIL_COND(!skeleton);
+
+	ERR_FAIL_COND(skeleton->use_2d);
+	ERR_FAIL_COND(p_array.size() != skeleton->size * 4 * 3);
+
+	// The bulk layout (three rows of basis + origin per bone) is the same as bone_data.
+	PoolVector<float>::Read r = p_array.read();
+	copymem(skeleton->bone_data.ptrw(), r.ptr(), sizeof(float) * p_array.size());
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 void RasterizerStorageGLES2::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
 	ERR_FAIL_COND(!skeleton);
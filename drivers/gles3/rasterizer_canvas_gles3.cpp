@@ -30,6 +30,7 @@
 
 #include "rasterizer_canvas_gles3.h"
 
+#include "core/engine.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "rasterizer_scene_gles3.h"
@@ -1414,6 +1415,326 @@ void RasterizerCanvasGLES3::_copy_texscreen(const Rect2 &p_rect) {
 	glEnable(GL_BLEND);
 }
 
+RasterizerStorageGLES3::Texture *RasterizerCanvasGLES3::_batch_get_texture(const RID &p_texture) const {
+
+	if (!p_texture.is_valid()) {
+		return NULL;
+	}
+
+	RasterizerStorageGLES3::Texture *texture = storage->texture_owner.getornull(p_texture);
+	return texture ? texture->get_ptr() : NULL;
+}
+
+bool RasterizerCanvasGLES3::_batch_reserve(const RID &p_texture, int p_vertices, int p_indices) {
+
+	if (p_vertices > batch.max_vertices || p_indices > batch.max_indices) {
+		return false;
+	}
+
+	if (batch.vertex_count && (batch.texture != p_texture || batch.vertex_count + p_vertices > batch.max_vertices || batch.index_count + p_indices > batch.max_indices)) {
+		_batch_flush();
+	}
+
+	batch.texture = p_texture;
+	return true;
+}
+
+void RasterizerCanvasGLES3::_batch_add_quad(const Transform2D &p_xform, const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color) {
+
+	int base = batch.vertex_count;
+	Vector2 *vertices = batch.vertices.ptrw() + base;
+	Vector2 *uvs = batch.uvs.ptrw() + base;
+	Color *colors = batch.colors.ptrw() + base;
+
+	for (int i = 0; i < 4; i++) {
+		vertices[i] = p_xform.xform(p_points[i]);
+		uvs[i] = p_uvs[i];
+		colors[i] = p_color;
+	}
+
+	int *indices = batch.indices.ptrw() + batch.index_count;
+	indices[0] = base;
+	indices[1] = base + 1;
+	indices[2] = base + 2;
+	indices[3] = base;
+	indices[4] = base + 2;
+	indices[5] = base + 3;
+
+	batch.vertex_count += 4;
+	batch.index_count += 6;
+}
+
+bool RasterizerCanvasGLES3::_canvas_item_is_batchable(Item *p_item) const {
+
+	if (p_item->copy_back_buffer || p_item->distance_field || p_item->skeleton.is_valid()) {
+		return false;
+	}
+
+	Item *material_owner = p_item->material_owner ? p_item->material_owner : p_item;
+	if (material_owner->material.is_valid()) {
+		return false;
+	}
+
+	int cc = p_item->commands.size();
+	Item::Command *const *commands = p_item->commands.ptr();
+
+	for (int i = 0; i < cc; i++) {
+
+		const Item::Command *c = commands[i];
+
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+				if (rect->flags & (CANVAS_RECT_TILE | CANVAS_RECT_CLIP_UV)) {
+					return false;
+				}
+			} break;
+			case Item::Command::TYPE_NINEPATCH: {
+
+				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
+				if (np->axis_x != VS::NINE_PATCH_STRETCH || np->axis_y != VS::NINE_PATCH_STRETCH || np->rect.size.width <= 0 || np->rect.size.height <= 0) {
+					return false;
+				}
+
+				RasterizerStorageGLES3::Texture *texture = _batch_get_texture(np->texture);
+				if (!texture) {
+					return false;
+				}
+
+				// Overlapping margins are resolved per pixel by the shader, keep those on the uniform path.
+				Size2 src_size = np->source != Rect2() ? np->source.size : Size2(texture->width, texture->height);
+				float s_ratio = MAX(1.0, MAX(src_size.width / np->rect.size.width, src_size.height / np->rect.size.height));
+				if (np->margin[MARGIN_LEFT] + np->margin[MARGIN_RIGHT] > MIN(src_size.width, np->rect.size.width * s_ratio) ||
+						np->margin[MARGIN_TOP] + np->margin[MARGIN_BOTTOM] > MIN(src_size.height, np->rect.size.height * s_ratio)) {
+					return false;
+				}
+			} break;
+			case Item::Command::TYPE_POLYGON: {
+
+				const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(c);
+				if (polygon->bones.size() || polygon->antialiased || polygon->points.size() > batch.max_vertices || polygon->count > batch.max_indices) {
+					return false;
+				}
+			} break;
+			case Item::Command::TYPE_TRANSFORM: {
+
+			} break;
+			default: {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void RasterizerCanvasGLES3::_batch_add_item(Item *p_item, const Color &p_modulate) {
+
+	Color modulate(p_item->final_modulate.r * p_modulate.r, p_item->final_modulate.g * p_modulate.g, p_item->final_modulate.b * p_modulate.b, p_item->final_modulate.a * p_modulate.a);
+
+	if (modulate.a <= 0.001 || p_item->light_masked) {
+		return;
+	}
+
+	if (batch.vertex_count) {
+		storage->info.render._2d_item_join_count++;
+	}
+
+	static const Vector2 corners[4] = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) };
+
+	Transform2D xform = p_item->final_transform;
+
+	int cc = p_item->commands.size();
+	Item::Command *const *commands = p_item->commands.ptr();
+
+	for (int i = 0; i < cc; i++) {
+
+		const Item::Command *c = commands[i];
+
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+				RasterizerStorageGLES3::Texture *texture = _batch_get_texture(rect->texture);
+
+				_batch_reserve(texture ? rect->texture : RID(), 4, 6);
+
+				Rect2 dst_rect = rect->rect;
+				if (dst_rect.size.width < 0) {
+					dst_rect.position.x += dst_rect.size.width;
+					dst_rect.size.width *= -1;
+				}
+				if (dst_rect.size.height < 0) {
+					dst_rect.position.y += dst_rect.size.height;
+					dst_rect.size.height *= -1;
+				}
+
+				Vector2 points[4];
+				Vector2 uvs[4];
+
+				if (texture) {
+
+					// Same mapping as the texture rect vertex shader: a negative source size (from a flip or
+					// from the region itself) mirrors the position, transpose swaps the uv.
+					Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+					Rect2 src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+					if (rect->flags & CANVAS_RECT_FLIP_H) {
+						src_rect.size.x *= -1;
+					}
+					if (rect->flags & CANVAS_RECT_FLIP_V) {
+						src_rect.size.y *= -1;
+					}
+					Size2 src_size = src_rect.size.abs();
+
+					for (int j = 0; j < 4; j++) {
+						Vector2 p = corners[j];
+						if (src_rect.size.x < 0) {
+							p.x = 1.0 - p.x;
+						}
+						if (src_rect.size.y < 0) {
+							p.y = 1.0 - p.y;
+						}
+						points[j] = dst_rect.position + dst_rect.size * p;
+						uvs[j] = src_rect.position + src_size * ((rect->flags & CANVAS_RECT_TRANSPOSE) ? Vector2(corners[j].y, corners[j].x) : corners[j]);
+					}
+				} else {
+
+					for (int j = 0; j < 4; j++) {
+						points[j] = dst_rect.position + dst_rect.size * corners[j];
+						uvs[j] = corners[j];
+					}
+				}
+
+				_batch_add_quad(xform, points, uvs, rect->modulate * modulate);
+			} break;
+			case Item::Command::TYPE_NINEPATCH: {
+
+				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
+				RasterizerStorageGLES3::Texture *texture = _batch_get_texture(np->texture);
+				ERR_CONTINUE(!texture);
+
+				Rect2 source = np->source != Rect2() ? np->source : Rect2(0, 0, texture->width, texture->height);
+				Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+				const Rect2 &dst_rect = np->rect;
+
+				// Corners keep their source size unless the destination is smaller than the source.
+				float s_ratio = MAX(1.0, MAX(source.size.width / dst_rect.size.width, source.size.height / dst_rect.size.height));
+
+				const float xs[4] = { 0, np->margin[MARGIN_LEFT] / s_ratio, dst_rect.size.width - np->margin[MARGIN_RIGHT] / s_ratio, dst_rect.size.width };
+				const float ys[4] = { 0, np->margin[MARGIN_TOP] / s_ratio, dst_rect.size.height - np->margin[MARGIN_BOTTOM] / s_ratio, dst_rect.size.height };
+				const float us[4] = { 0, np->margin[MARGIN_LEFT], source.size.width - np->margin[MARGIN_RIGHT], source.size.width };
+				const float vs[4] = { 0, np->margin[MARGIN_TOP], source.size.height - np->margin[MARGIN_BOTTOM], source.size.height };
+
+				Color color = np->color * modulate;
+
+				for (int y = 0; y < 3; y++) {
+					for (int x = 0; x < 3; x++) {
+
+						if ((x == 1 && y == 1 && !np->draw_center) || xs[x + 1] <= xs[x] || ys[y + 1] <= ys[y]) {
+							continue;
+						}
+
+						_batch_reserve(np->texture, 4, 6);
+
+						Vector2 points[4] = {
+							dst_rect.position + Vector2(xs[x], ys[y]),
+							dst_rect.position + Vector2(xs[x + 1], ys[y]),
+							dst_rect.position + Vector2(xs[x + 1], ys[y + 1]),
+							dst_rect.position + Vector2(xs[x], ys[y + 1]),
+						};
+						Vector2 uvs[4] = {
+							(source.position + Vector2(us[x], vs[y])) * texpixel_size,
+							(source.position + Vector2(us[x + 1], vs[y])) * texpixel_size,
+							(source.position + Vector2(us[x + 1], vs[y + 1])) * texpixel_size,
+							(source.position + Vector2(us[x], vs[y + 1])) * texpixel_size,
+						};
+
+						_batch_add_quad(xform, points, uvs, color);
+					}
+				}
+			} break;
+			case Item::Command::TYPE_POLYGON: {
+
+				const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(c);
+				RasterizerStorageGLES3::Texture *texture = _batch_get_texture(polygon->texture);
+
+				int point_count = polygon->points.size();
+				if (!point_count || !polygon->count) {
+					break;
+				}
+
+				if (!_batch_reserve(texture ? polygon->texture : RID(), point_count, polygon->count)) {
+					break;
+				}
+
+				int base = batch.vertex_count;
+				Vector2 *vertices = batch.vertices.ptrw() + base;
+				Vector2 *uvs = batch.uvs.ptrw() + base;
+				Color *colors = batch.colors.ptrw() + base;
+
+				const Vector2 *src_points = polygon->points.ptr();
+				const Vector2 *src_uvs = polygon->uvs.size() == point_count ? polygon->uvs.ptr() : NULL;
+				const Color *src_colors = polygon->colors.size() == point_count ? polygon->colors.ptr() : NULL;
+				Color single_color = polygon->colors.size() == 1 ? polygon->colors[0] * modulate : modulate;
+
+				for (int j = 0; j < point_count; j++) {
+					vertices[j] = xform.xform(src_points[j]);
+					uvs[j] = src_uvs ? src_uvs[j] : Vector2();
+					colors[j] = src_colors ? src_colors[j] * modulate : single_color;
+				}
+
+				int *indices = batch.indices.ptrw() + batch.index_count;
+				const int *src_indices = polygon->indices.ptr();
+				for (int j = 0; j < polygon->count; j++) {
+					indices[j] = base + src_indices[j];
+				}
+
+				batch.vertex_count += point_count;
+				batch.index_count += polygon->count;
+			} break;
+			case Item::Command::TYPE_TRANSFORM: {
+
+				const Item::CommandTransform *transform = static_cast<const Item::CommandTransform *>(c);
+				xform = p_item->final_transform * transform->xform;
+			} break;
+			default: {
+			}
+		}
+	}
+}
+
+void RasterizerCanvasGLES3::_batch_flush() {
+
+	if (!batch.index_count) {
+		batch.vertex_count = 0;
+		return;
+	}
+
+	// Vertices are already in canvas space.
+	state.canvas_item_modulate = Color(1, 1, 1, 1);
+	state.final_transform = Transform2D();
+	state.extra_matrix = Transform2D();
+
+	_set_texture_rect_mode(false);
+
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::FINAL_MODULATE, state.canvas_item_modulate);
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, state.final_transform);
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::EXTRA_MATRIX, state.extra_matrix);
+
+	RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(batch.texture, RID());
+	if (texture) {
+		Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+		state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+	}
+
+	_draw_polygon(batch.indices.ptr(), batch.index_count, batch.vertex_count, batch.vertices.ptr(), batch.uvs.ptr(), batch.colors.ptr(), false, NULL, NULL);
+	storage->info.render._2d_batch_count++;
+
+	batch.vertex_count = 0;
+	batch.index_count = 0;
+}
+
 void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform) {
 
 	Item *current_clip = NULL;
@@ -1438,11 +1759,27 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 	bool prev_distance_field = false;
 	bool prev_use_skeleton = false;
 
+	// Whether the GL state left by the previous item is the one batches are drawn with.
+	bool batch_state_ready = false;
+
 	while (p_item_list) {
 
 		Item *ci = p_item_list;
 		storage->info.render._2d_item_count++;
 
+		bool batchable = batch.use_batching && !p_light && _canvas_item_is_batchable(ci);
+
+		if (!batchable || current_clip != ci->final_clip_owner) {
+			_batch_flush();
+			batch_state_ready = false;
+		}
+
+		if (batchable && batch_state_ready) {
+			_batch_add_item(ci, p_modulate);
+			p_item_list = p_item_list->next;
+			continue;
+		}
+
 		if (prev_distance_field != ci->distance_field) {
 
 			state.canvas_shader.set_conditional(CanvasShaderGLES3::USE_DISTANCE_FIELD, ci->distance_field);
@@ -1704,6 +2041,13 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 		} else {
 			state.canvas_shader.set_uniform(CanvasShaderGLES3::SCREEN_PIXEL_SIZE, Vector2(1.0, 1.0));
 		}
+		if (batchable) {
+			_batch_add_item(ci, p_modulate);
+			batch_state_ready = true;
+			p_item_list = p_item_list->next;
+			continue;
+		}
+
 		if (unshaded || (state.canvas_item_modulate.a > 0.001 && (!shader_cache || shader_cache->canvas_item.light_mode != RasterizerStorageGLES3::Shader::CanvasItem::LIGHT_MODE_LIGHT_ONLY) && !ci->light_masked))
 			_canvas_item_render_commands(ci, current_clip, reclip);
 
@@ -1863,6 +2207,8 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 		p_item_list = p_item_list->next;
 	}
 
+	_batch_flush();
+
 	if (current_clip) {
 		glDisable(GL_SCISSOR_TEST);
 	}
@@ -2329,6 +2675,25 @@ void RasterizerCanvasGLES3::initialize() {
 	state.canvas_shadow_shader.set_conditional(CanvasShadowShaderGLES3::USE_RGBA_SHADOWS, storage->config.use_rgba_2d_shadows);
 
 	state.canvas_shader.set_conditional(CanvasShaderGLES3::USE_PIXEL_SNAP, GLOBAL_DEF("rendering/quality/2d/use_pixel_snap", false));
+
+	// batches share the polygon buffers, each vertex stores a position, an uv and a color
+	batch.max_vertices = data.polygon_buffer_size / (sizeof(Vector2) * 2 + sizeof(Color));
+	batch.max_indices = data.polygon_index_buffer_size / sizeof(int);
+	batch.vertices.resize(batch.max_vertices);
+	batch.uvs.resize(batch.max_vertices);
+	batch.colors.resize(batch.max_vertices);
+	batch.indices.resize(batch.max_indices);
+	batch.vertex_count = 0;
+	batch.index_count = 0;
+
+	batch.use_batching = GLOBAL_GET("rendering/batching/options/use_batching");
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Disabling batching in the project disables it in the editor too.
+		batch.use_batching = batch.use_batching && bool(GLOBAL_GET("rendering/batching/options/use_batching_in_editor"));
+	}
+	if (batch.max_vertices < 4 || batch.max_indices < 6) {
+		batch.use_batching = false;
+	}
 }
 
 void RasterizerCanvasGLES3::finalize() {
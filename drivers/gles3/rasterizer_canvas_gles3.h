@@ -97,6 +97,26 @@ public:
 	RasterizerStorageGLES3 *storage;
 	bool use_nvidia_rect_workaround;
 
+	// CPU side vertex accumulator. Rects, ninepatches and polygons of consecutive
+	// items drawn with the default shader and no lights are transformed to canvas
+	// space and drawn together, until the texture or the GL state changes.
+	struct Batch {
+
+		Vector<Vector2> vertices;
+		Vector<Vector2> uvs;
+		Vector<Color> colors;
+		Vector<int> indices;
+
+		int vertex_count;
+		int index_count;
+		int max_vertices;
+		int max_indices;
+
+		RID texture;
+		bool use_batching;
+
+	} batch;
+
 	struct LightInternal : public RID_Data {
 
 		struct UBOData {
@@ -138,6 +158,13 @@ public:
 	_FORCE_INLINE_ void _canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip);
 	_FORCE_INLINE_ void _copy_texscreen(const Rect2 &p_rect);
 
+	_FORCE_INLINE_ RasterizerStorageGLES3::Texture *_batch_get_texture(const RID &p_texture) const;
+	_FORCE_INLINE_ bool _batch_reserve(const RID &p_texture, int p_vertices, int p_indices);
+	_FORCE_INLINE_ void _batch_add_quad(const Transform2D &p_xform, const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color);
+	bool _canvas_item_is_batchable(Item *p_item) const;
+	void _batch_add_item(Item *p_item, const Color &p_modulate);
+	void _batch_flush();
+
 	virtual void canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform);
 	virtual void canvas_debug_viewport_shadows(Light *p_lights_with_shadow);
 
@@ -3702,7 +3702,7 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 
 			glGenBuffers(1, &surface->index_id);
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surface->index_id);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_array_size, ir.ptr(), GL_STATIC_DRAW);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_array_size, ir.ptr(), (p_format & VS::ARRAY_FLAG_USE_DYNAMIC_UPDATE) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
 		}
 
@@ -3948,6 +3948,25 @@ void RasterizerStorageGLES3::mesh_surface_update_region(RID p_mesh, int p_surfac
 	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 }
 
+void RasterizerStorageGLES3::mesh_surface_update_index_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(!mesh->surfaces[p_surface]->index_id);
+
+	int total_size = p_data.size();
+	ERR_FAIL_COND(p_offset + total_size > mesh->surfaces[p_surface]->index_array_byte_size);
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+
+	// Don't touch the index binding of whatever vertex array happens to be bound.
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->surfaces[p_surface]->index_id);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, p_offset, total_size, r.ptr());
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); //unbind
+}
+
 void RasterizerStorageGLES3::mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -5357,6 +5376,36 @@ Transform RasterizerStorageGLES3::skeleton_bone_get_transform(RID p_skeleton, in
 
 	return ret;
 }
+
+void RasterizerStorageGLES3::skeleton_set_as_bulk_array(RID p_skeleton, const PoolVector<float> &p_array) {
+
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(skeleton->use_2d);
+	ERR_FAIL_COND(p_array.size() != skeleton->size * 4 * 3);
+
+	PoolVector<float>::Read r = p_array.read();
+	const float *src = r.ptr();
+	float *texture = skeleton->skel_texture.ptrw();
+
+	// Each bone is three rows of basis + origin, laid out in blocks of 256 texels per row.
+	for (int i = 0; i < skeleton->size; i++) {
+
+		int base_ofs = ((i / 256) * 256) * 3 * 4 + (i % 256) * 4;
+
+		copymem(&texture[base_ofs], &src[i * 12 + 0], sizeof(float) * 4);
+		base_ofs += 256 * 4;
+		copymem(&texture[base_ofs], &src[i * 12 + 4], sizeof(float) * 4);
+		base_ofs += 256 * 4;
+		copymem(&texture[base_ofs], &src[i * 12 + 8], sizeof(float) * 4);
+	}
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 void RasterizerStorageGLES3::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
 
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
@@ -8144,6 +8193,8 @@ void RasterizerStorageGLES3::render_info_end_capture() {
 	info.snap.vertices_count = info.render.vertices_count - info.snap.vertices_count;
 	info.snap._2d_item_count = info.render._2d_item_count - info.snap._2d_item_count;
 	info.snap._2d_draw_call_count = info.render._2d_draw_call_count - info.snap._2d_draw_call_count;
+	info.snap._2d_batch_count = info.render._2d_batch_count - info.snap._2d_batch_count;
+	info.snap._2d_item_join_count = info.render._2d_item_join_count - info.snap._2d_item_join_count;
 }
 
 int RasterizerStorageGLES3::get_captured_render_info(VS::RenderInfo p_info) {
@@ -8175,6 +8226,12 @@ int RasterizerStorageGLES3::get_captured_render_info(VS::RenderInfo p_info) {
 		case VS::INFO_2D_DRAW_CALLS_IN_FRAME: {
 			return info.snap._2d_draw_call_count;
 		} break;
+		case VS::INFO_2D_BATCHES_IN_FRAME: {
+			return info.snap._2d_batch_count;
+		} break;
+		case VS::INFO_2D_ITEMS_JOINED_IN_FRAME: {
+			return info.snap._2d_item_join_count;
+		} break;
 		default: {
 			return get_render_info(p_info);
 		}
@@ -8200,6 +8257,10 @@ int RasterizerStorageGLES3::get_render_info(VS::RenderInfo p_info) {
 			return info.render_final._2d_item_count;
 		case VS::INFO_2D_DRAW_CALLS_IN_FRAME:
 			return info.render_final._2d_draw_call_count;
+		case VS::INFO_2D_BATCHES_IN_FRAME:
+			return info.render_final._2d_batch_count;
+		case VS::INFO_2D_ITEMS_JOINED_IN_FRAME:
+			return info.render_final._2d_item_join_count;
 		case VS::INFO_USAGE_VIDEO_MEM_TOTAL:
 			return 0; //no idea
 		case VS::INFO_VIDEO_MEM_USED:
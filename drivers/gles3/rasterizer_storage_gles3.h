@@ -156,6 +156,8 @@ public:
 			uint32_t vertices_count;
 			uint32_t _2d_item_count;
 			uint32_t _2d_draw_call_count;
+			uint32_t _2d_batch_count;
+			uint32_t _2d_item_join_count;
 
 			void reset() {
 				object_count = 0;
@@ -166,6 +168,8 @@ public:
 				vertices_count = 0;
 				_2d_item_count = 0;
 				_2d_draw_call_count = 0;
+				_2d_batch_count = 0;
+				_2d_item_join_count = 0;
 			}
 		} render, render_final, snap;
 
@@ -745,6 +749,7 @@ public:
 	virtual VS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const;
 
 	virtual void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data);
+	virtual void mesh_surface_update_index_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data);
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material);
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const;
@@ -923,6 +928,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
+	virtual void skeleton_set_as_bulk_array(RID p_skeleton, const PoolVector<float> &p_array);
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform);
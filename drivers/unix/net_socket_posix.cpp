@@ -159,6 +159,8 @@ void NetSocketPosix::make_default() {
 		WSADATA data;
 		WSAStartup(MAKEWORD(2, 2), &data);
 	}
+#else
+	NetSocketPollerPosix::make_default();
 #endif
 	_create = _create_func;
 }
@@ -616,6 +618,93 @@ Error NetSocketPosix::sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP
 	return OK;
 }
 
+#if defined(__linux__)
+// Upper bound for one recvmmsg/sendmmsg call, keeps the headers on the stack.
+#define DATAGRAM_BATCH_MAX 64
+
+Error NetSocketPosix::recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_count) {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_count = 0;
+	int count = MIN(p_count, DATAGRAM_BATCH_MAX);
+	if (count <= 0)
+		return OK;
+
+	struct mmsghdr msgs[DATAGRAM_BATCH_MAX];
+	struct iovec iovs[DATAGRAM_BATCH_MAX];
+	struct sockaddr_storage addrs[DATAGRAM_BATCH_MAX];
+	memset(msgs, 0, sizeof(struct mmsghdr) * count);
+
+	for (int i = 0; i < count; i++) {
+		iovs[i].iov_base = r_datagrams[i].buffer;
+		iovs[i].iov_len = r_datagrams[i].size;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	// Like recvfrom(), only a blocking socket waits, and then just for the first one.
+	int ret = ::recvmmsg(_sock, msgs, count, MSG_WAITFORONE, NULL);
+
+	if (ret < 0) {
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK)
+			return ERR_BUSY;
+
+		return FAILED;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		r_datagrams[i].size = msgs[i].msg_len;
+		_set_ip_port(&addrs[i], r_datagrams[i].ip, r_datagrams[i].port);
+	}
+	r_count = ret;
+
+	return OK;
+}
+
+Error NetSocketPosix::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count) {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_count = 0;
+	int count = MIN(p_count, DATAGRAM_BATCH_MAX);
+	if (count <= 0)
+		return OK;
+
+	struct mmsghdr msgs[DATAGRAM_BATCH_MAX];
+	struct iovec iovs[DATAGRAM_BATCH_MAX];
+	struct sockaddr_storage addrs[DATAGRAM_BATCH_MAX];
+	memset(msgs, 0, sizeof(struct mmsghdr) * count);
+
+	for (int i = 0; i < count; i++) {
+		const Datagram &d = p_datagrams[i];
+		iovs[i].iov_base = d.buffer;
+		iovs[i].iov_len = d.size;
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		if (d.ip.is_valid()) {
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = _set_addr_storage(&addrs[i], d.ip, d.port, _ip_type);
+		}
+	}
+
+	int ret = ::sendmmsg(_sock, msgs, count, 0);
+
+	if (ret < 0) {
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK)
+			return ERR_BUSY;
+
+		return FAILED;
+	}
+
+	r_count = ret;
+
+	return OK;
+}
+#endif
+
 Error NetSocketPosix::set_broadcasting_enabled(bool p_enabled) {
 	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 	// IPv6 has no broadcast support.
@@ -743,4 +832,193 @@ Error NetSocketPosix::join_multicast_group(const IP_Address &p_multi_address, St
 Error NetSocketPosix::leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) {
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+#if !defined(WINDOWS_ENABLED)
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+	return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+	_create = _create_func;
+}
+
+#if defined(__linux__)
+static uint32_t _get_poll_events(NetSocket::PollType p_type) {
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return EPOLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return EPOLLOUT;
+		default:
+			return EPOLLIN | EPOLLOUT;
+	}
+}
+#else
+static short _get_poll_events(NetSocket::PollType p_type) {
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return POLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return POLLOUT;
+		default:
+			return POLLIN | POLLOUT;
+	}
+}
+#endif
+
+Error NetSocketPollerPosix::add(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata) {
+
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+	uint64_t key = (uint64_t)(uintptr_t)p_socket.ptr();
+	ERR_FAIL_COND_V(sockets.has(key), ERR_ALREADY_EXISTS);
+
+	Entry entry;
+	entry.fd = static_cast<const NetSocketPosix *>(p_socket.ptr())->_sock;
+	entry.userdata = p_userdata;
+	entry.index = -1;
+
+#if defined(__linux__)
+	ERR_FAIL_COND_V(epfd == -1, ERR_UNCONFIGURED);
+	struct epoll_event ev;
+	ev.events = _get_poll_events(p_type);
+	ev.data.ptr = p_userdata;
+	if (epoll_ctl(epfd, EPOLL_CTL_ADD, entry.fd, &ev) != 0) {
+		ERR_PRINTS("Unable to add socket to epoll set, errno: " + itos(errno));
+		return FAILED;
+	}
+#else
+	struct pollfd pfd;
+	pfd.fd = entry.fd;
+	pfd.events = _get_poll_events(p_type);
+	pfd.revents = 0;
+	entry.index = fds.size();
+	fds.push_back(pfd);
+	userdata.push_back(p_userdata);
+	keys.push_back(key);
+#endif
+
+	sockets[key] = entry;
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type) {
+
+	ERR_FAIL_COND_V(p_socket.is_null(), ERR_INVALID_PARAMETER);
+	Entry *entry = sockets.getptr((uint64_t)(uintptr_t)p_socket.ptr());
+	ERR_FAIL_COND_V(!entry, ERR_DOES_NOT_EXIST);
+
+#if defined(__linux__)
+	struct epoll_event ev;
+	ev.events = _get_poll_events(p_type);
+	ev.data.ptr = entry->userdata;
+	if (epoll_ctl(epfd, EPOLL_CTL_MOD, entry->fd, &ev) != 0) {
+		ERR_PRINTS("Unable to modify socket in epoll set, errno: " + itos(errno));
+		return FAILED;
+	}
+#else
+	fds.write[entry->index].events = _get_poll_events(p_type);
+#endif
+	return OK;
+}
+
+void NetSocketPollerPosix::remove(const Ref<NetSocket> &p_socket) {
+
+	ERR_FAIL_COND(p_socket.is_null());
+	uint64_t key = (uint64_t)(uintptr_t)p_socket.ptr();
+	Entry *entry = sockets.getptr(key);
+	if (!entry)
+		return;
+
+#if defined(__linux__)
+	// Closed descriptors already left the set, ignore the error then.
+	struct epoll_event ev;
+	epoll_ctl(epfd, EPOLL_CTL_DEL, entry->fd, &ev);
+#else
+	// Swap with the last one so the arrays stay packed.
+	int last = fds.size() - 1;
+	if (entry->index != last) {
+		fds.write[entry->index] = fds[last];
+		userdata.write[entry->index] = userdata[last];
+		keys.write[entry->index] = keys[last];
+		sockets[keys[last]].index = entry->index;
+	}
+	fds.resize(last);
+	userdata.resize(last);
+	keys.resize(last);
+#endif
+
+	sockets.erase(key);
+}
+
+int NetSocketPollerPosix::get_socket_count() const {
+	return sockets.size();
+}
+
+int NetSocketPollerPosix::wait(Event *r_events, int p_max_events, int p_timeout) {
+
+	ERR_FAIL_COND_V(!r_events || p_max_events <= 0, -1);
+
+#if defined(__linux__)
+	ERR_FAIL_COND_V(epfd == -1, -1);
+	if (events.size() < p_max_events) {
+		events.resize(p_max_events);
+	}
+
+	int ret = epoll_wait(epfd, events.ptrw(), p_max_events, p_timeout);
+	if (ret < 0) {
+		return errno == EINTR ? 0 : -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		const struct epoll_event &ev = events[i];
+		r_events[i].userdata = ev.data.ptr;
+		r_events[i].readable = ev.events & EPOLLIN;
+		r_events[i].writable = ev.events & EPOLLOUT;
+		r_events[i].error = ev.events & (EPOLLERR | EPOLLHUP);
+	}
+	return ret;
+#else
+	if (fds.empty()) {
+		return 0;
+	}
+
+	int ret = ::poll(fds.ptrw(), fds.size(), p_timeout);
+	if (ret < 0) {
+		return errno == EINTR ? 0 : -1;
+	}
+
+	int count = 0;
+	for (int i = 0; i < fds.size() && count < ret && count < p_max_events; i++) {
+		short revents = fds[i].revents;
+		if (!revents)
+			continue;
+		r_events[count].userdata = userdata[i];
+		r_events[count].readable = revents & POLLIN;
+		r_events[count].writable = revents & POLLOUT;
+		r_events[count].error = revents & (POLLERR | POLLHUP | POLLNVAL);
+		count++;
+	}
+	return count;
+#endif
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+#if defined(__linux__)
+	epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (epfd == -1) {
+		ERR_PRINTS("Unable to create epoll instance, errno: " + itos(errno));
+	}
+#endif
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+#if defined(__linux__)
+	if (epfd != -1) {
+		::close(epfd);
+	}
+#endif
+}
+#endif
+
 #endif
@@ -31,6 +31,7 @@
 #ifndef NET_SOCKET_UNIX_H
 #define NET_SOCKET_UNIX_H
 
+#include "core/hash_map.h"
 #include "core/io/net_socket.h"
 
 #if defined(WINDOWS_ENABLED)
@@ -39,9 +40,14 @@
 #define SOCKET_TYPE SOCKET
 
 #else
+#include <poll.h>
 #include <sys/socket.h>
 #define SOCKET_TYPE int
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
 #endif
 
 class NetSocketPosix : public NetSocket {
@@ -85,6 +91,10 @@ public:
 	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent);
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port);
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port);
+#if defined(__linux__)
+	virtual Error recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_count);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count);
+#endif
 
 	virtual bool is_open() const;
 	virtual int get_available_bytes() const;
@@ -100,6 +110,47 @@ public:
 
 	NetSocketPosix();
 	~NetSocketPosix();
+
+	friend class NetSocketPollerPosix;
 };
 
+#if !defined(WINDOWS_ENABLED)
+
+// Uses epoll on Linux, a single poll() over every socket elsewhere.
+class NetSocketPollerPosix : public NetSocketPoller {
+
+	struct Entry {
+		SOCKET_TYPE fd;
+		void *userdata;
+		int index; // In fds, when poll() is used.
+	};
+
+	HashMap<uint64_t, Entry> sockets;
+
+#if defined(__linux__)
+	int epfd;
+	Vector<struct epoll_event> events;
+#else
+	Vector<struct pollfd> fds;
+	Vector<void *> userdata;
+	Vector<uint64_t> keys;
+#endif
+
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+
+	virtual Error add(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata);
+	virtual Error modify(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type);
+	virtual void remove(const Ref<NetSocket> &p_socket);
+	virtual int get_socket_count() const;
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout);
+
+	NetSocketPollerPosix();
+	~NetSocketPollerPosix();
+};
+
+#endif
+
 #endif
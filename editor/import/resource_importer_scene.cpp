@@ -196,6 +196,9 @@ bool ResourceImporterScene::get_option_visibility(const String &p_option, const
 		if (p_option.begins_with("animation/optimizer/") && p_option != "animation/optimizer/enabled" && !bool(p_options["animation/optimizer/enabled"]))
 			return false;
 
+		if (p_option.begins_with("animation/compression/") && p_option != "animation/compression/enabled" && !bool(p_options["animation/compression/enabled"]))
+			return false;
+
 		if (p_option.begins_with("animation/clip_")) {
 			int max_clip = p_options["animation/clips/amount"];
 			int clip = p_option.get_slice("/", 1).get_slice("_", 1).to_int() - 1;
@@ -913,6 +916,24 @@ void ResourceImporterScene::_optimize_animations(Node *scene, float p_max_lin_er
 	}
 }
 
+void ResourceImporterScene::_compress_animations(Node *scene, float p_max_lin_error, float p_max_ang_error) {
+
+	if (!scene->has_node(String("AnimationPlayer")))
+		return;
+	Node *n = scene->get_node(String("AnimationPlayer"));
+	ERR_FAIL_COND(!n);
+	AnimationPlayer *anim = Object::cast_to<AnimationPlayer>(n);
+	ERR_FAIL_COND(!anim);
+
+	List<StringName> anim_names;
+	anim->get_animation_list(&anim_names);
+	for (List<StringName>::Element *E = anim_names.front(); E; E = E->next()) {
+
+		Ref<Animation> a = anim->get_animation(E->get());
+		a->compress(p_max_lin_error, p_max_ang_error);
+	}
+}
+
 static String _make_extname(const String &p_str) {
 
 	String ext_name = p_str.replace(".", "_");
@@ -1187,6 +1208,9 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/optimizer/max_angular_error"), 0.01));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/optimizer/max_angle"), 22));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/optimizer/remove_unused_tracks"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/compression/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), false));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/compression/max_linear_error"), 0.001));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/compression/max_angular_error"), 0.001));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "animation/clips/amount", PROPERTY_HINT_RANGE, "0,256,1", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	for (int i = 0; i < 256; i++) {
 		r_options->push_back(ImportOption(PropertyInfo(Variant::STRING, "animation/clip_" + itos(i + 1) + "/name"), ""));
@@ -1416,6 +1440,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		_filter_tracks(scene, animation_filter);
 	}
 
+	if (bool(p_options["animation/compression/enabled"])) {
+		_compress_animations(scene, p_options["animation/compression/max_linear_error"], p_options["animation/compression/max_angular_error"]);
+	}
+
 	bool external_animations = int(p_options["animation/storage"]) == 1 || int(p_options["animation/storage"]) == 2;
 	bool external_animations_as_text = int(p_options["animation/storage"]) == 2;
 	bool keep_custom_tracks = p_options["animation/keep_custom_tracks"];
@@ -0,0 +1,272 @@
+/*************************************************************************/
+/*  test_animation.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_animation.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "scene/resources/animation.h"
+
+namespace TestAnimation {
+
+static const int BONE_COUNT = 64;
+static const float FPS = 30.0;
+static const float LENGTH = 60.0;
+static const float LINEAR_ERROR = 0.001;
+static const float ANGULAR_ERROR = 0.001;
+// Quantization counts against the error budget, so only float rounding is allowed
+// on top of it. The rotation error goes through acos() near 1, which single
+// precision only resolves to about 1e-3 rad.
+static const float LINEAR_TOLERANCE = LINEAR_ERROR + 1e-5;
+static const float ANGULAR_TOLERANCE = 0.002;
+
+// Builds a mocap-like animation: a key on every frame of every bone, following
+// smooth curves with occasional sharp changes.
+static Ref<Animation> _make_animation() {
+
+	Ref<Animation> anim;
+	anim.instance();
+	anim->set_length(LENGTH);
+
+	int frames = LENGTH * FPS;
+
+	for (int i = 0; i < BONE_COUNT; i++) {
+
+		int track = anim->add_track(Animation::TYPE_TRANSFORM);
+		anim->track_set_path(track, "Skeleton:bone_" + itos(i));
+
+		for (int j = 0; j <= frames; j++) {
+
+			float t = j / FPS;
+			float phase = i * 0.37;
+			Vector3 loc(Math::sin(t + phase), Math::cos(t * 0.5 + phase) * 0.5, (j / 90) % 2 ? 0.25 : 0.0);
+			Quat rot(Vector3(0, 1, 0).rotated(Vector3(1, 0, 0), Math::sin(t * 0.3 + phase)).normalized(), Math::sin(t * 1.7 + phase) * Math_PI);
+			Vector3 scale(1, 1, 1);
+
+			anim->transform_track_insert_key(track, t, loc, rot, scale);
+		}
+	}
+
+	return anim;
+}
+
+static bool _compare(const Ref<Animation> &p_a, const Ref<Animation> &p_b, float p_linear_tolerance, float p_angular_tolerance) {
+
+	float max_loc = 0;
+	float max_angle = 0;
+
+	for (int i = 0; i < p_a->get_track_count(); i++) {
+		for (float t = 0; t < LENGTH; t += 0.0137) {
+
+			Vector3 loc_a, loc_b, scale_a, scale_b;
+			Quat rot_a, rot_b;
+			p_a->transform_track_interpolate(i, t, &loc_a, &rot_a, &scale_a);
+			p_b->transform_track_interpolate(i, t, &loc_b, &rot_b, &scale_b);
+
+			max_loc = MAX(max_loc, loc_a.distance_to(loc_b));
+			max_loc = MAX(max_loc, scale_a.distance_to(scale_b));
+			float d = Math::abs(rot_a.normalized().dot(rot_b.normalized()));
+			max_angle = MAX(max_angle, 2.0f * Math::acos(MIN(d, 1.0f)));
+		}
+	}
+
+	OS::get_singleton()->print("\tmax location/scale error: %f, max rotation error: %f rad\n", max_loc, max_angle);
+
+	return max_loc <= p_linear_tolerance && max_angle <= p_angular_tolerance;
+}
+
+static uint64_t _sample(const Ref<Animation> &p_anim, bool p_cursor) {
+
+	Vector<int> cursors;
+	cursors.resize(p_anim->get_track_count());
+	for (int i = 0; i < cursors.size(); i++) {
+		cursors.write[i] = 0;
+	}
+
+	Vector3 loc, scale;
+	Quat rot;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	// Sequential playback, as an AnimationTree would do it.
+	for (float t = 0; t < LENGTH; t += 1.0 / 60.0) {
+		for (int i = 0; i < p_anim->get_track_count(); i++) {
+			p_anim->transform_track_interpolate(i, t, &loc, &rot, &scale, p_cursor ? &cursors.write[i] : NULL);
+		}
+	}
+
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+bool test_compress_error() {
+
+	OS::get_singleton()->print("\n\nTest 1: Compressed samples stay within the error bounds\n");
+
+	Ref<Animation> source = _make_animation();
+	Ref<Animation> compressed = source->duplicate();
+	compressed->compress(LINEAR_ERROR, ANGULAR_ERROR);
+
+	for (int i = 0; i < compressed->get_track_count(); i++) {
+		if (!compressed->track_is_compressed(i)) {
+			OS::get_singleton()->print("\tTrack %i was not compressed\n", i);
+			return false;
+		}
+	}
+
+	return _compare(source, compressed, LINEAR_TOLERANCE, ANGULAR_TOLERANCE);
+}
+
+bool test_compress_keys() {
+
+	OS::get_singleton()->print("\n\nTest 2: Compressed keys can be read and edited\n");
+
+	Ref<Animation> anim = _make_animation();
+	anim->compress(LINEAR_ERROR, ANGULAR_ERROR);
+	int key_count = anim->track_get_key_count(0);
+
+	float time = anim->track_get_key_time(0, 10);
+	if (anim->track_find_key(0, time, true) != 10) {
+		OS::get_singleton()->print("\tCould not find compressed key by time\n");
+		return false;
+	}
+
+	anim->transform_track_insert_key(0, 0.5 / FPS, Vector3(), Quat(), Vector3(1, 1, 1));
+
+	if (anim->track_is_compressed(0) || anim->track_get_key_count(0) != key_count + 1) {
+		OS::get_singleton()->print("\tInserting a key did not decompress the track\n");
+		return false;
+	}
+
+	return true;
+}
+
+bool test_compress_serialize() {
+
+	OS::get_singleton()->print("\n\nTest 3: Compressed tracks survive a property round trip\n");
+
+	Ref<Animation> compressed = _make_animation();
+	compressed->compress(LINEAR_ERROR, ANGULAR_ERROR);
+
+	Ref<Animation> copy = compressed->duplicate(); // goes through _get and _set
+
+	for (int i = 0; i < copy->get_track_count(); i++) {
+		if (!copy->track_is_compressed(i)) {
+			OS::get_singleton()->print("\tTrack %i lost its compression\n", i);
+			return false;
+		}
+	}
+
+	return _compare(compressed, copy, CMP_EPSILON, CMP_EPSILON);
+}
+
+bool test_compress_malformed() {
+
+	OS::get_singleton()->print("\n\nTest 4: Malformed compressed keys are rejected\n");
+
+	Ref<Animation> anim = _make_animation();
+	anim->compress(LINEAR_ERROR, ANGULAR_ERROR);
+	int key_count = anim->track_get_key_count(0);
+
+	// With 32-bit size math, this key count wraps around to exactly the four
+	// bytes of the header.
+	PoolVector<uint8_t> data;
+	data.resize(4);
+	{
+		PoolVector<uint8_t>::Write w = data.write();
+		encode_uint32(1065418242, w.ptr());
+	}
+	anim->set("tracks/0/compressed_keys", data);
+
+	if (!anim->track_is_compressed(0) || anim->track_get_key_count(0) != key_count) {
+		OS::get_singleton()->print("\tTrack was changed by a malformed key array\n");
+		return false;
+	}
+
+	return true;
+}
+
+bool test_compress_benchmark() {
+
+	OS::get_singleton()->print("\n\nTest 5: Memory and sampling cost\n");
+
+	Ref<Animation> source = _make_animation();
+	Ref<Animation> compressed = source->duplicate();
+	compressed->compress(LINEAR_ERROR, ANGULAR_ERROR);
+
+	int keys_before = 0;
+	int keys_after = 0;
+	for (int i = 0; i < source->get_track_count(); i++) {
+		keys_before += source->track_get_key_count(i);
+		keys_after += compressed->track_get_key_count(i);
+	}
+
+	int memory_before = source->get_transform_track_memory_usage();
+	int memory_after = compressed->get_transform_track_memory_usage();
+
+	OS::get_singleton()->print("\tkeys: %i -> %i\n", keys_before, keys_after);
+	OS::get_singleton()->print("\tmemory: %i -> %i bytes (%.1f%%)\n", memory_before, memory_after, memory_after * 100.0 / memory_before);
+	OS::get_singleton()->print("\tsampling, binary search: %i -> %i usec\n", int(_sample(source, false)), int(_sample(compressed, false)));
+	OS::get_singleton()->print("\tsampling, key cursors: %i -> %i usec\n", int(_sample(source, true)), int(_sample(compressed, true)));
+
+	return memory_after < memory_before;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_compress_error,
+	test_compress_keys,
+	test_compress_serialize,
+	test_compress_malformed,
+	test_compress_benchmark,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+
+} // namespace TestAnimation
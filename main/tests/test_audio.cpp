@@ -0,0 +1,725 @@
+/*************************************************************************/
+/*  test_audio.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_audio.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "scene/resources/audio_stream_sample.h"
+#include "servers/audio/audio_mix.h"
+#include "servers/audio/audio_rb_resampler.h"
+#include "servers/audio/effects/audio_effect_reverb.h"
+#include "servers/audio_server.h"
+
+namespace TestAudio {
+
+static const int FRAMES = 1024;
+static const int VOICES = 256;
+static const int BUSES = 8;
+static const int STEPS = 50;
+
+// Runs mix steps on the calling thread, the way AudioDriverDummy does from
+// its own, so the whole server can be timed without a sound card.
+class BenchmarkDriver : public AudioDriver {
+public:
+	const char *get_name() const { return "Benchmark"; }
+
+	virtual Error init() { return OK; }
+	virtual void start() {}
+	virtual int get_mix_rate() const { return 44100; }
+	virtual SpeakerMode get_speaker_mode() const { return SPEAKER_MODE_STEREO; }
+	virtual void lock() {}
+	virtual void unlock() {}
+	virtual void finish() {}
+
+	void mix(int32_t *p_buffer, int p_frames) {
+		audio_server_process(p_frames, p_buffer, false);
+	}
+};
+
+static void fill_noise(AudioFrame *p_buffer, int p_frames, float p_range) {
+
+	for (int i = 0; i < p_frames; i++) {
+		p_buffer[i] = AudioFrame(Math::random(-p_range, p_range), Math::random(-p_range, p_range));
+	}
+}
+
+static float max_difference(const AudioFrame *p_a, const AudioFrame *p_b, int p_frames) {
+
+	float diff = 0;
+	for (int i = 0; i < p_frames; i++) {
+		diff = MAX(diff, MAX(ABS(p_a[i].l - p_b[i].l), ABS(p_a[i].r - p_b[i].r)));
+	}
+	return diff;
+}
+
+// Loops the mixer used before AudioMix.
+static void add_ramp_scalar(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, AudioFrame p_volume, const AudioFrame &p_volume_inc) {
+
+	for (int i = 0; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * p_volume;
+		p_volume += p_volume_inc;
+	}
+}
+
+static void to_int32_scalar(int32_t *p_dst, int p_stride, const AudioFrame *p_src, int p_frames) {
+
+	for (int i = 0; i < p_frames; i++) {
+		float l = CLAMP(p_src[i].l, -1.0, 1.0);
+		int32_t vl = l * ((1 << 20) - 1);
+		p_dst[i * p_stride + 0] = (vl < 0 ? -1 : 1) * (ABS(vl) << 11);
+		float r = CLAMP(p_src[i].r, -1.0, 1.0);
+		int32_t vr = r * ((1 << 20) - 1);
+		p_dst[i * p_stride + 1] = (vr < 0 ? -1 : 1) * (ABS(vr) << 11);
+	}
+}
+
+bool test_kernels() {
+
+	OS::get_singleton()->print("\n\nTest 1: Mix kernels match the scalar loops\n");
+
+	// Odd size, so the frames left after the vector loops are covered.
+	const int frames = 1023;
+	Vector<AudioFrame> src, a, b;
+	src.resize(frames);
+	a.resize(frames);
+	b.resize(frames);
+	fill_noise(src.ptrw(), frames, 2.0);
+	fill_noise(a.ptrw(), frames, 0.5);
+	b = a;
+	b.ptrw(); // Unshare
+
+	AudioFrame vol(0.5, 0.25);
+	AudioFrame vol_inc(0.0005, -0.0002);
+	add_ramp_scalar(a.ptrw(), src.ptr(), frames, vol, vol_inc);
+	AudioMix::add_ramp(b.ptrw(), src.ptr(), frames, vol, vol_inc);
+	float ramp_diff = max_difference(a.ptr(), b.ptr(), frames);
+	OS::get_singleton()->print("\tadd_ramp max difference: %f\n", ramp_diff);
+
+	b = src;
+	AudioFrame peak = AudioMix::scale_peak(b.ptrw(), frames, 0.7);
+	AudioFrame expected_peak(0, 0);
+	for (int i = 0; i < frames; i++) {
+		expected_peak.l = MAX(expected_peak.l, ABS(src[i].l * 0.7f));
+		expected_peak.r = MAX(expected_peak.r, ABS(src[i].r * 0.7f));
+	}
+
+	bool pass = ramp_diff < 0.001 && peak.l == expected_peak.l && peak.r == expected_peak.r;
+
+	// Stereo output, and one channel pair of a 5.1 output.
+	for (int stride = 2; stride <= 6; stride += 4) {
+		Vector<int32_t> expected, converted;
+		expected.resize(frames * stride);
+		converted.resize(frames * stride);
+		to_int32_scalar(expected.ptrw(), stride, src.ptr(), frames);
+		AudioMix::to_int32(converted.ptrw(), stride, src.ptr(), frames);
+		for (int i = 0; i < frames; i++) {
+			if (expected[i * stride] != converted[i * stride] || expected[i * stride + 1] != converted[i * stride + 1]) {
+				OS::get_singleton()->print("\tto_int32 differs at frame %i\n", i);
+				pass = false;
+				break;
+			}
+		}
+	}
+
+	return pass;
+}
+
+bool test_kernel_benchmark() {
+
+	OS::get_singleton()->print("\n\nTest 2: Mixing %i voices\n", VOICES);
+
+	Vector<AudioFrame> voice, bus;
+	voice.resize(FRAMES);
+	bus.resize(FRAMES);
+	fill_noise(voice.ptrw(), FRAMES, 1.0);
+	AudioMix::clear(bus.ptrw(), FRAMES);
+
+	AudioFrame vol(0.01, 0.01);
+	AudioFrame vol_inc(0.00001, -0.00001);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int s = 0; s < STEPS; s++) {
+		for (int v = 0; v < VOICES; v++) {
+			add_ramp_scalar(bus.ptrw(), voice.ptr(), FRAMES, vol, vol_inc);
+		}
+	}
+	uint64_t scalar = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int s = 0; s < STEPS; s++) {
+		for (int v = 0; v < VOICES; v++) {
+			AudioMix::add_ramp(bus.ptrw(), voice.ptr(), FRAMES, vol, vol_inc);
+		}
+	}
+	uint64_t mixed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Vector<int32_t> out;
+	out.resize(FRAMES * 2);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int s = 0; s < STEPS * 16; s++) {
+		to_int32_scalar(out.ptrw(), 2, voice.ptr(), FRAMES);
+	}
+	uint64_t convert_scalar = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int s = 0; s < STEPS * 16; s++) {
+		AudioMix::to_int32(out.ptrw(), 2, voice.ptr(), FRAMES);
+	}
+	uint64_t convert = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\tvolume ramp, scalar: %i usec\n", int(scalar));
+	OS::get_singleton()->print("\tvolume ramp, AudioMix: %i usec\n", int(mixed));
+	OS::get_singleton()->print("\tint32 output, scalar: %i usec\n", int(convert_scalar));
+	OS::get_singleton()->print("\tint32 output, AudioMix: %i usec\n", int(convert));
+
+	return true;
+}
+
+struct Voices {
+	Vector<AudioFrame> source;
+	int first_bus;
+};
+
+static void _mix_voices(void *p_userdata) {
+
+	Voices *voices = (Voices *)p_userdata;
+	AudioServer *as = AudioServer::get_singleton();
+	int frames = as->thread_get_mix_buffer_size();
+
+	for (int v = 0; v < VOICES; v++) {
+		AudioFrame *target = as->thread_get_channel_mix_buffer(voices->first_bus + v % BUSES, 0);
+		AudioMix::add_ramp(target, voices->source.ptr(), MIN(frames, voices->source.size()), AudioFrame(0.01, 0.01), AudioFrame(0, 0));
+	}
+}
+
+bool test_server_benchmark() {
+
+	OS::get_singleton()->print("\n\nTest 3: AudioServer mix, %i voices on %i buses with reverb\n", VOICES, BUSES);
+
+	AudioServer *as = AudioServer::get_singleton();
+	if (!as) {
+		OS::get_singleton()->print("\tno AudioServer\n");
+		return false;
+	}
+
+	as->lock(); // Keep the driver thread out while the test mixes.
+
+	Voices voices;
+	voices.source.resize(as->thread_get_mix_buffer_size());
+	fill_noise(voices.source.ptrw(), voices.source.size(), 1.0);
+	voices.first_bus = as->get_bus_count();
+
+	for (int i = 0; i < BUSES; i++) {
+		as->add_bus();
+		Ref<AudioEffectReverb> reverb;
+		reverb.instance();
+		as->add_bus_effect(voices.first_bus + i, reverb);
+	}
+	as->add_callback(_mix_voices, &voices);
+
+	BenchmarkDriver driver;
+	Vector<int32_t> out;
+	out.resize(as->thread_get_mix_buffer_size() * as->get_channel_count() * 2);
+	int frames = as->thread_get_mix_buffer_size();
+
+	int threads_before = as->get_mix_thread_count();
+	int threads = CLAMP(OS::get_singleton()->get_processor_count() - 1, 1, BUSES - 1);
+	uint64_t times[2];
+
+	for (int pass = 0; pass < 2; pass++) {
+		as->set_mix_thread_count(pass == 0 ? 0 : threads);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int s = 0; s < STEPS; s++) {
+			driver.mix(out.ptrw(), frames);
+		}
+		times[pass] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	bool pass = as->is_bus_channel_active(0, 0);
+
+	as->remove_callback(_mix_voices, &voices);
+	for (int i = BUSES - 1; i >= 0; i--) {
+		as->remove_bus(voices.first_bus + i);
+	}
+	as->set_mix_thread_count(threads_before);
+	as->unlock();
+
+	OS::get_singleton()->print("\tbuses on the audio thread: %i usec\n", int(times[0]));
+	OS::get_singleton()->print("\tbuses on %i extra threads: %i usec\n", threads, int(times[1]));
+
+	return pass;
+}
+
+bool test_sample_skip() {
+
+	OS::get_singleton()->print("\n\nTest 4: Skipping a sample lands where mixing would\n");
+
+	AudioServer *as = AudioServer::get_singleton();
+	if (!as) {
+		OS::get_singleton()->print("\tno AudioServer\n");
+		return false;
+	}
+
+	const int length = 1000;
+	PoolVector<uint8_t> data;
+	data.resize(length * 2);
+	for (int i = 0; i < data.size(); i++) {
+		data.set(i, i & 0xFF);
+	}
+
+	Ref<AudioStreamSample> sample;
+	sample.instance();
+	sample->set_format(AudioStreamSample::FORMAT_16_BITS);
+	sample->set_mix_rate(as->get_mix_rate()); // Mix one frame per output frame.
+	sample->set_data(data);
+	sample->set_loop_begin(200);
+	sample->set_loop_end(800);
+
+	const char *mode_names[] = { "disabled", "forward", "ping-pong", "backward" };
+	Vector<AudioFrame> buffer;
+	buffer.resize(100);
+	bool pass = true;
+
+	for (int mode = AudioStreamSample::LOOP_DISABLED; mode <= AudioStreamSample::LOOP_BACKWARD; mode++) {
+		sample->set_loop_mode(AudioStreamSample::LoopMode(mode));
+
+		// Cross the loop points several times, in uneven steps.
+		for (int frames = 300; frames <= 2700; frames += 1200) {
+			Ref<AudioStreamPlayback> mixed = sample->instance_playback();
+			Ref<AudioStreamPlayback> skipped = sample->instance_playback();
+			mixed->start();
+			skipped->start();
+
+			int todo = frames;
+			while (todo > 0) {
+				int step = MIN(todo, buffer.size());
+				mixed->mix(buffer.ptrw(), 1.0, step);
+				todo -= step;
+			}
+			skipped->skip((frames + 0.5) / as->get_mix_rate());
+
+			// Mixing wraps at loop points lazily, one more frame settles both.
+			mixed->mix(buffer.ptrw(), 1.0, 1);
+			skipped->mix(buffer.ptrw(), 1.0, 1);
+
+			float diff = ABS(mixed->get_playback_position() - skipped->get_playback_position()) * as->get_mix_rate();
+			bool ok = mixed->is_playing() == skipped->is_playing() && (!mixed->is_playing() || diff <= 2);
+			OS::get_singleton()->print("\tloop %s, %i frames: %s\n", mode_names[mode], frames, ok ? "ok" : "mismatch");
+			pass = pass && ok;
+		}
+	}
+
+	return pass;
+}
+
+bool test_ring_buffer_read() {
+
+	OS::get_singleton()->print("\n\nTest 5: AudioRBResampler as a plain ring buffer\n");
+
+	AudioRBResampler rb;
+	rb.setup(2, 44100, 44100, 10); // 512 frames.
+
+	Vector<AudioFrame> out;
+	out.resize(300);
+	int written = 0;
+	int read = 0;
+	bool pass = true;
+
+	// Uneven sizes, so reads and writes wrap around the end.
+	for (int step = 0; step < 20; step++) {
+		int todo = MIN(rb.get_writer_space(), 200 + step * 7);
+		float *w = rb.get_write_buffer();
+		for (int i = 0; i < todo; i++) {
+			w[i * 2 + 0] = written + i;
+			w[i * 2 + 1] = -(written + i);
+		}
+		rb.write(todo);
+		written += todo;
+
+		int got = rb.read(out.ptrw(), out.size());
+		for (int i = 0; i < got; i++) {
+			if (out[i].l != read + i || out[i].r != -(read + i)) {
+				pass = false;
+			}
+		}
+		read += got;
+	}
+
+	OS::get_singleton()->print("\twritten %i, read %i frames\n", written, read + rb.get_reader_space());
+
+	return pass && read + rb.get_reader_space() == written;
+}
+
+// Writes just enough of a Vorbis encoder for a test stream: mono, 8000 Hz,
+// 128-sample frames of pseudo random residue on a moving floor.
+class BitWriter {
+public:
+	Vector<uint8_t> data;
+	int bit;
+
+	void put(uint32_t p_value, int p_bits) {
+		for (int i = 0; i < p_bits; i++) {
+			if (bit == 0) {
+				data.push_back(0);
+			}
+			if (p_value & (1u << i)) {
+				data.write[data.size() - 1] |= 1 << bit;
+			}
+			bit = (bit + 1) & 7;
+		}
+	}
+
+	// Huffman codes go most significant bit first.
+	void put_code(uint32_t p_code, int p_bits) {
+		for (int i = p_bits - 1; i >= 0; i--) {
+			put((p_code >> i) & 1, 1);
+		}
+	}
+
+	void put_string(const char *p_string) {
+		while (*p_string) {
+			put(uint8_t(*p_string++), 8);
+		}
+	}
+
+	BitWriter() { bit = 0; }
+};
+
+static void _put_ogg_page(Vector<uint8_t> &r_out, const Vector<Vector<uint8_t> > &p_packets, uint8_t p_flags, uint64_t p_granule, uint32_t p_sequence) {
+
+	Vector<uint8_t> lacing;
+	int body = 0;
+	for (int i = 0; i < p_packets.size(); i++) {
+		int size = p_packets[i].size();
+		body += size;
+		for (; size >= 255; size -= 255) {
+			lacing.push_back(255);
+		}
+		lacing.push_back(size);
+	}
+
+	Vector<uint8_t> page;
+	page.resize(27 + lacing.size() + body);
+	uint8_t *w = page.ptrw();
+	zeromem(w, page.size());
+	w[0] = 'O';
+	w[1] = 'g';
+	w[2] = 'g';
+	w[3] = 'S';
+	w[5] = p_flags;
+	encode_uint64(p_granule, &w[6]);
+	encode_uint32(0x1234, &w[14]); // Stream serial.
+	encode_uint32(p_sequence, &w[18]);
+	w[26] = lacing.size();
+	copymem(&w[27], lacing.ptr(), lacing.size());
+	int ofs = 27 + lacing.size();
+	for (int i = 0; i < p_packets.size(); i++) {
+		copymem(&w[ofs], p_packets[i].ptr(), p_packets[i].size());
+		ofs += p_packets[i].size();
+	}
+
+	uint32_t crc = 0;
+	for (int i = 0; i < page.size(); i++) {
+		crc ^= uint32_t(w[i]) << 24;
+		for (int j = 0; j < 8; j++) {
+			crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+		}
+	}
+	encode_uint32(crc, &w[22]);
+
+	r_out.append_array(page);
+}
+
+static Vector<uint8_t> _make_ogg_vorbis(int p_packets, int p_packets_per_page) {
+
+	BitWriter id;
+	id.put(1, 8);
+	id.put_string("vorbis");
+	id.put(0, 32); // Version.
+	id.put(1, 8); // Channels.
+	id.put(8000, 32);
+	id.put(0, 32); // Bitrates.
+	id.put(0, 32);
+	id.put(0, 32);
+	id.put(8, 4); // Both block sizes 256.
+	id.put(8, 4);
+	id.put(1, 1);
+
+	BitWriter comment;
+	comment.put(3, 8);
+	comment.put_string("vorbis");
+	comment.put(4, 32);
+	comment.put_string("test");
+	comment.put(0, 32);
+	comment.put(1, 1);
+
+	BitWriter setup;
+	setup.put(5, 8);
+	setup.put_string("vorbis");
+	setup.put(1, 8); // Two codebooks.
+	// Partition classes: one dimension, two entries of length 1.
+	setup.put(0x564342, 24);
+	setup.put(1, 16);
+	setup.put(2, 24);
+	setup.put(0, 1);
+	setup.put(0, 1);
+	setup.put(0, 5);
+	setup.put(0, 5);
+	setup.put(0, 4);
+	// Residue values: one dimension, sixteen entries of length 4 for -8 to 7.
+	setup.put(0x564342, 24);
+	setup.put(1, 16);
+	setup.put(16, 24);
+	setup.put(0, 1);
+	setup.put(0, 1);
+	for (int i = 0; i < 16; i++) {
+		setup.put(3, 5);
+	}
+	setup.put(1, 4);
+	setup.put(1 | (791u << 21) | 0x80000000u, 32); // Minimum -8.
+	setup.put(1 | (788u << 21), 32); // Delta 1.
+	setup.put(3, 4);
+	setup.put(0, 1);
+	for (int i = 0; i < 16; i++) {
+		setup.put(i, 4);
+	}
+	setup.put(0, 6); // Time domain transforms.
+	setup.put(0, 16);
+	setup.put(0, 6); // Floor 1, no partitions.
+	setup.put(1, 16);
+	setup.put(0, 5);
+	setup.put(1, 2);
+	setup.put(7, 4);
+	setup.put(0, 6); // Residue 1, two partitions of 16 over the first 32 bins.
+	setup.put(1, 16);
+	setup.put(0, 24);
+	setup.put(32, 24);
+	setup.put(15, 24);
+	setup.put(0, 6);
+	setup.put(0, 8);
+	setup.put(1, 3);
+	setup.put(0, 1);
+	setup.put(1, 8);
+	setup.put(0, 6); // Mapping.
+	setup.put(0, 16);
+	setup.put(0, 1);
+	setup.put(0, 1);
+	setup.put(0, 2);
+	setup.put(0, 8);
+	setup.put(0, 8);
+	setup.put(0, 8);
+	setup.put(0, 6); // Mode.
+	setup.put(0, 1);
+	setup.put(0, 16);
+	setup.put(0, 16);
+	setup.put(0, 8);
+	setup.put(1, 1);
+
+	Vector<uint8_t> out;
+	Vector<Vector<uint8_t> > page;
+
+	page.push_back(id.data);
+	_put_ogg_page(out, page, 0x02, 0, 0);
+	page.clear();
+	page.push_back(comment.data);
+	page.push_back(setup.data);
+	_put_ogg_page(out, page, 0, 0, 1);
+	page.clear();
+
+	uint32_t sequence = 2;
+	uint32_t state = 12345;
+	for (int i = 0; i < p_packets; i++) {
+		BitWriter audio;
+		audio.put(0, 1);
+		audio.put(1, 1); // Floor in use.
+		audio.put(85 + i % 20, 7);
+		audio.put(95 - i % 15, 7);
+		for (int part = 0; part < 2; part++) {
+			audio.put_code(0, 1);
+			for (int j = 0; j < 16; j++) {
+				state = state * 1103515245 + 12345;
+				audio.put_code((state >> 16) & 15, 4);
+			}
+		}
+		page.push_back(audio.data);
+
+		bool last = i == p_packets - 1;
+		if (page.size() == p_packets_per_page || last) {
+			_put_ogg_page(out, page, last ? 0x04 : 0, uint64_t(i) * 128, sequence++);
+			page.clear();
+		}
+	}
+
+	return out;
+}
+
+// Created through ClassDB, the tests don't see the module headers.
+static Ref<AudioStream> _make_ogg_vorbis_stream(const String &p_property, const Variant &p_value, bool p_threaded) {
+
+	Ref<AudioStream> stream = Object::cast_to<AudioStream>(ClassDB::instance("AudioStreamOGGVorbis"));
+	if (stream.is_valid()) {
+		stream->set(p_property, p_value);
+		stream->set("loop", true);
+		stream->set("loop_offset", 1.0);
+		stream->set("threaded_decode", p_threaded);
+	}
+	return stream;
+}
+
+bool test_ogg_vorbis_file() {
+
+	OS::get_singleton()->print("\n\nTest 6: Ogg Vorbis streamed from a file, decoded inline and threaded\n");
+
+	AudioServer *as = AudioServer::get_singleton();
+	if (!as) {
+		OS::get_singleton()->print("\tno AudioServer\n");
+		return false;
+	}
+
+	// About 3.2 seconds, three packets per page.
+	Vector<uint8_t> ogg = _make_ogg_vorbis(200, 3);
+	String path = OS::get_singleton()->get_cache_path().plus_file("test_audio.ogg");
+	FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+	if (!f) {
+		OS::get_singleton()->print("\tcan't write %s\n", path.utf8().get_data());
+		return false;
+	}
+	f->store_buffer(ogg.ptr(), ogg.size());
+	memdelete(f);
+
+	PoolVector<uint8_t> data;
+	data.resize(ogg.size());
+	copymem(data.write().ptr(), ogg.ptr(), ogg.size());
+
+	const char *names[] = { "memory", "file", "file, threaded" };
+	Ref<AudioStream> streams[] = {
+		_make_ogg_vorbis_stream("data", data, false),
+		_make_ogg_vorbis_stream("file", path, false),
+		_make_ogg_vorbis_stream("file", path, true),
+	};
+	Ref<AudioStreamPlayback> playbacks[3];
+	Vector<AudioFrame> output[3];
+	bool pass = true;
+
+	for (int i = 0; i < 3; i++) {
+		if (streams[i].is_null()) {
+			OS::get_singleton()->print("\tno AudioStreamOGGVorbis\n");
+			DirAccess::remove_file_or_error(path);
+			return false;
+		}
+		playbacks[i] = streams[i]->instance_playback();
+		if (playbacks[i].is_null()) {
+			OS::get_singleton()->print("\t%s: can't play\n", names[i]);
+			DirAccess::remove_file_or_error(path);
+			return false;
+		}
+		playbacks[i]->start();
+	}
+
+	const int chunk = 256;
+	int loop_frames = as->get_mix_rate() * 4.5; // Crosses the end once.
+	int seek_frames = as->get_mix_rate(); // From 2.3, across the end again.
+	int loops = 0;
+
+	for (int step = 0; step < 2; step++) {
+		if (step == 1) {
+			loops = playbacks[0]->get_loop_count();
+			for (int i = 0; i < 3; i++) {
+				playbacks[i]->seek(2.3);
+			}
+		}
+
+		int frames = step == 0 ? loop_frames : seek_frames;
+		for (int done = 0; done < frames; done += chunk) {
+			for (int i = 0; i < 3; i++) {
+				int ofs = output[i].size();
+				output[i].resize(ofs + chunk);
+				playbacks[i]->mix(output[i].ptrw() + ofs, 1.0, chunk);
+			}
+			// Slower than real time is no concern, but the decode thread must keep up.
+			OS::get_singleton()->delay_usec(1000);
+		}
+	}
+
+	for (int i = 1; i < 3; i++) {
+		float diff = max_difference(output[0].ptr(), output[i].ptr(), output[0].size());
+		bool ok = diff == 0 && playbacks[i]->get_loop_count() == playbacks[0]->get_loop_count();
+		OS::get_singleton()->print("\t%s: max difference %f, %i loops\n", names[i], diff, playbacks[i]->get_loop_count());
+		pass = pass && ok;
+	}
+
+	OS::get_singleton()->print("\t%i loops before seeking, %i after\n", loops, playbacks[0]->get_loop_count());
+	pass = pass && loops == 1 && playbacks[0]->get_loop_count() == 2;
+
+	for (int i = 0; i < 3; i++) {
+		playbacks[i].unref(); // Closes the file, unless the decode thread still holds it.
+	}
+	DirAccess::remove_file_or_error(path);
+
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_kernels,
+	test_kernel_benchmark,
+	test_server_benchmark,
+	test_sample_skip,
+	test_ring_buffer_read,
+	test_ogg_vorbis_file,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+
+} // namespace TestAudio
@@ -0,0 +1,123 @@
+/*************************************************************************/
+/*  test_canvas_batching.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_canvas_batching.h"
+
+#include "core/os/os.h"
+#include "core/project_settings.h"
+#include "scene/2d/sprite.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+#include "scene/resources/texture.h"
+#include "servers/visual_server.h"
+
+namespace TestCanvasBatching {
+
+static const int SPRITES = 200;
+static const int FRAMES = 5;
+
+// Draws many sprites sharing a texture and checks the 2D counters of the
+// GLES3 renderer, no user input needed.
+class TestMainLoop : public SceneTree {
+
+	int frames;
+
+public:
+	virtual void init() {
+
+		SceneTree::init();
+
+		frames = 0;
+
+		Ref<Image> image;
+		image.instance();
+		image->create(16, 16, false, Image::FORMAT_RGBA8);
+		image->fill(Color(1, 0.5, 0.25));
+		Ref<ImageTexture> texture;
+		texture.instance();
+		texture->create_from_image(image);
+
+		for (int i = 0; i < SPRITES; i++) {
+
+			Sprite *sprite = memnew(Sprite);
+			sprite->set_texture(texture);
+			sprite->set_position(Vector2((i % 20) * 20, (i / 20) * 20));
+			// Flipped and region sprites go through the same batch.
+			sprite->set_flip_h(i % 3 == 0);
+			if (i % 5 == 0) {
+				sprite->set_region(true);
+				sprite->set_region_rect(Rect2(4, 4, 8, 8));
+			}
+			get_root()->add_child(sprite);
+		}
+	}
+
+	virtual bool idle(float p_time) {
+
+		bool finished = SceneTree::idle(p_time);
+
+		if (++frames < FRAMES) {
+			return finished;
+		}
+
+		VisualServer *vs = VisualServer::get_singleton();
+		int items = vs->get_render_info(VS::INFO_2D_ITEMS_IN_FRAME);
+		int draw_calls = vs->get_render_info(VS::INFO_2D_DRAW_CALLS_IN_FRAME);
+		int batches = vs->get_render_info(VS::INFO_2D_BATCHES_IN_FRAME);
+		int joined = vs->get_render_info(VS::INFO_2D_ITEMS_JOINED_IN_FRAME);
+
+		OS::get_singleton()->print("\n\nTest 1: Sprites sharing a texture are drawn in few calls\n");
+		OS::get_singleton()->print("\titems: %i, draw calls: %i, batches: %i, items joined: %i\n", items, draw_calls, batches, joined);
+
+		bool pass;
+		if (OS::get_singleton()->get_current_video_driver() != OS::VIDEO_DRIVER_GLES3) {
+			OS::get_singleton()->print("\tnot running on GLES3, skipped\n");
+			pass = true;
+		} else if (!bool(GLOBAL_GET("rendering/batching/options/use_batching"))) {
+			// Disabled in the project, every item must take its own draw call.
+			pass = batches == 0 && joined == 0 && draw_calls >= SPRITES;
+		} else {
+			pass = items >= SPRITES && batches > 0 && joined >= SPRITES - batches && draw_calls < SPRITES / 10;
+		}
+
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+		OS::get_singleton()->print("\n");
+		OS::get_singleton()->print("Passed %i of %i tests\n", pass ? 1 : 0, 1);
+
+		return true;
+	}
+};
+
+MainLoop *test() {
+
+	return memnew(TestMainLoop);
+}
+
+} // namespace TestCanvasBatching
@@ -0,0 +1,510 @@
+/*************************************************************************/
+/*  test_http.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_http.h"
+
+#include "core/io/http_client.h"
+#include "core/io/tcp_server.h"
+#include "core/os/os.h"
+#include "scene/main/http_request.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+namespace TestHTTP {
+
+static const int BODY_SIZE = 1024;
+static const int REQUESTS = 200;
+static const int PIPELINE_DEPTH = 8;
+
+// Keep-alive HTTP/1.1 server answering GET requests with a body starting
+// with the requested path. It is polled from the same thread as the client.
+struct TestServer {
+
+	Ref<TCP_Server> server;
+	Vector<Ref<StreamPeerTCP> > peers;
+	Vector<String> pending;
+	int port;
+	int connections;
+	bool send_close; // Answer with "Connection: close", but leave the connection open.
+
+	bool start() {
+
+		server.instance();
+		port = 0;
+		connections = 0;
+		send_close = false;
+		for (int p = 18400; p < 18500; p++) {
+			if (server->listen(p, IP_Address("127.0.0.1")) == OK) {
+				port = p;
+				break;
+			}
+		}
+		if (!port) {
+			OS::get_singleton()->print("\tunable to listen on localhost\n");
+			return false;
+		}
+		return true;
+	}
+
+	void respond(Ref<StreamPeerTCP> p_peer, const String &p_path) {
+
+		CharString body = p_path.utf8();
+		String head = "HTTP/1.1 200 OK\r\nContent-Length: " + itos(BODY_SIZE) + "\r\n" + (send_close ? "Connection: close\r\n" : "") + "\r\n";
+		CharString response = head.utf8();
+
+		Vector<uint8_t> data;
+		data.resize(response.length() + BODY_SIZE);
+		uint8_t *w = data.ptrw();
+		copymem(w, response.get_data(), response.length());
+		w += response.length();
+		memset(w, 'x', BODY_SIZE);
+		copymem(w, body.get_data(), MIN(body.length(), BODY_SIZE));
+		p_peer->put_data(data.ptr(), data.size());
+	}
+
+	void poll() {
+
+		while (server->is_connection_available()) {
+			peers.push_back(server->take_connection());
+			pending.push_back(String());
+			connections++;
+		}
+
+		uint8_t buffer[4096];
+		for (int i = peers.size() - 1; i >= 0; i--) {
+			if (peers[i]->get_net_socket()->poll(NetSocket::POLL_TYPE_IN, 0) != OK)
+				continue;
+
+			int read = 0;
+			if (peers.write[i]->get_partial_data(buffer, sizeof(buffer), read) != OK) {
+				// Closed by the client.
+				peers.remove(i);
+				pending.remove(i);
+				continue;
+			}
+
+			String text = pending[i] + String::utf8((const char *)buffer, read);
+			int end = text.find("\r\n\r\n");
+			while (end != -1) {
+				respond(peers[i], text.substr(0, end).get_slice(" ", 1));
+				text = text.substr(end + 4, text.length());
+				end = text.find("\r\n\r\n");
+			}
+			pending.write[i] = text;
+		}
+	}
+
+	// Closes every open connection, like a server timing out idle clients.
+	void drop_connections() {
+		for (int i = 0; i < peers.size(); i++) {
+			peers.write[i]->disconnect_from_host();
+		}
+		peers.clear();
+		pending.clear();
+	}
+
+	void stop() {
+		peers.clear();
+		pending.clear();
+		server->stop();
+	}
+};
+
+static bool connect(TestServer &p_server, Ref<HTTPClient> p_client) {
+
+	if (p_client->connect_to_host("127.0.0.1", p_server.port) != OK)
+		return false;
+
+	uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 2000;
+	while ((p_client->get_status() == HTTPClient::STATUS_RESOLVING || p_client->get_status() == HTTPClient::STATUS_CONNECTING) && OS::get_singleton()->get_ticks_msec() < deadline) {
+		p_server.poll();
+		p_client->poll();
+	}
+	return p_client->get_status() == HTTPClient::STATUS_CONNECTED;
+}
+
+// Waits for the next response and returns its body.
+static String read_body(TestServer &p_server, Ref<HTTPClient> p_client) {
+
+	uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 2000;
+	while (p_client->get_status() == HTTPClient::STATUS_REQUESTING && OS::get_singleton()->get_ticks_msec() < deadline) {
+		p_server.poll();
+		p_client->poll();
+	}
+
+	PoolByteArray body;
+	while (p_client->get_status() == HTTPClient::STATUS_BODY && OS::get_singleton()->get_ticks_msec() < deadline) {
+		p_server.poll();
+		p_client->poll();
+		body.append_array(p_client->read_response_body_chunk());
+	}
+
+	if (body.size() == 0)
+		return String();
+	PoolByteArray::Read r = body.read();
+	return String::utf8((const char *)r.ptr(), body.size());
+}
+
+static bool fetch(TestServer &p_server, Ref<HTTPClient> p_client, const String &p_path) {
+
+	if (p_client->request(HTTPClient::METHOD_GET, p_path, Vector<String>()) != OK)
+		return false;
+
+	String body = read_body(p_server, p_client);
+	return body.length() == BODY_SIZE && body.begins_with(p_path);
+}
+
+bool test_keep_alive(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 1: Requests reuse the connection\n");
+
+	TestServer server;
+	if (!server.start())
+		return false;
+
+	Ref<HTTPClient> client;
+	client.instance();
+	bool pass = connect(server, client);
+	pass = pass && fetch(server, client, "/first");
+	pass = pass && fetch(server, client, "/second");
+	pass = pass && client->get_status() == HTTPClient::STATUS_CONNECTED;
+	pass = pass && server.connections == 1;
+
+	client->close();
+	server.stop();
+	return pass;
+}
+
+bool test_pipelining(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 2: Pipelined responses arrive in request order\n");
+
+	TestServer server;
+	if (!server.start())
+		return false;
+
+	Ref<HTTPClient> client;
+	client.instance();
+	if (!connect(server, client))
+		return false;
+
+	bool pass = client->request(HTTPClient::METHOD_GET, "/0", Vector<String>()) == OK;
+
+	// Not allowed while a request is in flight, unless pipelining.
+	pass = pass && client->request(HTTPClient::METHOD_GET, "/1", Vector<String>()) != OK;
+
+	client->set_pipelining_enabled(true);
+	for (int i = 1; i < PIPELINE_DEPTH; i++) {
+		pass = pass && client->request(HTTPClient::METHOD_GET, "/" + itos(i), Vector<String>()) == OK;
+	}
+	pass = pass && client->get_pending_request_count() == PIPELINE_DEPTH;
+
+	for (int i = 0; i < PIPELINE_DEPTH; i++) {
+		String body = read_body(server, client);
+		if (!body.begins_with("/" + itos(i) + "x")) {
+			OS::get_singleton()->print("\tresponse %i out of order\n", i);
+			pass = false;
+		}
+	}
+
+	pass = pass && client->get_status() == HTTPClient::STATUS_CONNECTED;
+	pass = pass && client->get_pending_request_count() == 0;
+	pass = pass && server.connections == 1;
+
+	client->close();
+	server.stop();
+	return pass;
+}
+
+// Collects what an HTTPRequest reports through its signals.
+class RequestRecorder : public Node {
+
+	GDCLASS(RequestRecorder, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("_request_completed"), &RequestRecorder::_request_completed);
+		ClassDB::bind_method(D_METHOD("_body_chunk_received"), &RequestRecorder::_body_chunk_received);
+	}
+
+public:
+	HTTPRequest *request;
+	bool done;
+	int result;
+	int code;
+	PoolByteArray body;
+	PoolByteArray streamed;
+	int chunks;
+
+	void _request_completed(int p_result, int p_code, const PoolStringArray &p_headers, const PoolByteArray &p_body) {
+		done = true;
+		result = p_result;
+		code = p_code;
+		body = p_body;
+	}
+
+	void _body_chunk_received(const PoolByteArray &p_chunk) {
+		streamed.append_array(p_chunk);
+		chunks++;
+	}
+
+	// Sends a request and runs frames until it completes.
+	bool fetch(SceneTree *p_tree, TestServer &p_server, const String &p_path) {
+
+		done = false;
+		result = -1;
+		code = 0;
+		body.resize(0);
+		streamed.resize(0);
+		chunks = 0;
+
+		if (request->request("http://127.0.0.1:" + itos(p_server.port) + p_path) != OK)
+			return false;
+
+		uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 2000;
+		while (!done && OS::get_singleton()->get_ticks_msec() < deadline) {
+			p_server.poll();
+			p_tree->idle(0);
+		}
+		return done && result == HTTPRequest::RESULT_SUCCESS && code == 200;
+	}
+
+	RequestRecorder() {
+		request = memnew(HTTPRequest);
+		request->set_use_connection_pool(true);
+		request->connect("request_completed", this, "_request_completed");
+		request->connect("body_chunk_received", this, "_body_chunk_received");
+		add_child(request);
+		done = false;
+		result = -1;
+		code = 0;
+		chunks = 0;
+	}
+};
+
+static String _body_string(const PoolByteArray &p_body) {
+
+	if (p_body.size() == 0)
+		return String();
+	PoolByteArray::Read r = p_body.read();
+	return String::utf8((const char *)r.ptr(), p_body.size());
+}
+
+bool test_request_pool(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 3: HTTPRequest nodes share pooled connections\n");
+
+	TestServer server;
+	if (!server.start())
+		return false;
+
+	RequestRecorder *a = memnew(RequestRecorder);
+	RequestRecorder *b = memnew(RequestRecorder);
+	p_tree->get_root()->add_child(a);
+	p_tree->get_root()->add_child(b);
+
+	bool pass = a->fetch(p_tree, server, "/a") && _body_string(a->body).begins_with("/a");
+	pass = pass && b->fetch(p_tree, server, "/b") && _body_string(b->body).begins_with("/b");
+	pass = pass && a->fetch(p_tree, server, "/c") && _body_string(a->body).begins_with("/c");
+	int reused = server.connections;
+
+	// A response asking to close must not be pooled, even if the server
+	// leaves the socket open.
+	server.send_close = true;
+	pass = pass && a->fetch(p_tree, server, "/d");
+	server.send_close = false;
+	pass = pass && b->fetch(p_tree, server, "/e");
+	int after_close = server.connections;
+
+	OS::get_singleton()->print("\tconnections: %i for 3 requests, %i after a Connection: close response\n", reused, after_close);
+
+	memdelete(a);
+	memdelete(b);
+	HTTPRequest::clear_connection_pool();
+	server.stop();
+
+	return pass && reused == 1 && after_close == 2;
+}
+
+bool test_request_retry(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 4: HTTPRequest retries when a pooled connection went stale\n");
+
+	TestServer server;
+	if (!server.start())
+		return false;
+
+	RequestRecorder *rec = memnew(RequestRecorder);
+	p_tree->get_root()->add_child(rec);
+
+	bool pass = rec->fetch(p_tree, server, "/first");
+
+	// The server closes the idle connection while it sits in the pool.
+	server.drop_connections();
+	OS::get_singleton()->delay_usec(10000);
+
+	pass = pass && rec->fetch(p_tree, server, "/second") && _body_string(rec->body).begins_with("/second");
+
+	OS::get_singleton()->print("\tconnections: %i\n", server.connections);
+
+	memdelete(rec);
+	HTTPRequest::clear_connection_pool();
+	server.stop();
+
+	return pass && server.connections == 2;
+}
+
+bool test_request_stream_body(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 5: HTTPRequest streams the body in chunks\n");
+
+	TestServer server;
+	if (!server.start())
+		return false;
+
+	RequestRecorder *rec = memnew(RequestRecorder);
+	rec->request->set_stream_body(true);
+	rec->request->set_download_chunk_size(256);
+	p_tree->get_root()->add_child(rec);
+
+	bool pass = rec->fetch(p_tree, server, "/stream");
+
+	OS::get_singleton()->print("\tchunks: %i, streamed: %i bytes, completed body: %i bytes\n", rec->chunks, rec->streamed.size(), rec->body.size());
+
+	pass = pass && rec->chunks > 1 && rec->streamed.size() == BODY_SIZE && rec->body.size() == 0;
+	pass = pass && _body_string(rec->streamed).begins_with("/stream");
+
+	memdelete(rec);
+	HTTPRequest::clear_connection_pool();
+	server.stop();
+
+	return pass;
+}
+
+bool test_benchmark(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 6: Sequential requests on localhost\n");
+
+	TestServer server;
+	if (!server.start())
+		return false;
+
+	Ref<HTTPClient> client;
+	client.instance();
+
+	// What HTTPRequest does without the connection pool.
+	int ok_reconnect = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < REQUESTS; i++) {
+		if (connect(server, client) && fetch(server, client, "/" + itos(i)))
+			ok_reconnect++;
+		client->close();
+	}
+	uint64_t reconnect = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int ok_keep_alive = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	if (connect(server, client)) {
+		for (int i = 0; i < REQUESTS; i++) {
+			if (fetch(server, client, "/" + itos(i)))
+				ok_keep_alive++;
+		}
+	}
+	uint64_t keep_alive = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int ok_pipelined = 0;
+	client->set_pipelining_enabled(true);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < REQUESTS; i += PIPELINE_DEPTH) {
+		for (int j = 0; j < PIPELINE_DEPTH; j++) {
+			client->request(HTTPClient::METHOD_GET, "/" + itos(i + j), Vector<String>());
+		}
+		for (int j = 0; j < PIPELINE_DEPTH; j++) {
+			if (read_body(server, client).begins_with("/" + itos(i + j) + "x"))
+				ok_pipelined++;
+		}
+	}
+	uint64_t pipelined = OS::get_singleton()->get_ticks_usec() - begin;
+
+	client->close();
+	server.stop();
+
+	OS::get_singleton()->print("\tconnection per request: %i usec (%i of %i)\n", int(reconnect), ok_reconnect, REQUESTS);
+	OS::get_singleton()->print("\tkeep-alive: %i usec (%i of %i)\n", int(keep_alive), ok_keep_alive, REQUESTS);
+	OS::get_singleton()->print("\tpipelined, depth %i: %i usec (%i of %i)\n", PIPELINE_DEPTH, int(pipelined), ok_pipelined, REQUESTS);
+
+	return ok_reconnect == REQUESTS && ok_keep_alive == REQUESTS && ok_pipelined == REQUESTS;
+}
+
+typedef bool (*TestFunc)(SceneTree *p_tree);
+
+TestFunc test_funcs[] = {
+	test_keep_alive,
+	test_pipelining,
+	test_request_pool,
+	test_request_retry,
+	test_request_stream_body,
+	test_benchmark,
+	NULL
+};
+
+class TestMainLoop : public SceneTree {
+
+public:
+	virtual void init() {
+
+		SceneTree::init();
+
+		int count = 0;
+		int passed = 0;
+
+		while (true) {
+			if (!test_funcs[count])
+				break;
+			bool pass = test_funcs[count](this);
+			if (pass)
+				passed++;
+			OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+			count++;
+		}
+		OS::get_singleton()->print("\n");
+		OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+		quit();
+	}
+};
+
+MainLoop *test() {
+
+	return memnew(TestMainLoop);
+}
+
+} // namespace TestHTTP
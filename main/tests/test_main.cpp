@@ -34,17 +34,27 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_animation.h"
 #include "test_astar.h"
+#include "test_audio.h"
+#include "test_canvas_batching.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
+#include "test_http.h"
+#include "test_marshalls.h"
 #include "test_math.h"
+#include "test_multiplayer.h"
+#include "test_net_socket.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
+#include "test_pool_vector.h"
 #include "test_render.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
+#include "test_tile_map.h"
+#include "test_transform.h"
 
 const char **tests_get_names() {
 
@@ -63,6 +73,16 @@ const char **tests_get_names() {
 		"gd_bytecode",
 		"ordered_hash_map",
 		"astar",
+		"animation",
+		"multiplayer",
+		"marshalls",
+		"net_socket",
+		"http",
+		"audio",
+		"transform",
+		"canvas_batching",
+		"pool_vector",
+		"tile_map",
 		NULL
 	};
 
@@ -143,6 +163,56 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "animation") {
+
+		return TestAnimation::test();
+	}
+
+	if (p_test == "multiplayer") {
+
+		return TestMultiplayer::test();
+	}
+
+	if (p_test == "marshalls") {
+
+		return TestMarshalls::test();
+	}
+
+	if (p_test == "net_socket") {
+
+		return TestNetSocket::test();
+	}
+
+	if (p_test == "http") {
+
+		return TestHTTP::test();
+	}
+
+	if (p_test == "audio") {
+
+		return TestAudio::test();
+	}
+
+	if (p_test == "transform") {
+
+		return TestTransform::test();
+	}
+
+	if (p_test == "canvas_batching") {
+
+		return TestCanvasBatching::test();
+	}
+
+	if (p_test == "pool_vector") {
+
+		return TestPoolVector::test();
+	}
+
+	if (p_test == "tile_map") {
+
+		return TestTileMap::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
@@ -0,0 +1,281 @@
+/*************************************************************************/
+/*  test_marshalls.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_marshalls.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/stream_peer.h"
+#include "core/os/os.h"
+
+namespace TestMarshalls {
+
+// Nested containers of mixed values, like a typical RPC or save payload.
+static Variant _make_payload(int p_depth) {
+
+	Dictionary d;
+	d["name"] = String::utf8("entité_") + itos(p_depth);
+	d["position"] = Vector3(p_depth, 2.5, -1.25);
+	d["rotation"] = Quat(0, 0, 0, 1);
+	d["health"] = 100 - p_depth;
+	d["score"] = int64_t(1) << 40;
+	d["speed"] = 0.1;
+	d["path"] = NodePath("Level/Players/Player" + itos(p_depth) + ":position:x");
+
+	Array items;
+	for (int i = 0; i < 8; i++) {
+		items.push_back(i % 2 ? Variant("item_" + itos(i)) : Variant(i * 1.5));
+	}
+	d["items"] = items;
+
+	PoolVector<uint8_t> bytes;
+	bytes.resize(13);
+	for (int i = 0; i < bytes.size(); i++) {
+		bytes.set(i, i);
+	}
+	d["bytes"] = bytes;
+
+	PoolVector<String> tags;
+	tags.push_back("a");
+	tags.push_back("");
+	tags.push_back(String::utf8("ünïcode"));
+	d["tags"] = tags;
+
+	if (p_depth > 0) {
+		Array children;
+		for (int i = 0; i < 4; i++) {
+			children.push_back(_make_payload(p_depth - 1));
+		}
+		d["children"] = children;
+	}
+
+	return d;
+}
+
+static Vector<uint8_t> _encode(const Variant &p_value) {
+
+	Vector<uint8_t> ret;
+	int len;
+	encode_variant(p_value, NULL, len);
+	ret.resize(len);
+	encode_variant(p_value, ret.ptrw(), len);
+	return ret;
+}
+
+bool test_writer_matches() {
+
+	OS::get_singleton()->print("\n\nTest 1: Streaming writer output matches encode_variant\n");
+
+	Array values;
+	values.push_back(Variant());
+	values.push_back(true);
+	values.push_back(-7);
+	values.push_back(int64_t(1) << 40);
+	values.push_back(0.5);
+	values.push_back(0.1);
+	values.push_back(String());
+	values.push_back(String::utf8("日本語 ok"));
+	values.push_back(NodePath("/root/Main:modulate:a"));
+	values.push_back(Rect2(1, 2, 3, 4));
+	values.push_back(Transform(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3)));
+	values.push_back(Color(0.25, 0.5, 0.75));
+	values.push_back(_make_payload(2));
+
+	VariantEncoder writer;
+	bool pass = true;
+
+	for (int i = 0; i < values.size(); i++) {
+
+		writer.clear();
+		Error err = writer.write(values[i]);
+		Vector<uint8_t> expected = _encode(values[i]);
+
+		if (err != OK || writer.get_size() != expected.size() || memcmp(writer.get_data(), expected.ptr(), expected.size()) != 0) {
+			OS::get_singleton()->print("\tmismatch for %s\n", Variant::get_type_name(values[i].get_type()).utf8().get_data());
+			pass = false;
+		}
+	}
+
+	return pass;
+}
+
+bool test_reader_slice() {
+
+	OS::get_singleton()->print("\n\nTest 2: Reading consecutive values from a PoolByteArray slice\n");
+
+	Variant payload = _make_payload(1);
+
+	VariantEncoder writer;
+	writer.write(payload);
+	writer.write(42);
+	writer.write("tail");
+
+	// Surround the values with unrelated bytes, only the slice is decoded.
+	PoolVector<uint8_t> data;
+	data.resize(writer.get_size() + 16);
+	{
+		PoolVector<uint8_t>::Write w = data.write();
+		for (int i = 0; i < data.size(); i++) {
+			w[i] = 0xAA;
+		}
+		copymem(w.ptr() + 8, writer.get_data(), writer.get_size());
+	}
+
+	VariantDecoder reader(data, 8, writer.get_size());
+	Variant a, b, c;
+	if (reader.read(a) != OK || reader.read(b) != OK || reader.read(c) != OK)
+		return false;
+
+	return reader.is_at_end() && a.hash() == payload.hash() && int(b) == 42 && String(c) == "tail";
+}
+
+bool test_writer_max_size() {
+
+	OS::get_singleton()->print("\n\nTest 3: Writer refuses values past its size limit\n");
+
+	VariantEncoder writer;
+	writer.set_max_size(1024);
+
+	Variant payload = _make_payload(3);
+	if (writer.write(payload) != ERR_OUT_OF_MEMORY || writer.get_size() != 0) {
+		OS::get_singleton()->print("\toversized value was not rejected\n");
+		return false;
+	}
+
+	// The failed write must not leave anything behind for the next one.
+	Variant small = _make_payload(0);
+	Vector<uint8_t> expected = _encode(small);
+	if (writer.write(small) != OK || writer.get_size() != expected.size() || memcmp(writer.get_data(), expected.ptr(), expected.size()) != 0) {
+		OS::get_singleton()->print("\tvalue after a failed write was not encoded correctly\n");
+		return false;
+	}
+
+	return true;
+}
+
+bool test_stream_peer_var() {
+
+	OS::get_singleton()->print("\n\nTest 4: StreamPeer get_var() after an oversized value\n");
+
+	PoolVector<uint8_t> big;
+	big.resize(3 * 1024 * 1024 + 5);
+	{
+		PoolVector<uint8_t>::Write w = big.write();
+		for (int i = 0; i < big.size(); i++) {
+			w[i] = i * 7;
+		}
+	}
+	Variant payload = _make_payload(1);
+
+	Ref<StreamPeerBuffer> stream;
+	stream.instance();
+	stream->put_var(payload);
+	stream->put_var(big);
+	stream->put_var(payload);
+	stream->seek(0);
+
+	Variant a = stream->get_var();
+	Variant b = stream->get_var();
+	Variant c = stream->get_var();
+
+	return a.hash() == payload.hash() && b.hash() == Variant(big).hash() && c.hash() == payload.hash() && stream->get_available_bytes() == 0;
+}
+
+bool test_benchmark() {
+
+	OS::get_singleton()->print("\n\nTest 5: Encoding nested Arrays and Dictionaries\n");
+
+	const int iterations = 200;
+	Variant payload = _make_payload(3);
+
+	uint64_t size = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		size += _encode(payload).size();
+	}
+	uint64_t two_pass = OS::get_singleton()->get_ticks_usec() - begin;
+
+	VariantEncoder writer;
+	uint64_t streamed = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		writer.clear();
+		writer.write(payload);
+		streamed += writer.get_size();
+	}
+	uint64_t single_pass = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Variant v;
+		VariantDecoder reader(writer.get_data(), writer.get_size());
+		reader.read(v);
+	}
+	uint64_t decode = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\tpayload: %i bytes\n", writer.get_size());
+	OS::get_singleton()->print("\tencode_variant, measure + write: %i usec\n", int(two_pass));
+	OS::get_singleton()->print("\tVariantEncoder, reused buffer: %i usec\n", int(single_pass));
+	OS::get_singleton()->print("\tVariantDecoder: %i usec\n", int(decode));
+
+	return size == streamed;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_writer_matches,
+	test_reader_slice,
+	test_writer_max_size,
+	test_stream_peer_var,
+	test_benchmark,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+
+} // namespace TestMarshalls
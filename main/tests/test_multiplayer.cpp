@@ -0,0 +1,714 @@
+/*************************************************************************/
+/*  test_multiplayer.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_multiplayer.h"
+
+#include "core/class_db.h"
+#include "core/io/multiplayer_api.h"
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "scene/3d/spatial.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+namespace TestMultiplayer {
+
+static const int PEERS = 64;
+static const int ENTITIES = 512;
+static const float WORLD_SIZE = 100.0;
+static const float RELEVANCY_RADIUS = 30.0;
+static const float QUANTIZATION = 0.01;
+static const int BUDGET = 1200; // Bytes per peer and snapshot.
+static const float PACKET_LOSS = 0.05;
+static const int MOVING_TICKS = 60;
+static const int SETTLE_TICKS = 30;
+static const int ENET_TIMEOUT_MSEC = 2000;
+
+// Delivers packets between peers living in the same process, optionally
+// dropping unreliable ones.
+class LoopbackPeer : public NetworkedMultiplayerPeer {
+
+	GDCLASS(LoopbackPeer, NetworkedMultiplayerPeer);
+
+	struct Packet {
+		int from;
+		Vector<uint8_t> data;
+	};
+
+	List<Packet> incoming;
+	Packet current;
+	int target;
+	TransferMode mode;
+
+public:
+	Vector<LoopbackPeer *> *network;
+	RandomPCG *rng;
+	int id;
+	float loss;
+	int sent_packets;
+	uint64_t sent_bytes;
+	Vector<uint8_t> last_packet;
+
+	void deliver(int p_from, const uint8_t *p_buffer, int p_buffer_size) {
+
+		Packet packet;
+		packet.from = p_from;
+		packet.data.resize(p_buffer_size);
+		copymem(packet.data.ptrw(), p_buffer, p_buffer_size);
+		incoming.push_back(packet);
+	}
+
+	virtual void set_transfer_mode(TransferMode p_mode) { mode = p_mode; }
+	virtual TransferMode get_transfer_mode() const { return mode; }
+	virtual void set_target_peer(int p_peer_id) { target = p_peer_id; }
+	virtual int get_packet_peer() const { return incoming.size() ? incoming.front()->get().from : 0; }
+	virtual bool is_server() const { return id == 1; }
+	virtual void poll() {}
+	virtual int get_unique_id() const { return id; }
+	virtual void set_refuse_new_connections(bool p_enable) {}
+	virtual bool is_refusing_new_connections() const { return false; }
+	virtual ConnectionStatus get_connection_status() const { return CONNECTION_CONNECTED; }
+
+	virtual int get_available_packet_count() const { return incoming.size(); }
+	virtual int get_max_packet_size() const { return 1 << 24; }
+
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
+
+		ERR_FAIL_COND_V(incoming.empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.data.ptr();
+		r_buffer_size = current.data.size();
+		return OK;
+	}
+
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+
+		sent_packets++;
+		sent_bytes += p_buffer_size;
+		last_packet.resize(p_buffer_size);
+		copymem(last_packet.ptrw(), p_buffer, p_buffer_size);
+
+		for (int i = 0; i < network->size(); i++) {
+
+			LoopbackPeer *peer = (*network)[i];
+			if (peer == this)
+				continue;
+			if (target > 0 && peer->id != target)
+				continue;
+			if (target < 0 && peer->id == -target)
+				continue;
+			if (mode == TRANSFER_MODE_UNRELIABLE && rng->randf() < loss)
+				continue; // Dropped.
+
+			peer->deliver(id, p_buffer, p_buffer_size);
+		}
+		return OK;
+	}
+
+	LoopbackPeer() :
+			target(0),
+			mode(TRANSFER_MODE_RELIABLE),
+			network(NULL),
+			rng(NULL),
+			id(0),
+			loss(0),
+			sent_packets(0),
+			sent_bytes(0) {}
+};
+
+// One server and PEERS clients, each with its own copy of the entities under
+// its own MultiplayerAPI root.
+struct Simulation {
+
+	RandomPCG rng;
+	Vector<LoopbackPeer *> network;
+	Vector<Ref<LoopbackPeer> > peers;
+	Vector<Ref<MultiplayerAPI> > api_refs;
+	Vector<MultiplayerAPI *> apis;
+	Vector<Node *> roots;
+	Vector<Spatial *> viewers;
+	uint64_t snapshot_usec;
+	int ticks;
+
+	Spatial *get_entity(int p_api, int p_entity) const {
+		return Object::cast_to<Spatial>(roots[p_api]->get_child(p_entity));
+	}
+
+	void setup(SceneTree *p_tree) {
+
+		snapshot_usec = 0;
+		ticks = 0;
+
+		for (int i = 0; i <= PEERS; i++) {
+
+			Node *root = memnew(Node);
+			root->set_name(i == 0 ? String("Server") : "Client" + itos(i));
+			p_tree->get_root()->add_child(root);
+			roots.push_back(root);
+
+			Ref<LoopbackPeer> peer;
+			peer.instance();
+			peer->network = &network;
+			peer->rng = &rng;
+			peer->id = i + 1;
+			network.push_back(peer.ptr());
+			peers.push_back(peer);
+
+			Ref<MultiplayerAPI> api;
+			api.instance();
+			api->set_root_node(root);
+			api->set_network_peer(peer);
+			api->set_replication_tick_rate(0); // Ticked by hand below.
+			api_refs.push_back(api);
+			apis.push_back(api.ptr());
+
+			for (int j = 0; j < ENTITIES; j++) {
+
+				Spatial *entity = memnew(Spatial);
+				entity->set_name("Entity" + itos(j));
+				root->add_child(entity);
+
+				// Both sides register the same properties in the same order.
+				api->replicate_property(entity, "translation", QUANTIZATION);
+				api->replicate_property(entity, "visible");
+			}
+		}
+
+		for (int j = 0; j < ENTITIES; j++) {
+			get_entity(0, j)->set_translation(Vector3(rng.randf() * WORLD_SIZE, 0, rng.randf() * WORLD_SIZE));
+		}
+
+		for (int i = 1; i <= PEERS; i++) {
+
+			network[0]->emit_signal("peer_connected", i + 1);
+			network[i]->emit_signal("peer_connected", 1);
+
+			// Viewers live on the server only, they are not replicated.
+			Spatial *viewer = memnew(Spatial);
+			viewer->set_name("Viewer" + itos(i));
+			viewer->set_translation(Vector3(rng.randf() * WORLD_SIZE, 0, rng.randf() * WORLD_SIZE));
+			roots[0]->add_child(viewer);
+			viewers.push_back(viewer);
+
+			apis[0]->set_replication_viewer(i + 1, viewer);
+		}
+
+		apis[0]->set_replication_relevancy_radius(RELEVANCY_RADIUS);
+		apis[0]->set_replication_budget(BUDGET);
+	}
+
+	void tick(bool p_moving, float p_loss) {
+
+		for (int i = 0; i < network.size(); i++) {
+			network[i]->loss = p_loss;
+		}
+
+		if (p_moving) {
+			// A quarter of the entities walk around, the rest stand still.
+			for (int j = 0; j < ENTITIES; j += 4) {
+				Spatial *entity = get_entity(0, j);
+				entity->set_translation(entity->get_translation() + Vector3(Math::cos(float(j)), 0, Math::sin(float(j))) * 0.1);
+			}
+			get_entity(0, 1)->set_visible(!get_entity(0, 1)->is_visible());
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		apis[0]->send_replication_snapshot();
+		snapshot_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		ticks++;
+
+		for (int i = 1; i < apis.size(); i++) {
+			apis[i]->poll();
+		}
+		apis[0]->poll();
+	}
+
+	bool is_relevant(int p_client, int p_entity) const {
+		return viewers[p_client - 1]->get_translation().distance_to(get_entity(0, p_entity)->get_translation()) <= RELEVANCY_RADIUS;
+	}
+
+	void cleanup() {
+
+		for (int i = 0; i < apis.size(); i++) {
+			apis[i]->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+		}
+		for (int i = 0; i < roots.size(); i++) {
+			memdelete(roots[i]);
+		}
+	}
+};
+
+bool test_replication_converges(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 1: Clients converge on the server state under packet loss\n");
+
+	Simulation sim;
+	sim.setup(p_tree);
+
+	// The first client never sees entity 0.
+	sim.apis[0]->set_replication_visibility(sim.get_entity(0, 0), 2, false);
+
+	for (int i = 0; i < MOVING_TICKS; i++) {
+		sim.tick(true, PACKET_LOSS);
+	}
+	for (int i = 0; i < SETTLE_TICKS; i++) {
+		sim.tick(false, 0);
+	}
+
+	int checked = 0;
+	int mismatches = 0;
+
+	for (int i = 1; i <= PEERS; i++) {
+		for (int j = 1; j < ENTITIES; j++) {
+
+			if (!sim.is_relevant(i, j))
+				continue;
+
+			checked++;
+			Spatial *server_entity = sim.get_entity(0, j);
+			Spatial *client_entity = sim.get_entity(i, j);
+
+			if (client_entity->get_translation().distance_to(server_entity->get_translation()) > QUANTIZATION || client_entity->is_visible() != server_entity->is_visible()) {
+				mismatches++;
+			}
+		}
+	}
+
+	bool hidden_untouched = sim.get_entity(1, 0)->get_translation() == Vector3();
+
+	// Nothing changed since the last acknowledged snapshot, so nothing is sent.
+	int packets_before = sim.network[0]->sent_packets;
+	sim.tick(false, 0);
+	int idle_packets = sim.network[0]->sent_packets - packets_before;
+
+	OS::get_singleton()->print("\trelevant entities checked: %i, mismatches: %i\n", checked, mismatches);
+	OS::get_singleton()->print("\thidden entity untouched: %s, packets sent while idle: %i\n", hidden_untouched ? "yes" : "no", idle_packets);
+
+	sim.cleanup();
+
+	return checked > 0 && mismatches == 0 && hidden_untouched && idle_packets == 0;
+}
+
+bool test_replication_late_spawn(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 2: Nodes spawned late on a client still receive the state sent before\n");
+
+	Simulation sim;
+	sim.setup(p_tree);
+
+	// The last client gets the last snapshot of each tick, so last_packet is its own.
+	int client = PEERS;
+
+	// A standing entity the client sees, its state is only sent until acknowledged.
+	int late = -1;
+	for (int j = 2; j < ENTITIES && late < 0; j++) {
+		if (j % 4 != 0 && sim.is_relevant(client, j)) {
+			late = j;
+		}
+	}
+	if (late < 0) {
+		OS::get_singleton()->print("\tno relevant standing entity for the last client\n");
+		sim.cleanup();
+		return false;
+	}
+
+	// Not spawned on that client yet: nothing resolves at its path.
+	Spatial *client_entity = sim.get_entity(client, late);
+	sim.apis[client]->stop_replicating(client_entity);
+	client_entity->set_name("Unspawned");
+
+	sim.tick(false, 0);
+	int full_size = sim.network[0]->last_packet.size();
+
+	for (int i = 0; i < SETTLE_TICKS; i++) {
+		sim.tick(true, 0);
+	}
+	for (int i = 0; i < SETTLE_TICKS; i++) {
+		sim.tick(false, 0);
+	}
+
+	// The rest is acknowledged, only the missing entity is sent again.
+	int packets_before = sim.network[0]->sent_packets;
+	sim.tick(false, 0);
+	int unspawned_packets = sim.network[0]->sent_packets - packets_before;
+	int unspawned_size = sim.network[0]->last_packet.size();
+	OS::get_singleton()->print("\tsnapshot while missing: %i packets, %i bytes (first snapshot %i bytes)\n", unspawned_packets, unspawned_size, full_size);
+
+	client_entity->set_name("Entity" + itos(late));
+	sim.apis[client]->replicate_property(client_entity, "translation", QUANTIZATION);
+	sim.apis[client]->replicate_property(client_entity, "visible");
+
+	for (int i = 0; i < SETTLE_TICKS; i++) {
+		sim.tick(false, 0);
+	}
+
+	Vector3 expected = sim.get_entity(0, late)->get_translation();
+	float error = client_entity->get_translation().distance_to(expected);
+	OS::get_singleton()->print("\tentity %i error after spawning: %f\n", late, error);
+
+	// Once spawned, the client acknowledges it too and the server goes back to deltas.
+	packets_before = sim.network[0]->sent_packets;
+	sim.tick(false, 0);
+	int idle_packets = sim.network[0]->sent_packets - packets_before;
+	OS::get_singleton()->print("\tpackets sent while idle: %i\n", idle_packets);
+
+	sim.cleanup();
+
+	return unspawned_packets == 1 && unspawned_size < full_size && error <= QUANTIZATION && idle_packets == 0;
+}
+
+bool test_replication_benchmark(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 3: Bandwidth and cost with %i peers and %i entities\n", PEERS, ENTITIES);
+
+	Simulation sim;
+	sim.setup(p_tree);
+
+	// Warm up path caches and baselines.
+	for (int i = 0; i < SETTLE_TICKS; i++) {
+		sim.tick(false, 0);
+	}
+
+	int packets_before = sim.network[0]->sent_packets;
+	uint64_t bytes_before = sim.network[0]->sent_bytes;
+	sim.snapshot_usec = 0;
+	sim.ticks = 0;
+
+	for (int i = 0; i < MOVING_TICKS; i++) {
+		sim.tick(true, 0);
+	}
+
+	uint64_t bytes = sim.network[0]->sent_bytes - bytes_before;
+	int packets = sim.network[0]->sent_packets - packets_before;
+
+	// What calling rset() on every property of every entity would take, with
+	// the command, path ID, property name and encode_variant() value.
+	uint64_t naive = uint64_t(PEERS) * ENTITIES * MOVING_TICKS * ((1 + 4 + 12 + 16) + (1 + 4 + 8 + 8));
+
+	OS::get_singleton()->print("\tserver sent %i packets, %i bytes (%.1f bytes per peer per tick)\n", packets, int(bytes), double(bytes) / (PEERS * MOVING_TICKS));
+	OS::get_singleton()->print("\tfull state with rset() would be %i bytes (%.2f%%)\n", int(naive), bytes * 100.0 / naive);
+	OS::get_singleton()->print("\tsnapshot cost: %i usec per tick\n", int(sim.snapshot_usec / sim.ticks));
+
+	bool within_budget = bytes <= uint64_t(BUDGET) * PEERS * MOVING_TICKS;
+
+	sim.cleanup();
+
+	return bytes < naive && within_budget;
+}
+
+// Created through ClassDB, the tests don't see the module headers.
+static Ref<NetworkedMultiplayerPeer> _make_enet_peer(bool p_io_thread) {
+
+	Ref<NetworkedMultiplayerPeer> peer = Object::cast_to<NetworkedMultiplayerPeer>(ClassDB::instance("NetworkedMultiplayerENet"));
+	if (peer.is_valid()) {
+		peer->set("io_thread", p_io_thread);
+	}
+	return peer;
+}
+
+// Polls the clients (and the server, unless told not to) for p_msec, or until
+// p_client has a packet.
+static void _poll_enet(NetworkedMultiplayerPeer *p_server, bool p_poll_server, NetworkedMultiplayerPeer *p_client, int p_msec, bool p_until_packet = false) {
+
+	uint64_t end = OS::get_singleton()->get_ticks_msec() + p_msec;
+	while (OS::get_singleton()->get_ticks_msec() < end) {
+		if (p_poll_server) {
+			p_server->poll();
+		}
+		p_client->poll();
+		if (p_until_packet && p_client->get_available_packet_count()) {
+			return;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+}
+
+static bool _send_enet(NetworkedMultiplayerPeer *p_from, int p_to) {
+
+	uint8_t data[4] = { 1, 2, 3, 4 };
+	p_from->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	p_from->set_target_peer(p_to);
+	return p_from->put_packet(data, 4) == OK;
+}
+
+bool test_enet_io_thread_reused_peer(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 4: ENet I/O thread drops commands for a peer reused by a new connection\n");
+
+	Ref<NetworkedMultiplayerPeer> server = _make_enet_peer(true);
+	if (server.is_null()) {
+		OS::get_singleton()->print("\tENet module not available, skipped\n");
+		return true;
+	}
+
+	// A single slot, so the second client is given the peer the first one left.
+	int port = 0;
+	for (int p = 18400; p < 18500; p++) {
+		if (Error(int(server->call("create_server", p, 1))) == OK) {
+			port = p;
+			break;
+		}
+	}
+	if (!port) {
+		OS::get_singleton()->print("\tunable to listen on localhost\n");
+		return false;
+	}
+
+	Ref<NetworkedMultiplayerPeer> first = _make_enet_peer(false);
+	first->call("create_client", "127.0.0.1", port);
+	_poll_enet(server.ptr(), true, first.ptr(), ENET_TIMEOUT_MSEC / 4);
+	int first_id = first->get_unique_id();
+
+	bool first_received = _send_enet(server.ptr(), first_id);
+	_poll_enet(server.ptr(), true, first.ptr(), ENET_TIMEOUT_MSEC, true);
+	first_received = first_received && first->get_available_packet_count() == 1;
+	first->call("close_connection");
+
+	// The server's main thread doesn't poll: the I/O thread alone sees the first
+	// client leave and the second one take its peer, the main thread still maps
+	// the first client's ID to it.
+	Ref<NetworkedMultiplayerPeer> second = _make_enet_peer(false);
+	second->call("create_client", "127.0.0.1", port);
+	uint64_t end = OS::get_singleton()->get_ticks_msec() + ENET_TIMEOUT_MSEC;
+	while (second->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED && OS::get_singleton()->get_ticks_msec() < end) {
+		second->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	bool second_connected = second->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED;
+	_poll_enet(server.ptr(), false, second.ptr(), ENET_TIMEOUT_MSEC / 20); // Let the server see the handshake complete.
+
+	_send_enet(server.ptr(), first_id);
+	_poll_enet(server.ptr(), false, second.ptr(), ENET_TIMEOUT_MSEC / 10, true);
+	int stale_packets = second->get_available_packet_count();
+
+	// Once the main thread catches up, the second client is reachable.
+	_poll_enet(server.ptr(), true, second.ptr(), ENET_TIMEOUT_MSEC / 10);
+	bool second_received = _send_enet(server.ptr(), second->get_unique_id());
+	_poll_enet(server.ptr(), true, second.ptr(), ENET_TIMEOUT_MSEC, true);
+	second_received = second_received && second->get_available_packet_count() == 1;
+
+	OS::get_singleton()->print("\tfirst client received: %s, second connected: %s\n", first_received ? "yes" : "no", second_connected ? "yes" : "no");
+	OS::get_singleton()->print("\tpackets for the first client delivered to the second: %i, second client received: %s\n", stale_packets, second_received ? "yes" : "no");
+
+	second->call("close_connection");
+	server->call("close_connection");
+
+	return first_received && second_connected && stale_packets == 0 && second_received;
+}
+
+// Remembers the values it was called with, in order.
+class RPCReceiver : public Node {
+
+	GDCLASS(RPCReceiver, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("record", "value"), &RPCReceiver::record);
+	}
+
+public:
+	Vector<int> values;
+
+	void record(int p_value) { values.push_back(p_value); }
+
+	RPCReceiver() { rpc_config("record", MultiplayerAPI::RPC_MODE_REMOTE); }
+};
+
+static void _send_record(MultiplayerAPI *p_api, Node *p_node, int p_to, int p_value) {
+
+	Variant value = p_value;
+	const Variant *args[1] = { &value };
+	p_api->rpcp(p_node, p_to, false, "record", args, 1);
+}
+
+bool test_rpc_batching(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 5: Batched RPCs are broadcast once and decoded in order\n");
+
+	const int clients = 3;
+	const int calls = 10;
+
+	RandomPCG rng;
+	Vector<LoopbackPeer *> network;
+	Vector<Ref<LoopbackPeer> > peers;
+	Vector<Ref<MultiplayerAPI> > api_refs;
+	Vector<MultiplayerAPI *> apis;
+	Vector<Node *> roots;
+	Vector<RPCReceiver *> receivers;
+
+	for (int i = 0; i <= clients; i++) {
+
+		Node *root = memnew(Node);
+		root->set_name(i == 0 ? String("RPCServer") : "RPCClient" + itos(i));
+		p_tree->get_root()->add_child(root);
+		roots.push_back(root);
+
+		RPCReceiver *receiver = memnew(RPCReceiver);
+		receiver->set_name("Receiver");
+		root->add_child(receiver);
+		receivers.push_back(receiver);
+
+		Ref<LoopbackPeer> peer;
+		peer.instance();
+		peer->network = &network;
+		peer->rng = &rng;
+		peer->id = i + 1;
+		network.push_back(peer.ptr());
+		peers.push_back(peer);
+
+		Ref<MultiplayerAPI> api;
+		api.instance();
+		api->set_root_node(root);
+		api->set_network_peer(peer);
+		api->set_rpc_batching_enabled(true);
+		api_refs.push_back(api);
+		apis.push_back(api.ptr());
+	}
+
+	for (int i = 1; i <= clients; i++) {
+		network[0]->emit_signal("peer_connected", i + 1);
+		network[i]->emit_signal("peer_connected", 1);
+	}
+
+	// The first call also sends the path and method name, which the clients confirm.
+	_send_record(apis[0], receivers[0], 0, -1);
+	apis[0]->flush_rpc_batches();
+	for (int i = 1; i <= clients; i++) {
+		apis[i]->poll();
+	}
+	apis[0]->poll();
+
+	int packets_before = network[0]->sent_packets;
+	for (int i = 0; i < calls; i++) {
+		_send_record(apis[0], receivers[0], 0, i);
+	}
+	apis[0]->flush_rpc_batches();
+	int broadcast_packets = network[0]->sent_packets - packets_before;
+	bool batch_header = network[0]->last_packet.size() > 0 && network[0]->last_packet[0] == MultiplayerAPI::NETWORK_COMMAND_BATCH;
+
+	// A call to one client followed by a broadcast must reach it in that order.
+	_send_record(apis[0], receivers[0], 2, 100);
+	_send_record(apis[0], receivers[0], 0, 101);
+	apis[0]->flush_rpc_batches();
+
+	for (int i = 1; i <= clients; i++) {
+		apis[i]->poll();
+	}
+
+	bool in_order = true;
+	for (int i = 1; i <= clients; i++) {
+
+		Vector<int> expected;
+		expected.push_back(-1);
+		for (int j = 0; j < calls; j++) {
+			expected.push_back(j);
+		}
+		if (i + 1 == 2) {
+			expected.push_back(100);
+		}
+		expected.push_back(101);
+
+		const Vector<int> &values = receivers[i]->values;
+		bool match = values.size() == expected.size();
+		for (int j = 0; match && j < values.size(); j++) {
+			match = values[j] == expected[j];
+		}
+		if (!match) {
+			OS::get_singleton()->print("\tclient %i received %i calls out of order\n", i + 1, values.size());
+			in_order = false;
+		}
+	}
+
+	// What was queued for a peer alone is dropped when it leaves.
+	_send_record(apis[0], receivers[0], 3, 200);
+	packets_before = network[0]->sent_packets;
+	network[0]->emit_signal("peer_disconnected", 3);
+	apis[0]->flush_rpc_batches();
+	int packets_after_disconnect = network[0]->sent_packets - packets_before;
+
+	OS::get_singleton()->print("\tpackets for %i broadcast calls: %i, batch header: %s\n", calls, broadcast_packets, batch_header ? "yes" : "no");
+	OS::get_singleton()->print("\tpackets sent to a disconnected peer: %i\n", packets_after_disconnect);
+
+	for (int i = 0; i < apis.size(); i++) {
+		apis[i]->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	}
+	for (int i = 0; i < roots.size(); i++) {
+		memdelete(roots[i]);
+	}
+
+	return broadcast_packets == 1 && batch_header && in_order && packets_after_disconnect == 0;
+}
+
+typedef bool (*TestFunc)(SceneTree *);
+
+TestFunc test_funcs[] = {
+	test_replication_converges,
+	test_replication_late_spawn,
+	test_replication_benchmark,
+	test_enet_io_thread_reused_peer,
+	test_rpc_batching,
+	NULL
+};
+
+class TestMainLoop : public SceneTree {
+
+public:
+	virtual void init() {
+
+		SceneTree::init();
+
+		int count = 0;
+		int passed = 0;
+
+		while (true) {
+			if (!test_funcs[count])
+				break;
+			bool pass = test_funcs[count](this);
+			if (pass)
+				passed++;
+			OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+			count++;
+		}
+		OS::get_singleton()->print("\n");
+		OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+		quit();
+	}
+};
+
+MainLoop *test() {
+
+	return memnew(TestMainLoop);
+}
+
+} // namespace TestMultiplayer
@@ -0,0 +1,389 @@
+/*************************************************************************/
+/*  test_net_socket.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_net_socket.h"
+
+#include "core/io/net_socket.h"
+#include "core/io/packet_peer_udp.h"
+#include "core/io/stream_peer_tcp.h"
+#include "core/io/tcp_server.h"
+#include "core/os/os.h"
+
+namespace TestNetSocket {
+
+// Each connection uses two descriptors in this process, raise the open file
+// limit before increasing it.
+static const int CONNECTIONS = 400;
+static const int ACTIVE_EVERY = 20;
+static const int ROUNDS = 200;
+
+// Datagrams are sent in bursts small enough for the receive socket buffer.
+static const int UDP_PACKETS = 20000;
+static const int UDP_BURST = 64;
+static const int UDP_SIZE = 512;
+
+struct LoadTest {
+
+	Ref<TCP_Server> server;
+	Vector<Ref<StreamPeerTCP> > clients;
+	Vector<Ref<StreamPeerTCP> > accepted;
+	Ref<NetSocketPoller> poller;
+
+	bool setup() {
+
+		server.instance();
+		int port = 0;
+		for (int p = 18200; p < 18300; p++) {
+			if (server->listen(p, IP_Address("127.0.0.1")) == OK) {
+				port = p;
+				break;
+			}
+		}
+		if (!port) {
+			OS::get_singleton()->print("\tunable to listen on localhost\n");
+			return false;
+		}
+
+		for (int i = 0; i < CONNECTIONS; i++) {
+			Ref<StreamPeerTCP> client;
+			client.instance();
+			if (client->connect_to_host(IP_Address("127.0.0.1"), port) != OK)
+				return false;
+			clients.push_back(client);
+
+			// Accept as we go, so the listen backlog never fills up.
+			while (server->is_connection_available()) {
+				accepted.push_back(server->take_connection());
+			}
+		}
+
+		uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 5000;
+		while (accepted.size() < CONNECTIONS && OS::get_singleton()->get_ticks_msec() < deadline) {
+			if (server->is_connection_available()) {
+				accepted.push_back(server->take_connection());
+			} else {
+				OS::get_singleton()->delay_usec(1000);
+			}
+		}
+
+		for (int i = 0; i < clients.size(); i++) {
+			while (clients.write[i]->get_status() == StreamPeerTCP::STATUS_CONNECTING) {
+				OS::get_singleton()->delay_usec(100);
+			}
+		}
+
+		poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+		if (poller.is_null()) {
+			OS::get_singleton()->print("\tno NetSocketPoller on this platform\n");
+			return false;
+		}
+		for (int i = 0; i < accepted.size(); i++) {
+			if (poller->add(accepted[i]->get_net_socket(), NetSocket::POLL_TYPE_IN, (void *)(intptr_t)i) != OK)
+				return false;
+		}
+
+		OS::get_singleton()->print("\tconnections: %i\n", accepted.size());
+		return accepted.size() == CONNECTIONS;
+	}
+
+	// Writes a byte from every ACTIVE_EVERY-th client, then reads it back.
+	void send_from_active() {
+		uint8_t b = 1;
+		for (int i = 0; i < clients.size(); i += ACTIVE_EVERY) {
+			clients.write[i]->put_data(&b, 1);
+		}
+	}
+
+	void drain(int p_index) {
+		uint8_t b;
+		int read;
+		accepted.write[p_index]->get_partial_data(&b, 1, read);
+	}
+
+	void stop() {
+		for (int i = 0; i < accepted.size(); i++) {
+			poller->remove(accepted[i]->get_net_socket());
+		}
+		accepted.clear();
+		clients.clear();
+		server->stop();
+	}
+};
+
+bool test_ready_sockets() {
+
+	OS::get_singleton()->print("\n\nTest 1: Only sockets with data are reported\n");
+
+	LoadTest lt;
+	if (!lt.setup())
+		return false;
+
+	Vector<NetSocketPoller::Event> events;
+	events.resize(CONNECTIONS);
+
+	bool pass = lt.poller->wait(events.ptrw(), events.size(), 0) == 0;
+
+	lt.send_from_active();
+
+	int expected = (CONNECTIONS + ACTIVE_EVERY - 1) / ACTIVE_EVERY;
+	Vector<bool> seen;
+	seen.resize(CONNECTIONS);
+	for (int i = 0; i < CONNECTIONS; i++) {
+		seen.write[i] = false;
+	}
+
+	int found = 0;
+	uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 2000;
+	while (found < expected && OS::get_singleton()->get_ticks_msec() < deadline) {
+		int count = lt.poller->wait(events.ptrw(), events.size(), 100);
+		for (int i = 0; i < count; i++) {
+			int index = (intptr_t)events[i].userdata;
+			if (index % ACTIVE_EVERY || !events[i].readable || seen[index]) {
+				pass = false;
+				continue;
+			}
+			seen.write[index] = true;
+			lt.drain(index);
+			found++;
+		}
+	}
+
+	lt.stop();
+	return pass && found == expected;
+}
+
+bool test_benchmark() {
+
+	OS::get_singleton()->print("\n\nTest 2: Readiness checks for mostly idle connections\n");
+
+	LoadTest lt;
+	if (!lt.setup())
+		return false;
+
+	Vector<NetSocketPoller::Event> events;
+	events.resize(CONNECTIONS);
+	int expected = (CONNECTIONS + ACTIVE_EVERY - 1) / ACTIVE_EVERY;
+
+	// What servers did so far: one poll() per socket, every frame.
+	uint64_t per_socket = 0;
+	int found_per_socket = 0;
+	for (int r = 0; r < ROUNDS; r++) {
+		lt.send_from_active();
+		OS::get_singleton()->delay_usec(200);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < lt.accepted.size(); i++) {
+			if (lt.accepted[i]->get_net_socket()->poll(NetSocket::POLL_TYPE_IN, 0) == OK) {
+				lt.drain(i);
+				found_per_socket++;
+			}
+		}
+		per_socket += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	uint64_t multiplexed = 0;
+	int found_multiplexed = 0;
+	for (int r = 0; r < ROUNDS; r++) {
+		lt.send_from_active();
+		OS::get_singleton()->delay_usec(200);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		int count = lt.poller->wait(events.ptrw(), events.size(), 0);
+		for (int i = 0; i < count; i++) {
+			lt.drain((intptr_t)events[i].userdata);
+			found_multiplexed++;
+		}
+		multiplexed += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	lt.stop();
+
+	OS::get_singleton()->print("\tactive per round: %i of %i\n", expected, CONNECTIONS);
+	OS::get_singleton()->print("\tNetSocket::poll per socket: %i usec (%i ready)\n", int(per_socket), found_per_socket);
+	OS::get_singleton()->print("\tNetSocketPoller::wait: %i usec (%i ready)\n", int(multiplexed), found_multiplexed);
+
+	return found_multiplexed > 0 && found_per_socket > 0;
+}
+
+struct UDPTest {
+
+	Ref<PacketPeerUDP> receiver;
+	Ref<PacketPeerUDP> sender;
+	Vector<uint8_t> payload;
+	Vector<const uint8_t *> buffers;
+	Vector<int> sizes;
+
+	bool setup() {
+
+		receiver.instance();
+		int port = 0;
+		for (int p = 18300; p < 18400; p++) {
+			if (receiver->listen(p, IP_Address("127.0.0.1"), 1 << 20) == OK) {
+				port = p;
+				break;
+			}
+		}
+		if (!port) {
+			OS::get_singleton()->print("\tunable to listen on localhost\n");
+			return false;
+		}
+
+		sender.instance();
+		sender->set_dest_address(IP_Address("127.0.0.1"), port);
+
+		payload.resize(UDP_BURST * UDP_SIZE);
+		buffers.resize(UDP_BURST);
+		sizes.resize(UDP_BURST);
+		for (int i = 0; i < UDP_BURST; i++) {
+			buffers.write[i] = payload.ptr() + i * UDP_SIZE;
+			sizes.write[i] = UDP_SIZE;
+		}
+		return true;
+	}
+
+	// Stamps each datagram of the burst with its sequence number.
+	void stamp(int p_first) {
+		uint8_t *w = payload.ptrw();
+		for (int i = 0; i < UDP_BURST; i++) {
+			encode_uint32(p_first + i, w + i * UDP_SIZE);
+			memset(w + i * UDP_SIZE + 4, (p_first + i) & 0xFF, UDP_SIZE - 4);
+		}
+	}
+
+	// Returns how many datagrams arrived in order and intact.
+	int receive(int p_first, int p_count) {
+		int ok = 0;
+		uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 1000;
+		while (ok < p_count && OS::get_singleton()->get_ticks_msec() < deadline) {
+			const uint8_t *buffer;
+			int size;
+			if (receiver->get_packet(&buffer, size) != OK)
+				continue;
+			int seq = p_first + ok;
+			if (size != UDP_SIZE || (int)decode_uint32(buffer) != seq || buffer[size - 1] != (seq & 0xFF))
+				return ok;
+			ok++;
+		}
+		return ok;
+	}
+
+	void stop() {
+		receiver->close();
+		sender->close();
+	}
+};
+
+bool test_udp_batch() {
+
+	OS::get_singleton()->print("\n\nTest 3: Batched UDP send and receive\n");
+
+	UDPTest ut;
+	if (!ut.setup())
+		return false;
+
+	ut.stamp(0);
+	bool pass = ut.sender->put_packets(ut.buffers.ptr(), ut.sizes.ptr(), UDP_BURST) == OK;
+	pass = pass && ut.receive(0, UDP_BURST) == UDP_BURST;
+	pass = pass && ut.receiver->get_available_packet_count() == 0;
+
+	// Packets come from the sender's address.
+	pass = pass && ut.receiver->get_packet_address() == IP_Address("127.0.0.1");
+
+	ut.stop();
+	return pass;
+}
+
+bool test_udp_benchmark() {
+
+	OS::get_singleton()->print("\n\nTest 4: UDP throughput on localhost\n");
+
+	UDPTest ut;
+	if (!ut.setup())
+		return false;
+
+	uint64_t single = 0;
+	int received_single = 0;
+	for (int i = 0; i < UDP_PACKETS; i += UDP_BURST) {
+		ut.stamp(i);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < UDP_BURST; j++) {
+			ut.sender->put_packet(ut.buffers[j], UDP_SIZE);
+		}
+		received_single += ut.receive(i, UDP_BURST);
+		single += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	uint64_t batched = 0;
+	int received_batched = 0;
+	for (int i = 0; i < UDP_PACKETS; i += UDP_BURST) {
+		ut.stamp(i);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ut.sender->put_packets(ut.buffers.ptr(), ut.sizes.ptr(), UDP_BURST);
+		received_batched += ut.receive(i, UDP_BURST);
+		batched += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	ut.stop();
+
+	OS::get_singleton()->print("\tput_packet: %i usec (%i of %i received)\n", int(single), received_single, UDP_PACKETS);
+	OS::get_singleton()->print("\tput_packets: %i usec (%i of %i received)\n", int(batched), received_batched, UDP_PACKETS);
+
+	return received_batched > 0 && received_single > 0;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_ready_sockets,
+	test_benchmark,
+	test_udp_batch,
+	test_udp_benchmark,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+
+} // namespace TestNetSocket
@@ -0,0 +1,225 @@
+/*************************************************************************/
+/*  test_pool_vector.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_pool_vector.h"
+
+#include "core/os/os.h"
+#include "core/pool_vector.h"
+#include "core/variant.h"
+
+namespace TestPoolVector {
+
+static PoolVector<int> _make_vector(int p_size) {
+
+	PoolVector<int> v;
+	v.resize(p_size);
+	PoolVector<int>::Write w = v.write();
+	for (int i = 0; i < p_size; i++) {
+		w[i] = i;
+	}
+	return v;
+}
+
+static bool _check_contents(const PoolVector<int> &p_vector, int p_size) {
+
+	if (p_vector.size() != p_size) {
+		OS::get_singleton()->print("\tsize %i != %i\n", p_vector.size(), p_size);
+		return false;
+	}
+
+	PoolVector<int>::Read r = p_vector.read();
+	for (int i = 0; i < p_size; i++) {
+		if (r[i] != i) {
+			OS::get_singleton()->print("\telement %i is %i\n", i, r[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_move_constructor() {
+
+	OS::get_singleton()->print("\n\nTest 1: Move constructor steals the buffer\n");
+
+	PoolVector<int> a = _make_vector(64);
+	const int *mem = a.ptr();
+
+	PoolVector<int> b(static_cast<PoolVector<int> &&>(a));
+
+	if (a.size() != 0 || a.ptr() != NULL) {
+		OS::get_singleton()->print("\tmoved-from vector is not empty\n");
+		return false;
+	}
+	if (b.ptr() != mem || b.is_shared()) {
+		OS::get_singleton()->print("\tbuffer was copied or shared\n");
+		return false;
+	}
+
+	return _check_contents(b, 64);
+}
+
+bool test_move_assignment() {
+
+	OS::get_singleton()->print("\n\nTest 2: Move assignment steals the buffer and drops the old one\n");
+
+	PoolVector<int> a = _make_vector(32);
+	PoolVector<int> b = _make_vector(8);
+	PoolVector<int> old = b;
+	const int *mem = a.ptr();
+
+	b = static_cast<PoolVector<int> &&>(a);
+
+	if (a.size() != 0) {
+		OS::get_singleton()->print("\tmoved-from vector is not empty\n");
+		return false;
+	}
+	if (b.ptr() != mem || b.is_shared()) {
+		OS::get_singleton()->print("\tbuffer was copied or shared\n");
+		return false;
+	}
+	if (old.is_shared()) {
+		OS::get_singleton()->print("\tprevious buffer still has a reference\n");
+		return false;
+	}
+
+	// Self move assignment must keep the buffer.
+	PoolVector<int> &self = b;
+	b = static_cast<PoolVector<int> &&>(self);
+
+	return _check_contents(b, 32) && _check_contents(old, 8);
+}
+
+bool test_is_shared() {
+
+	OS::get_singleton()->print("\n\nTest 3: is_shared() follows the reference count\n");
+
+	PoolVector<int> a;
+	if (a.is_shared()) {
+		OS::get_singleton()->print("\tempty vector is shared\n");
+		return false;
+	}
+
+	a = _make_vector(16);
+	if (a.is_shared()) {
+		OS::get_singleton()->print("\tunique vector is shared\n");
+		return false;
+	}
+
+	{
+		PoolVector<int> b = a;
+		if (!a.is_shared() || !b.is_shared()) {
+			OS::get_singleton()->print("\tcopy is not shared\n");
+			return false;
+		}
+	}
+
+	if (a.is_shared()) {
+		OS::get_singleton()->print("\tstill shared after the copy went away\n");
+		return false;
+	}
+
+	{
+		// Reading a buffer back out of a Variant holds a reference as long
+		// as the Variant lives.
+		Variant var = a;
+		PoolVector<int> c = var;
+		if (!c.is_shared()) {
+			OS::get_singleton()->print("\tbuffer read from a Variant is not shared\n");
+			return false;
+		}
+	}
+
+	return !a.is_shared();
+}
+
+bool test_ptrw_copy_on_write() {
+
+	OS::get_singleton()->print("\n\nTest 4: ptrw() copies a shared buffer before writing\n");
+
+	PoolVector<int> a = _make_vector(16);
+	PoolVector<int> b = a;
+
+	if (a.ptr() != b.ptr()) {
+		OS::get_singleton()->print("\tcopy does not share the buffer\n");
+		return false;
+	}
+
+	int *w = b.ptrw();
+	if (w == a.ptr()) {
+		OS::get_singleton()->print("\tptrw() did not copy the shared buffer\n");
+		return false;
+	}
+	w[0] = 100;
+
+	if (a.ptr()[0] != 0 || b.ptr()[0] != 100) {
+		OS::get_singleton()->print("\twrite leaked into the other vector\n");
+		return false;
+	}
+
+	// Unique now, so a second ptrw() must not copy again.
+	if (b.ptrw() != w) {
+		OS::get_singleton()->print("\tptrw() copied a unique buffer\n");
+		return false;
+	}
+
+	return !a.is_shared() && !b.is_shared() && _check_contents(a, 16);
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_move_constructor,
+	test_move_assignment,
+	test_is_shared,
+	test_ptrw_copy_on_write,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+
+} // namespace TestPoolVector
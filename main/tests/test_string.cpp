@@ -1121,6 +1121,41 @@ bool test_35() {
 	return state;
 }
 
+bool test_36() {
+#define SNAME_TEST(x)                                            \
+	{                                                            \
+		bool success = x;                                        \
+		state = state && success;                                \
+		if (!success) {                                          \
+			OS::get_singleton()->print("\tfailed at: %s\n", #x); \
+		}                                                        \
+	}
+
+	OS::get_singleton()->print("\n\nTest 36: StringName interning\n");
+	bool state = true;
+
+	SNAME_TEST(StaticCString::compute_hash("Godot") == String::hash("Godot"));
+	SNAME_TEST(StaticCString::compute_hash("") == String::hash(""));
+	SNAME_TEST(SNAME("test_36_name") == StringName("test_36_name"));
+	SNAME_TEST(SNAME("test_36_name") == StringName(String("test_36_name")));
+
+	// Enough names to force the shards to grow, then look all of them up again.
+	Vector<StringName> names;
+	for (int i = 0; i < 20000; i++) {
+		names.push_back(StringName("test_36_" + itos(i)));
+	}
+	for (int i = 0; i < names.size(); i++) {
+		if (StringName::search("test_36_" + itos(i)) != names[i]) {
+			SNAME_TEST(StringName::search("test_36_" + itos(i)) == names[i]);
+			break;
+		}
+	}
+	names.clear();
+	SNAME_TEST(StringName::search(String("test_36_0")) == StringName());
+
+	return state;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -1160,6 +1195,7 @@ TestFunc test_funcs[] = {
 	test_33,
 	test_34,
 	test_35,
+	test_36,
 	0
 
 };
@@ -0,0 +1,213 @@
+/*************************************************************************/
+/*  test_tile_map.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_tile_map.h"
+
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "scene/2d/tile_map.h"
+
+namespace TestTileMap {
+
+static const int CHUNK_SIZE = 4;
+static const int CHUNKS = 3; // In a row, from (0, 0).
+
+static String _get_path(const String &p_name) {
+
+	return OS::get_singleton()->get_cache_path().plus_file(p_name);
+}
+
+// Sets the stored properties in the order a saved scene does.
+static void _copy_stored_properties(const Object *p_from, Object *p_to) {
+
+	List<PropertyInfo> properties;
+	p_from->get_property_list(&properties);
+	for (List<PropertyInfo>::Element *E = properties.front(); E; E = E->next()) {
+		if (E->get().usage & PROPERTY_USAGE_STORAGE) {
+			p_to->set(E->get().name, p_from->get(E->get().name));
+		}
+	}
+}
+
+static bool _check_cells(const TileMap *p_map, const char *p_what) {
+
+	// Chunk 0 lost (1, 1), chunk 1 lost everything and chunk 2 is untouched.
+	int expected = CHUNK_SIZE * CHUNK_SIZE * CHUNKS - 1 - CHUNK_SIZE * CHUNK_SIZE;
+	int used = p_map->get_used_cells().size();
+	bool erased = p_map->get_cell(1, 1) == TileMap::INVALID_CELL && p_map->get_cell(CHUNK_SIZE, 0) == TileMap::INVALID_CELL;
+	bool kept = p_map->get_cell(0, 0) == 1 && p_map->get_cell(CHUNK_SIZE * 2, 0) == CHUNK_SIZE * 2 + 1;
+
+	OS::get_singleton()->print("\t%s: %i cells (expected %i), erased cells %s, kept cells %s\n", p_what, used, expected, erased ? "gone" : "back", kept ? "present" : "missing");
+	return used == expected && erased && kept;
+}
+
+bool test_chunk_round_trip() {
+
+	OS::get_singleton()->print("\n\nTest 1: Edits on paged chunks survive saving and reloading\n");
+
+	String path = _get_path("test_tile_map.tchunks");
+	String merged_path = _get_path("test_tile_map_merged.tchunks");
+	String check_path = _get_path("test_tile_map_check.tchunks");
+
+	TileMap *source = memnew(TileMap);
+	for (int y = 0; y < CHUNK_SIZE; y++) {
+		for (int x = 0; x < CHUNK_SIZE * CHUNKS; x++) {
+			source->set_cell(x, y, x + 1);
+		}
+	}
+	Error err = source->save_chunk_file(path, CHUNK_SIZE);
+	memdelete(source);
+	if (err != OK) {
+		OS::get_singleton()->print("\tcan't save '%s'\n", path.utf8().get_data());
+		return false;
+	}
+
+	// Nothing is paged in outside the tree, edits page in the chunk they touch.
+	TileMap *edited = memnew(TileMap);
+	edited->set_streaming_chunk_file(path);
+	edited->set_cell(1, 1, TileMap::INVALID_CELL);
+	for (int y = 0; y < CHUNK_SIZE; y++) {
+		for (int x = CHUNK_SIZE; x < CHUNK_SIZE * 2; x++) {
+			edited->set_cell(x, y, TileMap::INVALID_CELL);
+		}
+	}
+
+	TileMap *loaded = memnew(TileMap);
+	_copy_stored_properties(edited, loaded);
+	memdelete(edited);
+
+	// Writing a chunk file pages in every chunk first.
+	bool pass = loaded->save_chunk_file(merged_path, CHUNK_SIZE) == OK && _check_cells(loaded, "reloaded scene");
+	memdelete(loaded);
+
+	TileMap *merged = memnew(TileMap);
+	merged->set_streaming_chunk_file(merged_path);
+	pass = merged->save_chunk_file(check_path, CHUNK_SIZE) == OK && _check_cells(merged, "merged chunk file") && pass;
+	memdelete(merged);
+
+	DirAccess::remove_file_or_error(path);
+	DirAccess::remove_file_or_error(merged_path);
+	DirAccess::remove_file_or_error(check_path);
+
+	return pass;
+}
+
+struct ChunkFile {
+	const char *name;
+	uint32_t chunk_count;
+	uint32_t cell_count;
+	uint64_t offset;
+	int padding;
+};
+
+bool test_chunk_file_validation() {
+
+	OS::get_singleton()->print("\n\nTest 2: Chunk files with an index pointing past their data are rejected\n");
+
+	static const ChunkFile files[] = {
+		{ "truncated index", 0x10000000, 0, 0, 0 },
+		{ "cells past the end", 1, CHUNK_SIZE * CHUNK_SIZE, 32, 0 },
+		{ "cells in the index", 1, 1, 0, 0 },
+		{ "too many cells", 1, CHUNK_SIZE * CHUNK_SIZE + 1, 32, (CHUNK_SIZE * CHUNK_SIZE + 1) * 10 },
+	};
+
+	String path = _get_path("test_tile_map_corrupt.tchunks");
+	bool pass = true;
+
+	for (uint32_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+
+		const ChunkFile &file = files[i];
+
+		FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+		if (!f) {
+			OS::get_singleton()->print("\tcan't write '%s'\n", path.utf8().get_data());
+			return false;
+		}
+		f->store_buffer((const uint8_t *)"GDTC", 4);
+		f->store_32(1);
+		f->store_32(CHUNK_SIZE);
+		f->store_32(file.chunk_count);
+		if (file.chunk_count == 1) {
+			f->store_16(0);
+			f->store_16(0);
+			f->store_32(file.cell_count);
+			f->store_64(file.offset);
+		}
+		for (int j = 0; j < file.padding; j++) {
+			f->store_8(0);
+		}
+		memdelete(f);
+
+		// An edit pages in its chunk, which must not read anything from a rejected file.
+		TileMap *map = memnew(TileMap);
+		map->set_streaming_chunk_file(path);
+		map->set_cell(1, 1, 5);
+		int used = map->get_used_cells().size();
+		memdelete(map);
+
+		OS::get_singleton()->print("\t%s: %i cells\n", file.name, used);
+		pass = pass && used == 1;
+	}
+
+	DirAccess::remove_file_or_error(path);
+
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+	test_chunk_round_trip,
+	test_chunk_file_validation,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+
+} // namespace TestTileMap
@@ -0,0 +1,224 @@
+/*************************************************************************/
+/*  test_transform.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_transform.h"
+
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/3d/spatial.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+namespace TestTransform {
+
+static const int SETS = 100;
+
+class CountingNode2D : public Node2D {
+
+	GDCLASS(CountingNode2D, Node2D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED)
+			changes++;
+	}
+
+public:
+	int changes;
+
+	CountingNode2D() { changes = 0; }
+};
+
+class CountingSpatial : public Spatial {
+
+	GDCLASS(CountingSpatial, Spatial);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED)
+			changes++;
+	}
+
+public:
+	int changes;
+
+	CountingSpatial() { changes = 0; }
+};
+
+bool test_canvas_item_propagation(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 1: CanvasItem global transforms follow deferred local changes\n");
+
+	Node2D *parent = memnew(Node2D);
+	Node2D *child = memnew(Node2D);
+	Node2D *toplevel = memnew(Node2D);
+	parent->add_child(child);
+	parent->add_child(toplevel);
+	toplevel->set_as_toplevel(true);
+	p_tree->get_root()->add_child(parent);
+
+	child->set_position(Vector2(1, 2));
+	toplevel->set_position(Vector2(5, 5));
+
+	bool ok = true;
+	for (int i = 0; i < SETS; i++) {
+		parent->set_position(Vector2(i, -i));
+		// Reading between writes must flush what is pending so far.
+		ok = ok && child->get_global_position().is_equal_approx(Vector2(i + 1, 2 - i));
+	}
+	parent->set_position(Vector2(10, 20));
+	child->set_rotation(Math_PI);
+
+	ok = ok && child->get_global_position().is_equal_approx(Vector2(11, 22));
+	ok = ok && Math::is_equal_approx(Math::abs(child->get_global_rotation()), (float)Math_PI);
+	ok = ok && toplevel->get_global_position().is_equal_approx(Vector2(5, 5));
+	OS::get_singleton()->print("\tchild: %s, toplevel: %s\n", String(child->get_global_position()).utf8().get_data(), String(toplevel->get_global_position()).utf8().get_data());
+
+	// A detached subtree neither queues nor flushes changes, and must not touch the tree.
+	p_tree->get_root()->remove_child(parent);
+	parent->set_position(Vector2(-1, -1));
+	ok = ok && parent->get_transform().get_origin().is_equal_approx(Vector2(-1, -1));
+	p_tree->get_root()->add_child(parent);
+	ok = ok && child->get_global_position().is_equal_approx(Vector2(0, 1));
+
+	memdelete(parent);
+
+	return ok;
+}
+
+bool test_canvas_item_notifications(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 2: Repeated CanvasItem changes notify once per flush\n");
+
+	Node2D *parent = memnew(Node2D);
+	CountingNode2D *child = memnew(CountingNode2D);
+	parent->add_child(child);
+	child->set_notify_transform(true);
+	p_tree->get_root()->add_child(parent);
+	p_tree->flush_transform_notifications();
+	child->changes = 0;
+
+	for (int i = 0; i < SETS; i++) {
+		parent->set_position(Vector2(i, i));
+		child->set_position(Vector2(-i, i));
+	}
+	p_tree->flush_transform_notifications();
+	int after_sets = child->changes;
+
+	p_tree->flush_transform_notifications();
+	int after_idle = child->changes;
+
+	OS::get_singleton()->print("\tnotifications after %i changes: %i, after an idle flush: %i\n", SETS * 2, after_sets, after_idle);
+
+	bool ok = after_sets == 1 && after_idle == 1 && child->get_global_position().is_equal_approx(Vector2(0, (SETS - 1) * 2));
+
+	memdelete(parent);
+
+	return ok;
+}
+
+bool test_spatial_propagation(SceneTree *p_tree) {
+
+	OS::get_singleton()->print("\n\nTest 3: Spatial global transforms follow deferred local changes\n");
+
+	Spatial *parent = memnew(Spatial);
+	CountingSpatial *child = memnew(CountingSpatial);
+	Spatial *toplevel = memnew(Spatial);
+	parent->add_child(child);
+	child->add_child(toplevel);
+	toplevel->set_as_toplevel(true);
+	child->set_notify_transform(true);
+	p_tree->get_root()->add_child(parent);
+
+	child->set_translation(Vector3(0, 1, 0));
+	toplevel->set_translation(Vector3(5, 5, 5));
+	p_tree->flush_transform_notifications();
+	child->changes = 0;
+
+	bool ok = true;
+	for (int i = 0; i < SETS; i++) {
+		parent->set_translation(Vector3(i, 0, 0));
+		ok = ok && child->get_global_transform().origin.is_equal_approx(Vector3(i, 1, 0));
+	}
+	parent->set_scale(Vector3(2, 2, 2));
+	p_tree->flush_transform_notifications();
+
+	ok = ok && child->get_global_transform().origin.is_equal_approx(Vector3(SETS - 1, 2, 0));
+	ok = ok && toplevel->get_global_transform().origin.is_equal_approx(Vector3(5, 5, 5));
+	OS::get_singleton()->print("\tchild: %s, notifications: %i\n", String(child->get_global_transform().origin).utf8().get_data(), child->changes);
+	ok = ok && child->changes == 1;
+
+	memdelete(parent);
+
+	return ok;
+}
+
+typedef bool (*TestFunc)(SceneTree *);
+
+TestFunc test_funcs[] = {
+	test_canvas_item_propagation,
+	test_canvas_item_notifications,
+	test_spatial_propagation,
+	NULL
+};
+
+class TestMainLoop : public SceneTree {
+
+public:
+	virtual void init() {
+
+		SceneTree::init();
+
+		int count = 0;
+		int passed = 0;
+
+		while (true) {
+			if (!test_funcs[count])
+				break;
+			bool pass = test_funcs[count](this);
+			if (pass)
+				passed++;
+			OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+			count++;
+		}
+		OS::get_singleton()->print("\n");
+		OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+		quit();
+	}
+};
+
+MainLoop *test() {
+
+	return memnew(TestMainLoop);
+}
+
+} // namespace TestTransform
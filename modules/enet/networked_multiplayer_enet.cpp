@@ -118,6 +118,7 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 	refuse_connections = false;
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
+	_start_io_thread();
 	return OK;
 }
 Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_port, int p_in_bandwidth, int p_out_bandwidth, int p_client_port) {
@@ -208,6 +209,7 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 	active = true;
 	server = false;
 	refuse_connections = false;
+	_start_io_thread();
 
 	return OK;
 }
@@ -225,7 +227,16 @@ void NetworkedMultiplayerENet::poll() {
 		if (!host || !active) // Might have been disconnected while emitting a notification
 			return;
 
-		int ret = enet_host_service(host, &event, 0);
+		int ret;
+		if (io_thread) {
+			uint32_t connect_id;
+			ret = _pop_io_event(event, connect_id) ? 1 : 0;
+			if (ret && event.type == ENET_EVENT_TYPE_CONNECT) {
+				connect_ids[event.peer] = connect_id;
+			}
+		} else {
+			ret = enet_host_service(host, &event, 0);
+		}
 
 		if (ret < 0) {
 			// Error, do something?
@@ -239,14 +250,16 @@ void NetworkedMultiplayerENet::poll() {
 				// Store any relevant client information here.
 
 				if (server && refuse_connections) {
-					enet_peer_reset(event.peer);
+					_command(COMMAND_RESET, event.peer);
+					connect_ids.erase(event.peer);
 					break;
 				}
 
 				// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
 				// Probably trying to exploit us.
 				if (server && ((int)event.data < 2 || peer_map.has((int)event.data))) {
-					enet_peer_reset(event.peer);
+					_command(COMMAND_RESET, event.peer);
+					connect_ids.erase(event.peer);
 					ERR_CONTINUE(true);
 				}
 
@@ -279,12 +292,12 @@ void NetworkedMultiplayerENet::poll() {
 						ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
 						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
 						encode_uint32(E->key(), &packet->data[4]);
-						enet_peer_send(event.peer, SYSCH_CONFIG, packet);
+						_command(COMMAND_SEND, event.peer, SYSCH_CONFIG, packet);
 						// Send the new peer to existing peers
 						packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
 						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
 						encode_uint32(*new_id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
+						_command(COMMAND_SEND, E->get(), SYSCH_CONFIG, packet);
 					}
 				} else {
 
@@ -323,13 +336,14 @@ void NetworkedMultiplayerENet::poll() {
 						ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
 						encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
 						encode_uint32(*id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
+						_command(COMMAND_SEND, E->get(), SYSCH_CONFIG, packet);
 					}
 				}
 
 				emit_signal("peer_disconnected", *id);
 				peer_map.erase(*id);
 				memdelete(id);
+				connect_ids.erase(event.peer);
 			} break;
 			case ENET_EVENT_TYPE_RECEIVE: {
 
@@ -374,6 +388,12 @@ void NetworkedMultiplayerENet::poll() {
 					packet.channel = event.channelID;
 
 					if (server) {
+						if (!id) {
+							// Disconnected after the I/O thread queued this.
+							enet_packet_destroy(packet.packet);
+							continue;
+						}
+
 						// Someone is cheating and trying to fake the source!
 						ERR_CONTINUE(source != *id);
 
@@ -397,7 +417,7 @@ void NetworkedMultiplayerENet::poll() {
 
 								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
 
-								enet_peer_send(E->get(), event.channelID, packet2);
+								_command(COMMAND_SEND, E->get(), event.channelID, packet2);
 							}
 
 						} else if (target < 0) {
@@ -411,7 +431,7 @@ void NetworkedMultiplayerENet::poll() {
 
 								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
 
-								enet_peer_send(E->get(), event.channelID, packet2);
+								_command(COMMAND_SEND, E->get(), event.channelID, packet2);
 							}
 
 							if (-target != 1) {
@@ -425,7 +445,7 @@ void NetworkedMultiplayerENet::poll() {
 						} else {
 							// To someone else, specifically
 							ERR_CONTINUE(!peer_map.has(target));
-							enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							_command(COMMAND_SEND, peer_map[target], event.channelID, packet.packet);
 						}
 					} else {
 
@@ -455,6 +475,7 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 
+	_stop_io_thread();
 	_pop_current_packet();
 
 	bool peers_disconnected = false;
@@ -479,6 +500,7 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 	active = false;
 	incoming_packets.clear();
 	peer_map.clear();
+	connect_ids.clear();
 	unique_id = 1; // Server is 1
 	connection_status = CONNECTION_DISCONNECTED;
 }
@@ -491,7 +513,8 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 
 	if (now) {
 		int *id = (int *)peer_map[p_peer]->data;
-		enet_peer_disconnect_now(peer_map[p_peer], 0);
+		peer_map[p_peer]->data = NULL;
+		_command(COMMAND_DISCONNECT_NOW, peer_map[p_peer]);
 
 		// enet_peer_disconnect_now doesn't generate ENET_EVENT_TYPE_DISCONNECT,
 		// notify everyone else, send disconnect signal & remove from peer_map like in poll()
@@ -505,7 +528,7 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 				ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
 				encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
 				encode_uint32(p_peer, &packet->data[4]);
-				enet_peer_send(E->get(), SYSCH_CONFIG, packet);
+				_command(COMMAND_SEND, E->get(), SYSCH_CONFIG, packet);
 			}
 		}
 
@@ -513,9 +536,10 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 			memdelete(id);
 
 		emit_signal("peer_disconnected", p_peer);
+		connect_ids.erase(peer_map[p_peer]);
 		peer_map.erase(p_peer);
 	} else {
-		enet_peer_disconnect_later(peer_map[p_peer], 0);
+		_command(COMMAND_DISCONNECT_LATER, peer_map[p_peer]);
 	}
 }
 
@@ -584,7 +608,7 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 	if (server) {
 
 		if (target_peer == 0) {
-			enet_host_broadcast(host, channel, packet);
+			_command(COMMAND_BROADCAST, NULL, channel, packet);
 		} else if (target_peer < 0) {
 			// Send to all but one
 			// and make copies for sending
@@ -598,20 +622,22 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 
 				ENetPacket *packet2 = enet_packet_create(packet->data, packet->dataLength, packet_flags);
 
-				enet_peer_send(F->get(), channel, packet2);
+				_command(COMMAND_SEND, F->get(), channel, packet2);
 			}
 
 			enet_packet_destroy(packet); // Original packet no longer needed
 		} else {
-			enet_peer_send(E->get(), channel, packet);
+			_command(COMMAND_SEND, E->get(), channel, packet);
 		}
 	} else {
 
 		ERR_FAIL_COND_V(!peer_map.has(1), ERR_BUG);
-		enet_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
+		_command(COMMAND_SEND, peer_map[1], channel, packet); // Send to server for broadcast
 	}
 
-	enet_host_flush(host);
+	if (!io_thread) {
+		enet_host_flush(host); // Otherwise the I/O thread sends it on its next step.
+	}
 
 	return OK;
 }
@@ -858,6 +884,161 @@ bool NetworkedMultiplayerENet::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void NetworkedMultiplayerENet::set_io_thread_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(active, "The I/O thread can't be toggled while the multiplayer instance is active.");
+
+	io_thread_enabled = p_enabled;
+}
+
+bool NetworkedMultiplayerENet::is_io_thread_enabled() const {
+	return io_thread_enabled;
+}
+
+void NetworkedMultiplayerENet::_run_command(const Command &p_command) {
+
+	if (p_command.peer && p_command.peer->connectID != p_command.connect_id) {
+		// The connection is gone, the peer is reset or already serves another one.
+		if (p_command.packet) {
+			enet_packet_destroy(p_command.packet);
+		}
+		return;
+	}
+
+	switch (p_command.type) {
+		case COMMAND_SEND: {
+			if (p_command.peer->state != ENET_PEER_STATE_CONNECTED || enet_peer_send(p_command.peer, p_command.channel, p_command.packet) < 0) {
+				if (p_command.packet->referenceCount == 0) {
+					enet_packet_destroy(p_command.packet); // Not queued, so ENet doesn't own it.
+				}
+			}
+		} break;
+		case COMMAND_BROADCAST: {
+			enet_host_broadcast(host, p_command.channel, p_command.packet);
+		} break;
+		case COMMAND_RESET: {
+			enet_peer_reset(p_command.peer);
+		} break;
+		case COMMAND_DISCONNECT_NOW: {
+			enet_peer_disconnect_now(p_command.peer, p_command.data);
+		} break;
+		case COMMAND_DISCONNECT_LATER: {
+			enet_peer_disconnect_later(p_command.peer, p_command.data);
+		} break;
+	}
+}
+
+void NetworkedMultiplayerENet::_command(CommandType p_type, ENetPeer *p_peer, int p_channel, ENetPacket *p_packet, uint32_t p_data) {
+
+	Command command;
+	command.type = p_type;
+	command.peer = p_peer;
+	command.connect_id = 0;
+	command.channel = p_channel;
+	command.packet = p_packet;
+	command.data = p_data;
+
+	if (!io_thread) {
+		if (p_peer) {
+			command.connect_id = p_peer->connectID;
+		}
+		_run_command(command);
+		return;
+	}
+
+	// The I/O thread may have reset or reused the peer already, don't read it from here.
+	if (p_peer) {
+		Map<ENetPeer *, uint32_t>::Element *E = connect_ids.find(p_peer);
+		command.connect_id = E ? E->get() : 0;
+	}
+
+	MutexLock lock(command_mutex);
+	commands.push_back(command);
+}
+
+bool NetworkedMultiplayerENet::_pop_io_event(ENetEvent &r_event, uint32_t &r_connect_id) {
+
+	MutexLock lock(event_mutex);
+	if (io_events.empty())
+		return false;
+
+	r_event = io_events.front()->get().event;
+	r_connect_id = io_events.front()->get().connect_id;
+	io_events.pop_front();
+	return true;
+}
+
+void NetworkedMultiplayerENet::_io_thread_step() {
+
+	while (true) {
+		Command command;
+		{
+			MutexLock lock(command_mutex);
+			if (commands.empty())
+				break;
+			command = commands.front()->get();
+			commands.pop_front();
+		}
+		_run_command(command);
+	}
+
+	// Wait up to 1 ms for the socket, so the thread sleeps while idle but wakes
+	// up as soon as a packet arrives, then drain whatever else is pending.
+	IOEvent io_event;
+	uint32_t timeout = 1;
+	while (enet_host_service(host, &io_event.event, timeout) > 0) {
+		io_event.connect_id = io_event.event.peer->connectID;
+		MutexLock lock(event_mutex);
+		io_events.push_back(io_event);
+		timeout = 0;
+	}
+
+	enet_host_flush(host);
+}
+
+void NetworkedMultiplayerENet::_io_thread_func(void *p_userdata) {
+
+	NetworkedMultiplayerENet *enet = (NetworkedMultiplayerENet *)p_userdata;
+	while (!enet->io_thread_exit) {
+		enet->_io_thread_step(); // Blocks in enet_host_service() while idle.
+	}
+}
+
+void NetworkedMultiplayerENet::_start_io_thread() {
+
+	if (!io_thread_enabled)
+		return;
+
+	io_thread_exit = false;
+	io_thread = Thread::create(_io_thread_func, this);
+	if (!io_thread) {
+		WARN_PRINT("Unable to start the ENet I/O thread, polling from the main thread instead.");
+	}
+}
+
+void NetworkedMultiplayerENet::_stop_io_thread() {
+
+	if (!io_thread)
+		return;
+
+	io_thread_exit = true;
+	Thread::wait_to_finish(io_thread);
+	memdelete(io_thread);
+	io_thread = NULL;
+
+	// Back on a single thread, run what is left and drop unprocessed events.
+	for (List<Command>::Element *E = commands.front(); E; E = E->next()) {
+		_run_command(E->get());
+	}
+	commands.clear();
+
+	for (List<IOEvent>::Element *E = io_events.front(); E; E = E->next()) {
+		if (E->get().event.type == ENET_EVENT_TYPE_RECEIVE) {
+			enet_packet_destroy(E->get().event.packet);
+		}
+	}
+	io_events.clear();
+}
+
 void NetworkedMultiplayerENet::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("create_server", "port", "max_clients", "in_bandwidth", "out_bandwidth"), &NetworkedMultiplayerENet::create_server, DEFVAL(32), DEFVAL(0), DEFVAL(0));
@@ -886,12 +1067,15 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &NetworkedMultiplayerENet::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &NetworkedMultiplayerENet::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_io_thread_enabled", "enabled"), &NetworkedMultiplayerENet::set_io_thread_enabled);
+	ClassDB::bind_method(D_METHOD("is_io_thread_enabled"), &NetworkedMultiplayerENet::is_io_thread_enabled);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "channel_count"), "set_channel_count", "get_channel_count");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "io_thread"), "set_io_thread_enabled", "is_io_thread_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dtls_verify"), "set_dtls_verify_enabled", "is_dtls_verify_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_dtls"), "set_dtls_enabled", "is_dtls_enabled");
 
@@ -926,6 +1110,12 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 
 	dtls_enabled = false;
 	dtls_verify = true;
+
+	io_thread_enabled = false;
+	io_thread = NULL;
+	io_thread_exit = false;
+	command_mutex = Mutex::create();
+	event_mutex = Mutex::create();
 }
 
 NetworkedMultiplayerENet::~NetworkedMultiplayerENet() {
@@ -933,6 +1123,9 @@ NetworkedMultiplayerENet::~NetworkedMultiplayerENet() {
 	if (active) {
 		close_connection();
 	}
+
+	memdelete(command_mutex);
+	memdelete(event_mutex);
 }
 
 // Sets IP for ENet to bind when using create_server or create_client
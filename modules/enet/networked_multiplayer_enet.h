@@ -34,6 +34,8 @@
 #include "core/crypto/crypto.h"
 #include "core/io/compression.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
 
 #include <enet/enet.h>
 
@@ -112,6 +114,52 @@ private:
 
 	IP_Address bind_ip;
 
+	// With the I/O thread, ENet is only touched by that thread while active:
+	// it services the host (receive, decompress, compress, send) and queues
+	// the events, the main thread queues commands for it.
+	enum CommandType {
+		COMMAND_SEND,
+		COMMAND_BROADCAST,
+		COMMAND_RESET,
+		COMMAND_DISCONNECT_NOW,
+		COMMAND_DISCONNECT_LATER
+	};
+
+	// ENet resets a peer on disconnection and may reuse it for a new one
+	// before the main thread hears of it, commands carry the connection
+	// they were meant for.
+	struct Command {
+		CommandType type;
+		ENetPeer *peer;
+		uint32_t connect_id;
+		ENetPacket *packet;
+		int channel;
+		uint32_t data;
+	};
+
+	struct IOEvent {
+		ENetEvent event;
+		uint32_t connect_id;
+	};
+
+	bool io_thread_enabled;
+	Thread *io_thread;
+	volatile bool io_thread_exit;
+	Mutex *command_mutex;
+	Mutex *event_mutex;
+	List<Command> commands;
+	List<IOEvent> io_events;
+	Map<ENetPeer *, uint32_t> connect_ids; // As last seen by the main thread.
+
+	static void _io_thread_func(void *p_userdata);
+	void _io_thread_step();
+	void _start_io_thread();
+	void _stop_io_thread();
+	bool _pop_io_event(ENetEvent &r_event, uint32_t &r_connect_id);
+
+	void _run_command(const Command &p_command);
+	void _command(CommandType p_type, ENetPeer *p_peer, int p_channel = 0, ENetPacket *p_packet = NULL, uint32_t p_data = 0);
+
 	bool dtls_enabled;
 	Ref<CryptoKey> dtls_key;
 	Ref<X509Certificate> dtls_cert;
@@ -167,6 +215,8 @@ public:
 	bool is_always_ordered() const;
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_io_thread_enabled(bool p_enabled);
+	bool is_io_thread_enabled() const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
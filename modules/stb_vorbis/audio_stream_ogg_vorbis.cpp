@@ -30,48 +30,385 @@
 
 #include "audio_stream_ogg_vorbis.h"
 
-#include "core/os/file_access.h"
+#include "core/io/marshalls.h"
 
-void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_frames) {
+Thread *AudioStreamPlaybackOGGVorbis::decode_thread = NULL;
+Semaphore *AudioStreamPlaybackOGGVorbis::decode_semaphore = NULL;
+Mutex *AudioStreamPlaybackOGGVorbis::decode_list_mutex = NULL;
+SelfList<AudioStreamPlaybackOGGVorbis>::List AudioStreamPlaybackOGGVorbis::decode_list;
+volatile bool AudioStreamPlaybackOGGVorbis::decode_thread_exit = false;
 
-	ERR_FAIL_COND(!active);
+int AudioStreamPlaybackOGGVorbis::_decode(AudioFrame *p_buffer, int p_frames) {
 
 	int todo = p_frames;
 
 	int start_buffer = 0;
 
-	while (todo && active) {
-		float *buffer = (float *)p_buffer;
-		if (start_buffer > 0) {
-			buffer = (buffer + start_buffer * 2);
+	while (todo) {
+		int mixed;
+		if (file) {
+			mixed = _get_file_samples(p_buffer + start_buffer, todo);
+		} else {
+			float *buffer = (float *)(p_buffer + start_buffer);
+			mixed = stb_vorbis_get_samples_float_interleaved(ogg_stream, 2, buffer, todo * 2);
 		}
-		int mixed = stb_vorbis_get_samples_float_interleaved(ogg_stream, 2, buffer, todo * 2);
 		if (vorbis_stream->channels == 1 && mixed > 0) {
 			//mix mono to stereo
-			for (int i = start_buffer; i < mixed; i++) {
+			for (int i = start_buffer; i < start_buffer + mixed; i++) {
 				p_buffer[i].r = p_buffer[i].l;
 			}
 		}
 		todo -= mixed;
-		frames_mixed += mixed;
+		start_buffer += mixed;
 
 		if (todo) {
 			//end of file!
-			bool is_not_empty = mixed > 0 || stb_vorbis_stream_length_in_samples(ogg_stream) > 0;
+			bool is_not_empty = mixed > 0 || total_frames > 0;
 			if (vorbis_stream->loop && is_not_empty) {
-				//loop
-				seek(vorbis_stream->loop_offset);
-				loops++;
-				// we still have buffer to fill, start from this element in the next iteration.
-				start_buffer = p_frames - todo;
+				//loop, _advance() wraps the position the same way
+				_seek_decoder(vorbis_stream->loop_offset);
 			} else {
-				for (int i = p_frames - todo; i < p_frames; i++) {
-					p_buffer[i] = AudioFrame(0, 0);
-				}
-				active = false;
-				todo = 0;
+				break;
+			}
+		}
+	}
+
+	return p_frames - todo;
+}
+
+void AudioStreamPlaybackOGGVorbis::_seek_decoder(float p_time) {
+
+	if (p_time >= vorbis_stream->get_length()) {
+		p_time = 0;
+	}
+
+	_seek_samples(uint32_t(vorbis_stream->sample_rate * p_time));
+}
+
+void AudioStreamPlaybackOGGVorbis::_seek_samples(uint32_t p_sample) {
+
+	if (file) {
+		_seek_file_decoder(p_sample);
+	} else {
+		stb_vorbis_seek(ogg_stream, p_sample);
+	}
+}
+
+bool AudioStreamPlaybackOGGVorbis::_open_file_decoder() {
+
+	if (ogg_stream) {
+		stb_vorbis_close(ogg_stream); //keeps the alloc buffer, the decoder is set up in it again
+		ogg_stream = NULL;
+	}
+
+	file->seek(0);
+	file_buffer_len = 0;
+	file_buffer_pos = 0;
+	frame_samples = 0;
+	frame_pos = 0;
+
+	while (true) {
+
+		int used;
+		int error;
+		ogg_stream = stb_vorbis_open_pushdata(file_buffer.ptr(), file_buffer_len, &used, &error, &ogg_alloc);
+		if (ogg_stream) {
+			file_buffer_pos = used;
+			return true;
+		}
+
+		ERR_FAIL_COND_V(error != VORBIS_need_more_data, false);
+		if (!_read_file())
+			return false;
+	}
+}
+
+bool AudioStreamPlaybackOGGVorbis::_read_file() {
+
+	uint8_t *w = file_buffer.ptrw();
+
+	if (file_buffer_pos > 0) {
+		memmove(w, w + file_buffer_pos, file_buffer_len - file_buffer_pos);
+		file_buffer_len -= file_buffer_pos;
+		file_buffer_pos = 0;
+	}
+
+	if (file_buffer_len == file_buffer.size()) {
+		//a packet that doesn't fit yet
+		ERR_FAIL_COND_V(file_buffer.size() >= FILE_BUFFER_MAX_SIZE, false);
+		file_buffer.resize(file_buffer.size() * 2);
+		w = file_buffer.ptrw();
+	}
+
+	int read = file->get_buffer(w + file_buffer_len, file_buffer.size() - file_buffer_len);
+	file_buffer_len += read;
+
+	return read > 0;
+}
+
+bool AudioStreamPlaybackOGGVorbis::_decode_frame() {
+
+	if (!ogg_stream)
+		return false;
+
+	while (true) {
+
+		int channels;
+		float **output;
+		int samples;
+		int used = stb_vorbis_decode_frame_pushdata(ogg_stream, file_buffer.ptr() + file_buffer_pos, file_buffer_len - file_buffer_pos, &channels, &output, &samples);
+		file_buffer_pos += used;
+
+		if (samples > 0) {
+			frame_output = output;
+			frame_samples = samples;
+			frame_pos = 0;
+			return true;
+		}
+
+		//nothing used means the packet isn't all there yet
+		if (used == 0 && !_read_file())
+			return false;
+	}
+}
+
+int AudioStreamPlaybackOGGVorbis::_get_file_samples(AudioFrame *p_buffer, int p_frames) {
+
+	int done = 0;
+	bool stereo = vorbis_stream->channels > 1;
+
+	while (done < p_frames) {
+
+		if (frame_pos == frame_samples) {
+			if (!_decode_frame())
+				break; //end of file
+			continue;
+		}
+
+		int todo = MIN(p_frames - done, frame_samples - frame_pos);
+		const float *l = frame_output[0] + frame_pos;
+		const float *r = stereo ? frame_output[1] + frame_pos : NULL;
+		for (int i = 0; i < todo; i++) {
+			p_buffer[done + i] = AudioFrame(l[i], r ? r[i] : 0);
+		}
+
+		frame_pos += todo;
+		done += todo;
+	}
+
+	return done;
+}
+
+void AudioStreamPlaybackOGGVorbis::_seek_file_decoder(uint32_t p_sample) {
+
+	//start from the last page ending far enough before the sample that the frame the
+	//decoder drops after it (it has nothing to overlap with) can't hold the sample
+	const Vector<AudioStreamOGGVorbis::FilePage> &pages = vorbis_stream->file_pages;
+	int page = -1;
+	int low = 0;
+	int high = pages.size() - 1;
+	while (low <= high) {
+		int middle = (low + high) / 2;
+		if (uint64_t(pages[middle].sample) + vorbis_stream->max_frame_size <= p_sample) {
+			page = middle;
+			low = middle + 1;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	if (page < 0) {
+		//the first frames are only decoded right from a fresh decoder
+		if (!_open_file_decoder())
+			return;
+	} else {
+		file->seek(pages[page].offset);
+		file_buffer_len = 0;
+		file_buffer_pos = 0;
+		frame_samples = 0;
+		frame_pos = 0;
+		stb_vorbis_flush_pushdata(ogg_stream);
+	}
+
+	//decode up to the frame holding the sample, it's then read from there
+	while (_decode_frame()) {
+
+		int end = stb_vorbis_get_sample_offset(ogg_stream);
+		if (end >= 0 && uint32_t(end) > p_sample) {
+			int start = end - frame_samples;
+			frame_pos = MAX(int(p_sample) - start, 0);
+			return;
+		}
+
+		frame_pos = frame_samples;
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_advance(int p_frames) {
+
+	frames_mixed += p_frames;
+
+	if (!vorbis_stream->loop || total_frames == 0)
+		return;
+
+	uint32_t loop_begin = uint32_t(vorbis_stream->sample_rate * vorbis_stream->loop_offset);
+	if (loop_begin >= total_frames) {
+		loop_begin = 0;
+	}
+
+	while (frames_mixed >= total_frames) {
+		frames_mixed = loop_begin + (frames_mixed - total_frames);
+		loops++;
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_frames) {
+
+	ERR_FAIL_COND(!active);
+
+	int mixed;
+	bool ended;
+
+	if (threaded) {
+		//only trust the end once the buffer was already final before reading
+		ended = decode_ended;
+		mixed = decode_buffer.read(p_buffer, p_frames);
+		ended = ended && mixed < p_frames;
+
+		if (!decode_ended && !decode_requested && decode_buffer.get_reader_space() < decode_buffer.get_total() / 2) {
+			decode_requested = true;
+			decode_semaphore->post();
+		}
+	} else {
+		mixed = _decode(p_buffer, p_frames);
+		ended = mixed < p_frames;
+	}
+
+	_advance(mixed);
+
+	//end of file, or the decode thread fell behind
+	for (int i = mixed; i < p_frames; i++) {
+		p_buffer[i] = AudioFrame(0, 0);
+	}
+
+	if (ended) {
+		active = false;
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_fill_decode_buffer(int p_max_frames) {
+
+	int filled = 0;
+
+	while (filled < p_max_frames) {
+
+		//lock per chunk, so seeking from the audio thread never waits long
+		MutexLock lock(decode_mutex);
+
+		int todo = MIN(MIN(decode_buffer.get_writer_space(), (int)DECODE_CHUNK_FRAMES), p_max_frames - filled);
+		if (decode_ended || todo <= 0)
+			break;
+
+		int decoded = _decode((AudioFrame *)decode_buffer.get_write_buffer(), todo);
+		decode_buffer.write(decoded);
+		filled += decoded;
+
+		if (decoded < todo) {
+			decode_ended = true;
+		}
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_decode_thread_func(void *p_udata) {
+
+	Vector<Ref<AudioStreamPlaybackOGGVorbis> > requested;
+
+	while (true) {
+
+		decode_semaphore->wait();
+		if (decode_thread_exit)
+			break;
+
+		{
+			//the list is only locked to pick playbacks, so a playback being freed never waits for
+			//decoding; the references keep the picked ones alive while they are filled below
+			MutexLock lock(decode_list_mutex);
+
+			for (SelfList<AudioStreamPlaybackOGGVorbis> *E = decode_list.first(); E; E = E->next()) {
+
+				AudioStreamPlaybackOGGVorbis *playback = E->self();
+				if (!playback->decode_requested)
+					continue;
+
+				Ref<AudioStreamPlaybackOGGVorbis> ref = playback;
+				if (ref.is_null())
+					continue; //already being freed
+
+				playback->decode_requested = false;
+				requested.push_back(ref);
 			}
 		}
+
+		for (int i = 0; i < requested.size(); i++) {
+			AudioStreamPlaybackOGGVorbis *playback = requested.write[i].ptr();
+			playback->_fill_decode_buffer(playback->decode_buffer.get_total());
+		}
+
+		//may drop the last reference, freeing the playback on this thread
+		requested.clear();
+	}
+}
+
+bool AudioStreamPlaybackOGGVorbis::_start_threaded() {
+
+#ifdef NO_THREADS
+	return false;
+#else
+	ERR_FAIL_COND_V(!decode_list_mutex, false);
+
+	MutexLock lock(decode_list_mutex);
+
+	if (!decode_thread) {
+		if (!decode_semaphore) {
+			decode_semaphore = Semaphore::create();
+		}
+		decode_thread_exit = false;
+		decode_thread = Thread::create(_decode_thread_func, NULL);
+		ERR_FAIL_COND_V(!decode_thread, false);
+	}
+
+	decode_mutex = Mutex::create();
+	decode_buffer.setup(2, vorbis_stream->sample_rate, vorbis_stream->sample_rate, DECODE_BUFFER_MSEC);
+	decode_list.add(&decode_element);
+	threaded = true;
+
+	return true;
+#endif
+}
+
+void AudioStreamPlaybackOGGVorbis::initialize_decode_thread() {
+
+	decode_list_mutex = Mutex::create();
+}
+
+void AudioStreamPlaybackOGGVorbis::finish_decode_thread() {
+
+	if (decode_thread) {
+		decode_thread_exit = true;
+		decode_semaphore->post();
+		Thread::wait_to_finish(decode_thread);
+		memdelete(decode_thread);
+		decode_thread = NULL;
+	}
+
+	if (decode_semaphore) {
+		memdelete(decode_semaphore);
+		decode_semaphore = NULL;
+	}
+
+	if (decode_list_mutex) {
+		memdelete(decode_list_mutex);
+		decode_list_mutex = NULL;
 	}
 }
 
@@ -116,21 +453,89 @@ void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
 	}
 	frames_mixed = uint32_t(vorbis_stream->sample_rate * p_time);
 
-	stb_vorbis_seek(ogg_stream, frames_mixed);
+	if (!threaded) {
+		_seek_samples(frames_mixed);
+		return;
+	}
+
+	MutexLock lock(decode_mutex);
+
+	_seek_samples(frames_mixed);
+	decode_buffer.flush();
+	decode_ended = false;
+	_fill_decode_buffer(PREFILL_FRAMES);
+
+	decode_requested = true;
+	decode_semaphore->post();
+}
+
+void AudioStreamPlaybackOGGVorbis::skip(float p_time) {
+
+	if (!active)
+		return;
+
+	float length = vorbis_stream->get_length();
+	float pos = get_playback_position() + p_time;
+
+	if (pos >= length) {
+		float loop_length = length - vorbis_stream->loop_offset;
+		if (!vorbis_stream->loop || loop_length <= 0) {
+			active = false;
+			return;
+		}
+		loops += int((pos - length) / loop_length) + 1;
+		pos = vorbis_stream->loop_offset + Math::fmod(pos - length, loop_length);
+	}
+
+	seek(pos);
+	_begin_resample();
+}
+
+AudioStreamPlaybackOGGVorbis::AudioStreamPlaybackOGGVorbis() :
+		decode_element(this) {
+
+	ogg_stream = NULL;
+	ogg_alloc.alloc_buffer = NULL;
+	ogg_alloc.alloc_buffer_length_in_bytes = 0;
+	frames_mixed = 0;
+	total_frames = 0;
+	active = false;
+	loops = 0;
+	file = NULL;
+	file_buffer_len = 0;
+	file_buffer_pos = 0;
+	frame_output = NULL;
+	frame_samples = 0;
+	frame_pos = 0;
+	threaded = false;
+	decode_mutex = NULL;
+	decode_ended = false;
+	decode_requested = false;
 }
 
 AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
+	if (threaded) {
+		{
+			//the decode thread picks playbacks to fill under this
+			MutexLock lock(decode_list_mutex);
+			decode_element.remove_from_list();
+		}
+		memdelete(decode_mutex);
+	}
 	if (ogg_alloc.alloc_buffer) {
 		stb_vorbis_close(ogg_stream);
 		AudioServer::get_singleton()->audio_data_free(ogg_alloc.alloc_buffer);
 	}
+	if (file) {
+		memdelete(file);
+	}
 }
 
 Ref<AudioStreamPlayback> AudioStreamOGGVorbis::instance_playback() {
 
 	Ref<AudioStreamPlaybackOGGVorbis> ovs;
 
-	ERR_FAIL_COND_V(data == NULL, ovs);
+	ERR_FAIL_COND_V(data == NULL && file == "", ovs);
 
 	ovs.instance();
 	ovs->vorbis_stream = Ref<AudioStreamOGGVorbis>(this);
@@ -139,13 +544,23 @@ Ref<AudioStreamPlayback> AudioStreamOGGVorbis::instance_playback() {
 	ovs->frames_mixed = 0;
 	ovs->active = false;
 	ovs->loops = 0;
-	int error;
-	ovs->ogg_stream = stb_vorbis_open_memory((const unsigned char *)data, data_len, &error, &ovs->ogg_alloc);
-	if (!ovs->ogg_stream) {
 
-		AudioServer::get_singleton()->audio_data_free(ovs->ogg_alloc.alloc_buffer);
-		ovs->ogg_alloc.alloc_buffer = NULL;
+	if (file != "") {
+		//each playback reads the file on its own, nothing compressed is kept around
+		ovs->file = FileAccess::open(file, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(!ovs->file, Ref<AudioStreamPlaybackOGGVorbis>(), "Cannot open Ogg Vorbis file '" + file + "'.");
+		ovs->file_buffer.resize(AudioStreamPlaybackOGGVorbis::FILE_READ_SIZE);
+		ERR_FAIL_COND_V(!ovs->_open_file_decoder(), Ref<AudioStreamPlaybackOGGVorbis>());
+		ovs->total_frames = file_samples;
+	} else {
+		int error;
+		ovs->ogg_stream = stb_vorbis_open_memory((const unsigned char *)data, data_len, &error, &ovs->ogg_alloc);
 		ERR_FAIL_COND_V(!ovs->ogg_stream, Ref<AudioStreamPlaybackOGGVorbis>());
+		ovs->total_frames = stb_vorbis_stream_length_in_samples(ovs->ogg_stream);
+	}
+
+	if (threaded_decode) {
+		ovs->_start_threaded(); //decodes on the mix thread if it can't
 	}
 
 	return ovs;
@@ -213,6 +628,10 @@ void AudioStreamOGGVorbis::set_data(const PoolVector<uint8_t> &p_data) {
 			data = AudioServer::get_singleton()->audio_data_alloc(src_data_len, src_datar.ptr());
 			data_len = src_data_len;
 
+			file = "";
+			file_pages.clear();
+			file_samples = 0;
+
 			break;
 		}
 	}
@@ -233,6 +652,118 @@ PoolVector<uint8_t> AudioStreamOGGVorbis::get_data() const {
 	return vdata;
 }
 
+void AudioStreamOGGVorbis::set_file(const String &p_file) {
+
+	if (p_file == "") {
+		file = "";
+		file_pages.clear();
+		file_samples = 0;
+		return;
+	}
+
+	FileAccessRef f = FileAccess::open(p_file, FileAccess::READ);
+	ERR_FAIL_COND_MSG(!f, "Cannot open Ogg Vorbis file '" + p_file + "'.");
+
+	//read the headers as the playbacks do, to know the memory they need
+	Vector<uint8_t> header;
+	uint32_t alloc_try = 1024;
+	PoolVector<char> alloc_mem;
+	int header_size = 0;
+	stb_vorbis_info info;
+
+	while (true) {
+
+		ERR_FAIL_COND(alloc_try >= MAX_TEST_MEM);
+
+		alloc_mem.resize(alloc_try);
+		PoolVector<char>::Write w = alloc_mem.write();
+
+		stb_vorbis_alloc ogg_alloc;
+		ogg_alloc.alloc_buffer = w.ptr();
+		ogg_alloc.alloc_buffer_length_in_bytes = alloc_try;
+
+		int error;
+		stb_vorbis *ogg_stream = stb_vorbis_open_pushdata(header.ptr(), header.size(), &header_size, &error, &ogg_alloc);
+
+		if (ogg_stream) {
+			info = stb_vorbis_get_info(ogg_stream);
+			stb_vorbis_close(ogg_stream);
+			break;
+		}
+
+		if (error == VORBIS_outofmem) {
+			alloc_try *= 2;
+		} else {
+			ERR_FAIL_COND_MSG(error != VORBIS_need_more_data, "Invalid Ogg Vorbis file '" + p_file + "'.");
+
+			int size = header.size();
+			header.resize(size + AudioStreamPlaybackOGGVorbis::FILE_READ_SIZE);
+			int read = f->get_buffer(header.ptrw() + size, AudioStreamPlaybackOGGVorbis::FILE_READ_SIZE);
+			header.resize(size + read);
+			ERR_FAIL_COND_MSG(read == 0, "Invalid Ogg Vorbis file '" + p_file + "'.");
+		}
+	}
+
+	//index the pages after the headers that end a packet, seeking resumes decoding on them
+	Vector<FilePage> pages;
+	uint32_t samples = 0;
+	uint64_t offset = 0;
+	uint64_t len = f->get_len();
+
+	while (offset + 27 <= len) {
+
+		uint8_t page_header[27];
+		uint8_t lacing[255];
+
+		f->seek(offset);
+		f->get_buffer(page_header, 27);
+		ERR_FAIL_COND_MSG(page_header[0] != 'O' || page_header[1] != 'g' || page_header[2] != 'g' || page_header[3] != 'S', "Invalid Ogg page in '" + p_file + "'.");
+
+		int segments = page_header[26];
+		ERR_FAIL_COND_MSG(f->get_buffer(lacing, segments) != segments, "Invalid Ogg page in '" + p_file + "'.");
+
+		uint64_t body = 0;
+		for (int i = 0; i < segments; i++) {
+			body += lacing[i];
+		}
+
+		uint64_t granule = decode_uint64(&page_header[6]);
+		if (offset >= uint64_t(header_size) && segments > 0 && lacing[segments - 1] != 255 && granule != uint64_t(-1)) {
+			FilePage page;
+			page.offset = offset;
+			page.sample = granule;
+			pages.push_back(page);
+			samples = granule;
+		}
+
+		offset += 27 + segments + body;
+	}
+
+	clear_data();
+
+	channels = info.channels;
+	sample_rate = info.sample_rate;
+	decode_mem_size = alloc_try;
+	max_frame_size = info.max_frame_size;
+	length = samples / sample_rate;
+
+	file = p_file;
+	file_pages = pages;
+	file_samples = samples;
+}
+
+String AudioStreamOGGVorbis::get_file() const {
+
+	return file;
+}
+
+void AudioStreamOGGVorbis::_validate_property(PropertyInfo &property) const {
+
+	if (property.name == "data" && file != "") {
+		property.usage = 0; //read from the file, not stored
+	}
+}
+
 void AudioStreamOGGVorbis::set_loop(bool p_enable) {
 	loop = p_enable;
 }
@@ -250,6 +781,15 @@ float AudioStreamOGGVorbis::get_loop_offset() const {
 	return loop_offset;
 }
 
+void AudioStreamOGGVorbis::set_threaded_decode(bool p_enable) {
+	threaded_decode = p_enable;
+}
+
+bool AudioStreamOGGVorbis::is_threaded_decode() const {
+
+	return threaded_decode;
+}
+
 float AudioStreamOGGVorbis::get_length() const {
 
 	return length;
@@ -260,27 +800,38 @@ void AudioStreamOGGVorbis::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &AudioStreamOGGVorbis::set_data);
 	ClassDB::bind_method(D_METHOD("get_data"), &AudioStreamOGGVorbis::get_data);
 
+	ClassDB::bind_method(D_METHOD("set_file", "file"), &AudioStreamOGGVorbis::set_file);
+	ClassDB::bind_method(D_METHOD("get_file"), &AudioStreamOGGVorbis::get_file);
+
 	ClassDB::bind_method(D_METHOD("set_loop", "enable"), &AudioStreamOGGVorbis::set_loop);
 	ClassDB::bind_method(D_METHOD("has_loop"), &AudioStreamOGGVorbis::has_loop);
 
 	ClassDB::bind_method(D_METHOD("set_loop_offset", "seconds"), &AudioStreamOGGVorbis::set_loop_offset);
 	ClassDB::bind_method(D_METHOD("get_loop_offset"), &AudioStreamOGGVorbis::get_loop_offset);
 
+	ClassDB::bind_method(D_METHOD("set_threaded_decode", "enable"), &AudioStreamOGGVorbis::set_threaded_decode);
+	ClassDB::bind_method(D_METHOD("is_threaded_decode"), &AudioStreamOGGVorbis::is_threaded_decode);
+
 	ADD_PROPERTY(PropertyInfo(Variant::POOL_BYTE_ARRAY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR), "set_data", "get_data");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "file", PROPERTY_HINT_FILE, "*.ogg"), "set_file", "get_file");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "loop_offset"), "set_loop_offset", "get_loop_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded_decode"), "set_threaded_decode", "is_threaded_decode");
 }
 
 AudioStreamOGGVorbis::AudioStreamOGGVorbis() {
 
 	data = NULL;
 	data_len = 0;
+	file_samples = 0;
+	max_frame_size = 0;
 	length = 0;
 	sample_rate = 1;
 	channels = 1;
 	loop_offset = 0;
 	decode_mem_size = 0;
 	loop = false;
+	threaded_decode = false;
 }
 
 AudioStreamOGGVorbis::~AudioStreamOGGVorbis() {
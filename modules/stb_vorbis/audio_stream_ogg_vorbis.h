@@ -32,6 +32,12 @@
 #define AUDIO_STREAM_STB_VORBIS_H
 
 #include "core/io/resource_loader.h"
+#include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/self_list.h"
+#include "servers/audio/audio_rb_resampler.h"
 #include "servers/audio/audio_stream.h"
 
 #include "thirdparty/misc/stb_vorbis.h"
@@ -42,12 +48,57 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 
 	GDCLASS(AudioStreamPlaybackOGGVorbis, AudioStreamPlaybackResampled);
 
+	enum {
+		DECODE_BUFFER_MSEC = 500,
+		DECODE_CHUNK_FRAMES = 1024,
+		PREFILL_FRAMES = 2048, //decoded right away on seek, so mixing doesn't start on an empty buffer
+		FILE_READ_SIZE = 4096,
+		FILE_BUFFER_MAX_SIZE = 1 << 20 //pages are far smaller, a file needing more is broken
+	};
+
 	stb_vorbis *ogg_stream;
 	stb_vorbis_alloc ogg_alloc;
 	uint32_t frames_mixed;
+	uint32_t total_frames;
 	bool active;
 	int loops;
 
+	//streaming from the stream file, compressed data is fed to the decoder as it goes
+	FileAccess *file;
+	Vector<uint8_t> file_buffer;
+	int file_buffer_len;
+	int file_buffer_pos;
+	float **frame_output;
+	int frame_samples;
+	int frame_pos;
+
+	//threaded decoding, the decode thread fills decode_buffer ahead of mixing
+	bool threaded;
+	AudioRBResampler decode_buffer;
+	Mutex *decode_mutex; //held while using ogg_stream
+	volatile bool decode_ended;
+	volatile bool decode_requested;
+	SelfList<AudioStreamPlaybackOGGVorbis> decode_element;
+
+	static Thread *decode_thread;
+	static Semaphore *decode_semaphore;
+	static Mutex *decode_list_mutex;
+	static SelfList<AudioStreamPlaybackOGGVorbis>::List decode_list;
+	static volatile bool decode_thread_exit;
+
+	static void _decode_thread_func(void *p_udata);
+	bool _start_threaded();
+	void _fill_decode_buffer(int p_max_frames);
+	int _decode(AudioFrame *p_buffer, int p_frames);
+	void _seek_decoder(float p_time);
+	void _seek_samples(uint32_t p_sample);
+	bool _open_file_decoder();
+	bool _read_file();
+	bool _decode_frame();
+	int _get_file_samples(AudioFrame *p_buffer, int p_frames);
+	void _seek_file_decoder(uint32_t p_sample);
+	void _advance(int p_frames);
+
 	friend class AudioStreamOGGVorbis;
 
 	Ref<AudioStreamOGGVorbis> vorbis_stream;
@@ -65,8 +116,12 @@ public:
 
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
+	virtual void skip(float p_time);
 
-	AudioStreamPlaybackOGGVorbis() {}
+	static void initialize_decode_thread();
+	static void finish_decode_thread();
+
+	AudioStreamPlaybackOGGVorbis();
 	~AudioStreamPlaybackOGGVorbis();
 };
 
@@ -81,16 +136,29 @@ class AudioStreamOGGVorbis : public AudioStream {
 	void *data;
 	uint32_t data_len;
 
+	//pages of the stream file that end with a known sample, to seek from
+	struct FilePage {
+		uint64_t offset;
+		uint32_t sample;
+	};
+
+	String file;
+	Vector<FilePage> file_pages;
+	uint32_t file_samples;
+	int max_frame_size;
+
 	int decode_mem_size;
 	float sample_rate;
 	int channels;
 	float length;
 	bool loop;
 	float loop_offset;
+	bool threaded_decode;
 	void clear_data();
 
 protected:
 	static void _bind_methods();
+	virtual void _validate_property(PropertyInfo &property) const;
 
 public:
 	void set_loop(bool p_enable);
@@ -99,12 +167,18 @@ public:
 	void set_loop_offset(float p_seconds);
 	float get_loop_offset() const;
 
+	void set_threaded_decode(bool p_enable);
+	bool is_threaded_decode() const;
+
 	virtual Ref<AudioStreamPlayback> instance_playback();
 	virtual String get_stream_name() const;
 
 	void set_data(const PoolVector<uint8_t> &p_data);
 	PoolVector<uint8_t> get_data() const;
 
+	void set_file(const String &p_file);
+	String get_file() const;
+
 	virtual float get_length() const; //if supported, otherwise return 0
 
 	AudioStreamOGGVorbis();
@@ -47,7 +47,10 @@ void register_stb_vorbis_types() {
 	}
 #endif
 	ClassDB::register_class<AudioStreamOGGVorbis>();
+	AudioStreamPlaybackOGGVorbis::initialize_decode_thread();
 }
 
 void unregister_stb_vorbis_types() {
+
+	AudioStreamPlaybackOGGVorbis::finish_decode_thread();
 }
@@ -287,6 +287,11 @@ bool WSLPeer::is_connected_to_host() const {
 	return _data != NULL;
 }
 
+bool WSLPeer::wants_write() const {
+
+	return _data && wslay_event_want_write(_data->ctx);
+}
+
 void WSLPeer::close_now() {
 	close(1000, "");
 	_wsl_destroy(&_data);
@@ -165,21 +165,39 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 	for (int i = 0; i < p_protocols.size(); i++) {
 		pw[i] = p_protocols[i].strip_edges();
 	}
+	_poller = Ref<NetSocketPoller>(NetSocketPoller::create());
 	return _server->listen(p_port, bind_ip);
 }
 
 void WSLServer::poll() {
 
+	if (_poller.is_valid() && _poller->get_socket_count()) {
+		if (_events.size() < _poller->get_socket_count()) {
+			_events.resize(_poller->get_socket_count());
+		}
+		int count = _poller->wait(_events.ptrw(), _events.size(), 0);
+		for (int i = 0; i < count; i++) {
+			Map<int, Ref<WebSocketPeer> >::Element *E = _peer_map.find((intptr_t)_events[i].userdata);
+			if (E) {
+				static_cast<WSLPeer *>(E->get().ptr())->poll();
+			}
+		}
+	}
+
 	List<int> remove_ids;
 	for (Map<int, Ref<WebSocketPeer> >::Element *E = _peer_map.front(); E; E = E->next()) {
 		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
-		peer->poll();
+		// Registered peers were polled above if their socket had data.
+		if (!_peer_sockets.has(E->key()) || peer->wants_write()) {
+			peer->poll();
+		}
 		if (!peer->is_connected_to_host()) {
 			_on_disconnect(E->key(), peer->close_code != -1);
 			remove_ids.push_back(E->key());
 		}
 	}
 	for (List<int>::Element *E = remove_ids.front(); E; E = E->next()) {
+		_remove_peer_socket(E->get());
 		_peer_map.erase(E->get());
 	}
 	remove_ids.clear();
@@ -209,6 +227,16 @@ void WSLServer::poll() {
 		ws_peer->set_no_delay(true);
 
 		_peer_map[id] = ws_peer;
+		// SSL can hold decrypted data the socket no longer signals, keep polling those.
+		if (_poller.is_valid() && !ppeer->use_ssl) {
+			Ref<NetSocket> sock = ppeer->tcp->get_net_socket();
+			if (_poller->add(sock, NetSocket::POLL_TYPE_IN, (void *)(intptr_t)id) == OK) {
+				_peer_sockets[id] = sock;
+			} else {
+				_poller.unref(); // Fall back to polling every peer.
+				_peer_sockets.clear();
+			}
+		}
 		remove_peers.push_back(ppeer);
 		_on_connect(id, ppeer->protocol);
 	}
@@ -249,6 +277,16 @@ int WSLServer::get_max_packet_size() const {
 	return (1 << _out_buf_size) - PROTO_SIZE;
 }
 
+void WSLServer::_remove_peer_socket(int p_id) {
+	Map<int, Ref<NetSocket> >::Element *E = _peer_sockets.find(p_id);
+	if (!E)
+		return;
+	if (_poller.is_valid()) {
+		_poller->remove(E->get());
+	}
+	_peer_sockets.erase(E);
+}
+
 void WSLServer::stop() {
 	_server->stop();
 	for (Map<int, Ref<WebSocketPeer> >::Element *E = _peer_map.front(); E; E = E->next()) {
@@ -257,7 +295,9 @@ void WSLServer::stop() {
 	}
 	_pending.clear();
 	_peer_map.clear();
+	_peer_sockets.clear();
 	_protocols.clear();
+	_poller.unref();
 }
 
 bool WSLServer::has_peer(int p_id) const {
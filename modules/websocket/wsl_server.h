@@ -80,6 +80,13 @@ private:
 	Ref<TCP_Server> _server;
 	Vector<String> _protocols;
 
+	// Connected peers' sockets, so only the ready ones get polled.
+	Ref<NetSocketPoller> _poller;
+	Map<int, Ref<NetSocket> > _peer_sockets;
+	Vector<NetSocketPoller::Event> _events;
+
+	void _remove_peer_socket(int p_id);
+
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets);
 	Error listen(int p_port, const Vector<String> p_protocols = Vector<String>(), bool gd_mp_api = false);
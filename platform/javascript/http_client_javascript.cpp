@@ -215,6 +215,26 @@ int HTTPClient::get_read_chunk_size() const {
 	return read_limit;
 }
 
+void HTTPClient::set_pipelining_enabled(bool p_enable) {
+
+	ERR_FAIL_COND_MSG(p_enable, "HTTPClient pipelining is not supported for the HTML5 platform.");
+}
+
+bool HTTPClient::is_pipelining_enabled() const {
+
+	return false;
+}
+
+int HTTPClient::get_pending_request_count() const {
+
+	return status == STATUS_REQUESTING ? 1 : 0;
+}
+
+bool HTTPClient::is_keep_alive() const {
+
+	return false; // The browser reuses connections by itself.
+}
+
 Error HTTPClient::poll() {
 
 	switch (status) {
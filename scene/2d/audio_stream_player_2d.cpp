@@ -33,6 +33,7 @@
 #include "core/engine.h"
 #include "scene/2d/area_2d.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix.h"
 
 void AudioStreamPlayer2D::_mix_audio() {
 
@@ -96,12 +97,7 @@ void AudioStreamPlayer2D::_mix_audio() {
 				continue; //may have been removed
 
 			AudioFrame *target = AudioServer::get_singleton()->thread_get_channel_mix_buffer(current.bus_index, 0);
-
-			for (int j = 0; j < buffer_size; j++) {
-
-				target[j] += buffer[j] * vol;
-				vol += vol_inc;
-			}
+			AudioMix::add_ramp(target, buffer, buffer_size, vol, vol_inc);
 
 		} else {
 			AudioFrame *targets[4];
@@ -119,13 +115,8 @@ void AudioStreamPlayer2D::_mix_audio() {
 			if (!valid)
 				continue;
 
-			for (int j = 0; j < buffer_size; j++) {
-
-				AudioFrame frame = buffer[j] * vol;
-				for (int k = 0; k < cc; k++) {
-					targets[k][j] += frame;
-				}
-				vol += vol_inc;
+			for (int k = 0; k < cc; k++) {
+				AudioMix::add_ramp(targets[k], buffer, buffer_size, vol, vol_inc);
 			}
 		}
 
@@ -482,6 +482,14 @@ Transform2D CanvasItem::get_global_transform() const {
 #ifdef DEBUG_ENABLED
 	ERR_FAIL_COND_V(!is_inside_tree(), get_transform());
 #endif
+	// Items outside the tree never queue themselves, and get_tree() is NULL there.
+	if (is_inside_tree()) {
+		SceneTree *tree = get_tree();
+		if (tree->xform_pending_list.first()) {
+			tree->flush_pending_transforms();
+		}
+	}
+
 	if (global_invalid) {
 
 		const CanvasItem *pi = get_parent_item();
@@ -600,6 +608,8 @@ void CanvasItem::_notification(int p_what) {
 		case NOTIFICATION_EXIT_TREE: {
 			if (xform_change.in_list())
 				get_tree()->xform_change_list.remove(&xform_change);
+			if (xform_pending.in_list())
+				get_tree()->xform_pending_list.remove(&xform_pending);
 			_exit_canvas();
 			if (C) {
 				Object::cast_to<CanvasItem>(get_parent())->children_items.erase(C);
@@ -975,6 +985,33 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
 	}
 }
 
+void CanvasItem::_queue_transform_changed() {
+
+	if (global_invalid) {
+		return; // Already dirty, the whole subtree is.
+	}
+
+	// The subtree is invalidated once per batch by SceneTree::flush_pending_transforms(),
+	// no matter how many times the local transform is set before that.
+	if (!xform_pending.in_list()) {
+		get_tree()->xform_pending_list.add(&xform_pending);
+	}
+}
+
+void CanvasItem::_flush_pending_transform() {
+
+	// If an ancestor item is pending too, its propagation covers this subtree.
+	const CanvasItem *ci = get_parent_item();
+	while (ci) {
+		if (ci->xform_pending.in_list()) {
+			return;
+		}
+		ci = ci->get_parent_item();
+	}
+
+	_notify_transform(this);
+}
+
 Rect2 CanvasItem::get_viewport_rect() const {
 
 	ERR_FAIL_COND_V(!is_inside_tree(), Rect2());
@@ -1319,7 +1356,8 @@ int CanvasItem::get_canvas_layer() const {
 }
 
 CanvasItem::CanvasItem() :
-		xform_change(this) {
+		xform_change(this),
+		xform_pending(this) {
 
 	canvas_item = VisualServer::get_singleton()->canvas_item_create();
 	visible = true;
@@ -178,6 +178,7 @@ public:
 
 private:
 	mutable SelfList<Node> xform_change;
+	SelfList<Node> xform_pending;
 
 	RID canvas_item;
 	String group;
@@ -218,6 +219,10 @@ private:
 	void _exit_canvas();
 
 	void _notify_transform(CanvasItem *p_node);
+	void _queue_transform_changed();
+	void _flush_pending_transform();
+
+	friend class SceneTree;
 
 	void _set_on_top(bool p_on_top) { set_draw_behind_parent(!p_on_top); }
 	bool _is_on_top() const { return !is_draw_behind_parent_enabled(); }
@@ -227,7 +232,7 @@ private:
 protected:
 	_FORCE_INLINE_ void _notify_transform() {
 		if (!is_inside_tree()) return;
-		_notify_transform(this);
+		_queue_transform_changed();
 		if (!block_transform_notify && notify_local_transform) notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
 
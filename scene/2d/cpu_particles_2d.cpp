@@ -30,6 +30,7 @@
 
 #include "cpu_particles_2d.h"
 #include "core/core_string_names.h"
+#include "core/os/threaded_array_processor.h"
 #include "scene/2d/canvas_item.h"
 #include "scene/2d/particles_2d.h"
 #include "scene/resources/particles_material.h"
@@ -634,8 +635,6 @@ void CPUParticles2D::_particles_process(float p_delta) {
 	int pcount = particles.size();
 	PoolVector<Particle>::Write w = particles.write();
 
-	Particle *parray = w.ptr();
-
 	float prev_time = time;
 	time += p_delta;
 	if (time > lifetime) {
@@ -647,24 +646,64 @@ void CPUParticles2D::_particles_process(float p_delta) {
 		}
 	}
 
-	Transform2D emission_xform;
-	Transform2D velocity_xform;
+	ProcessData data;
+	data.particles = w.ptr();
+	data.count = pcount;
+	data.delta = p_delta;
+	data.prev_time = prev_time;
+	data.system_phase = time / lifetime;
 	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform;
-		velocity_xform[2] = Vector2();
+		data.emission_xform = get_global_transform();
+		data.velocity_xform = data.emission_xform;
+		data.velocity_xform[2] = Vector2();
+	}
+
+	// Math::rand() is not thread safe, so every block draws from its own
+	// generator, seeded here in order.
+	uint32_t block_count = (pcount + PROCESS_BLOCK_SIZE - 1) / PROCESS_BLOCK_SIZE;
+	Vector<uint32_t> block_seeds;
+	block_seeds.resize(block_count);
+	for (uint32_t i = 0; i < block_count; i++) {
+		block_seeds.write[i] = Math::rand();
+	}
+	data.block_seeds = block_seeds.ptr();
+
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0); // Sorts the points up front, so workers only read.
 	}
 
-	float system_phase = time / lifetime;
+	if (pcount >= PROCESS_THREADED_MIN_PARTICLES) {
+		thread_process_array(block_count, this, &CPUParticles2D::_particles_process_block, &data);
+	} else {
+		for (uint32_t i = 0; i < block_count; i++) {
+			_particles_process_block(i, &data);
+		}
+	}
+}
+
+void CPUParticles2D::_particles_process_block(uint32_t p_block, ProcessData *p_data) {
 
-	for (int i = 0; i < pcount; i++) {
+	Particle *parray = p_data->particles;
+	int pcount = p_data->count;
+	float delta = p_data->delta;
+	float prev_time = p_data->prev_time;
+	float system_phase = p_data->system_phase;
+	const Transform2D &emission_xform = p_data->emission_xform;
+	const Transform2D &velocity_xform = p_data->velocity_xform;
+
+	RandomPCG rng(p_data->block_seeds[p_block]);
+
+	int from = p_block * PROCESS_BLOCK_SIZE;
+	int to = MIN(from + PROCESS_BLOCK_SIZE, pcount);
+
+	for (int i = from; i < to; i++) {
 
 		Particle &p = parray[i];
 
 		if (!emitting && !p.active)
 			continue;
 
-		float local_delta = p_delta;
+		float local_delta = delta;
 
 		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
 		// While we use time in tests later on, for randomness we use the phase as done in the
@@ -738,16 +777,16 @@ void CPUParticles2D::_particles_process(float p_delta) {
 				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(0);
 			}
 
-			p.seed = Math::rand();
+			p.seed = rng.rand();
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+			p.angle_rand = rng.randf();
+			p.scale_rand = rng.randf();
+			p.hue_rot_rand = rng.randf();
+			p.anim_offset_rand = rng.randf();
 
-			float angle1_rad = Math::atan2(direction.y, direction.x) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+			float angle1_rad = Math::atan2(direction.y, direction.x) + (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
 			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+			p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(rng.randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
 
 			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
 			p.rotation = Math::deg2rad(base_angle);
@@ -758,7 +797,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			p.custom[3] = 0.0;
 			p.transform = Transform2D();
 			p.time = 0;
-			p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+			p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
 			p.base_color = Color(1, 1, 1, 1);
 
 			switch (emission_shape) {
@@ -766,12 +805,12 @@ void CPUParticles2D::_particles_process(float p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					float s = Math::randf(), t = 2.0 * Math_PI * Math::randf();
+					float s = rng.randf(), t = 2.0 * Math_PI * rng.randf();
 					float radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+					p.transform[2] = Vector2(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_rect_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -780,7 +819,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 					if (pc == 0)
 						break;
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = rng.rand() % pc;
 
 					p.transform[2] = emission_points.get(random_idx);
 
@@ -1001,44 +1040,19 @@ void CPUParticles2D::_update_particle_data_buffer() {
 			}
 		}
 
-		for (int i = 0; i < pc; i++) {
-
-			int idx = order ? order[i] : i;
-
-			Transform2D t = r[idx].transform;
-
-			if (!local_coords) {
-				t = inv_emission_transform * t;
-			}
+		DataBufferData data;
+		data.particles = r.ptr();
+		data.order = order;
+		data.data = ptr;
+		data.count = pc;
 
-			if (r[idx].active) {
-
-				ptr[0] = t.elements[0][0];
-				ptr[1] = t.elements[1][0];
-				ptr[2] = 0;
-				ptr[3] = t.elements[2][0];
-				ptr[4] = t.elements[0][1];
-				ptr[5] = t.elements[1][1];
-				ptr[6] = 0;
-				ptr[7] = t.elements[2][1];
-
-				Color c = r[idx].color;
-				uint8_t *data8 = (uint8_t *)&ptr[8];
-				data8[0] = CLAMP(c.r * 255.0, 0, 255);
-				data8[1] = CLAMP(c.g * 255.0, 0, 255);
-				data8[2] = CLAMP(c.b * 255.0, 0, 255);
-				data8[3] = CLAMP(c.a * 255.0, 0, 255);
-
-				ptr[9] = r[idx].custom[0];
-				ptr[10] = r[idx].custom[1];
-				ptr[11] = r[idx].custom[2];
-				ptr[12] = r[idx].custom[3];
-
-			} else {
-				zeromem(ptr, sizeof(float) * 13);
+		uint32_t block_count = (pc + PROCESS_BLOCK_SIZE - 1) / PROCESS_BLOCK_SIZE;
+		if (pc >= PROCESS_THREADED_MIN_PARTICLES) {
+			thread_process_array(block_count, this, &CPUParticles2D::_update_particle_data_block, &data);
+		} else {
+			for (uint32_t i = 0; i < block_count; i++) {
+				_update_particle_data_block(i, &data);
 			}
-
-			ptr += 13;
 		}
 	}
 
@@ -1047,6 +1061,56 @@ void CPUParticles2D::_update_particle_data_buffer() {
 #endif
 }
 
+void CPUParticles2D::_update_particle_data_block(uint32_t p_block, DataBufferData *p_data) {
+
+	const Particle *r = p_data->particles;
+	const int *order = p_data->order;
+
+	int from = p_block * PROCESS_BLOCK_SIZE;
+	int to = MIN(from + PROCESS_BLOCK_SIZE, p_data->count);
+	float *ptr = p_data->data + from * 13;
+
+	for (int i = from; i < to; i++) {
+
+		int idx = order ? order[i] : i;
+
+		Transform2D t = r[idx].transform;
+
+		if (!local_coords) {
+			t = inv_emission_transform * t;
+		}
+
+		if (r[idx].active) {
+
+			ptr[0] = t.elements[0][0];
+			ptr[1] = t.elements[1][0];
+			ptr[2] = 0;
+			ptr[3] = t.elements[2][0];
+			ptr[4] = t.elements[0][1];
+			ptr[5] = t.elements[1][1];
+			ptr[6] = 0;
+			ptr[7] = t.elements[2][1];
+
+			Color c = r[idx].color;
+			uint8_t *data8 = (uint8_t *)&ptr[8];
+			data8[0] = CLAMP(c.r * 255.0, 0, 255);
+			data8[1] = CLAMP(c.g * 255.0, 0, 255);
+			data8[2] = CLAMP(c.b * 255.0, 0, 255);
+			data8[3] = CLAMP(c.a * 255.0, 0, 255);
+
+			ptr[9] = r[idx].custom[0];
+			ptr[10] = r[idx].custom[1];
+			ptr[11] = r[idx].custom[2];
+			ptr[12] = r[idx].custom[3];
+
+		} else {
+			zeromem(ptr, sizeof(float) * 13);
+		}
+
+		ptr += 13;
+	}
+}
+
 void CPUParticles2D::_set_redraw(bool p_redraw) {
 	if (redraw == p_redraw)
 		return;
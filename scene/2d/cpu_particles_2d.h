@@ -131,6 +131,31 @@ private:
 		}
 	};
 
+	// Particles are processed in fixed size blocks, spread across worker
+	// threads once the emitter is large enough to pay for the thread startup.
+	enum {
+		PROCESS_BLOCK_SIZE = 1024,
+		PROCESS_THREADED_MIN_PARTICLES = 8192
+	};
+
+	struct ProcessData {
+		Particle *particles;
+		int count;
+		float delta;
+		float prev_time;
+		float system_phase;
+		Transform2D emission_xform;
+		Transform2D velocity_xform;
+		const uint32_t *block_seeds;
+	};
+
+	struct DataBufferData {
+		const Particle *particles;
+		const int *order;
+		float *data;
+		int count;
+	};
+
 	//
 
 	bool one_shot;
@@ -178,7 +203,9 @@ private:
 
 	void _update_internal();
 	void _particles_process(float p_delta);
+	void _particles_process_block(uint32_t p_block, ProcessData *p_data);
 	void _update_particle_data_buffer();
+	void _update_particle_data_block(uint32_t p_block, DataBufferData *p_data);
 
 	Mutex *update_mutex;
 
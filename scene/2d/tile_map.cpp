@@ -35,6 +35,7 @@
 #include "core/method_bind_ext.gen.inc"
 #include "core/os/os.h"
 #include "scene/2d/area_2d.h"
+#include "scene/resources/rectangle_shape_2d.h"
 #include "servers/physics_2d_server.h"
 
 int TileMap::_get_quadrant_size() const {
@@ -68,6 +69,7 @@ void TileMap::_notification(int p_what) {
 			}
 
 			pending_update = true;
+			_update_streaming();
 			_recreate_quadrants();
 			update_dirty_quadrants();
 			RID space = get_world_2d()->get_space();
@@ -120,6 +122,11 @@ void TileMap::_notification(int p_what) {
 			}
 
 		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+
+			_update_streaming();
+
+		} break;
 	}
 }
 
@@ -324,6 +331,167 @@ void TileMap::_add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D>
 	shape_idx++;
 }
 
+bool TileMap::_bake_cell_rect(BakedBatch &p_batch, const RID &p_canvas_item, const Ref<Texture> &p_texture, const Ref<Texture> &p_normal_map, const Rect2 &p_rect, const Rect2 &p_region, const Color &p_modulate, bool p_transpose) {
+
+	// Atlas textures remap regions and margins themselves, let them draw their own rects.
+	if (Object::cast_to<AtlasTexture>(*p_texture))
+		return false;
+
+	RID texture = p_texture->get_rid();
+	Size2 tex_size = p_texture->get_size();
+	if (!texture.is_valid() || tex_size.x <= 0 || tex_size.y <= 0)
+		return false;
+
+	RID normal_map = p_normal_map.is_valid() ? p_normal_map->get_rid() : RID();
+
+	if (p_batch.canvas_item != p_canvas_item || p_batch.texture != texture || p_batch.normal_map != normal_map) {
+		_flush_baked_batch(p_batch);
+		p_batch.canvas_item = p_canvas_item;
+		p_batch.texture = texture;
+		p_batch.normal_map = normal_map;
+	}
+
+	// Same mapping as a texture rect: negative sizes mirror the destination, transpose swaps the source axes.
+	Rect2 src = p_region == Rect2() ? Rect2(Point2(), tex_size) : p_region;
+	Size2 size = p_rect.size.abs();
+	if (p_transpose)
+		SWAP(size.x, size.y);
+
+	static const Vector2 corners[4] = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) };
+
+	int base = p_batch.points.size();
+	for (int i = 0; i < 4; i++) {
+		Vector2 p = corners[i];
+		if (p_rect.size.x < 0)
+			p.x = 1.0 - p.x;
+		if (p_rect.size.y < 0)
+			p.y = 1.0 - p.y;
+
+		Vector2 t = p_transpose ? Vector2(corners[i].y, corners[i].x) : corners[i];
+
+		p_batch.points.push_back(p_rect.position + size * p);
+		p_batch.uvs.push_back((src.position + src.size * t) / tex_size);
+		p_batch.colors.push_back(p_modulate);
+	}
+
+	p_batch.indices.push_back(base);
+	p_batch.indices.push_back(base + 1);
+	p_batch.indices.push_back(base + 2);
+	p_batch.indices.push_back(base);
+	p_batch.indices.push_back(base + 2);
+	p_batch.indices.push_back(base + 3);
+
+	return true;
+}
+
+void TileMap::_flush_baked_batch(BakedBatch &p_batch) {
+
+	if (p_batch.indices.size()) {
+		VisualServer::get_singleton()->canvas_item_add_triangle_array(p_batch.canvas_item, p_batch.indices, p_batch.points, p_batch.colors, p_batch.uvs, Vector<int>(), Vector<float>(), p_batch.texture, -1, p_batch.normal_map);
+	}
+
+	p_batch.canvas_item = RID();
+	p_batch.texture = RID();
+	p_batch.normal_map = RID();
+	p_batch.points.clear();
+	p_batch.uvs.clear();
+	p_batch.colors.clear();
+	p_batch.indices.clear();
+}
+
+bool TileMap::_is_full_cell_shape(const Ref<Shape2D> &p_shape, const Transform2D &p_xform, const Rect2 &p_cell_rect) const {
+
+	Vector<Vector2> points;
+
+	Ref<RectangleShape2D> rect = p_shape;
+	Ref<ConvexPolygonShape2D> convex = p_shape;
+	if (rect.is_valid()) {
+		Vector2 e = rect->get_extents();
+		points.push_back(Vector2(-e.x, -e.y));
+		points.push_back(Vector2(e.x, -e.y));
+		points.push_back(Vector2(e.x, e.y));
+		points.push_back(Vector2(-e.x, e.y));
+	} else if (convex.is_valid() && !convex->has_meta("decomposed")) {
+		points = convex->get_points();
+	}
+
+	if (points.size() != 4)
+		return false;
+
+	const Vector2 corners[4] = {
+		p_cell_rect.position,
+		p_cell_rect.position + Vector2(p_cell_rect.size.x, 0),
+		p_cell_rect.position + p_cell_rect.size,
+		p_cell_rect.position + Vector2(0, p_cell_rect.size.y)
+	};
+
+	// Every corner of the cell must be hit by exactly one point.
+	int hit = 0;
+	for (int i = 0; i < 4; i++) {
+		Vector2 p = p_xform.xform(points[i]);
+		for (int j = 0; j < 4; j++) {
+			if (p.distance_squared_to(corners[j]) < CMP_EPSILON2 * 100) {
+				hit |= 1 << j;
+				break;
+			}
+		}
+	}
+
+	return hit == 0xF;
+}
+
+void TileMap::_add_merged_shapes(int &shape_idx, Quadrant &p_q, Set<PosKey> &p_solid_cells, const Vector2 &p_offset, RID p_debug_canvas_item, const Color &p_debug_color) {
+
+	TileSet::ShapeData shape_data;
+
+	// Greedy meshing: grow each remaining cell right, then down, as far as whole rows stay solid.
+	while (p_solid_cells.size()) {
+
+		PosKey from = p_solid_cells.front()->get();
+		PosKey to = from;
+
+		while (to.x < INT16_MAX && p_solid_cells.has(PosKey(to.x + 1, from.y)))
+			to.x++;
+
+		while (to.y < INT16_MAX) {
+			bool row_solid = true;
+			for (int x = from.x; x <= to.x; x++) {
+				if (!p_solid_cells.has(PosKey(x, to.y + 1))) {
+					row_solid = false;
+					break;
+				}
+			}
+			if (!row_solid)
+				break;
+			to.y++;
+		}
+
+		for (int y = from.y; y <= to.y; y++) {
+			for (int x = from.x; x <= to.x; x++) {
+				p_solid_cells.erase(PosKey(x, y));
+			}
+		}
+
+		Vector2 size = Vector2(to.x - from.x + 1, to.y - from.y + 1) * Size2(cell_size);
+
+		Ref<RectangleShape2D> shape;
+		shape.instance();
+		shape->set_extents(size / 2);
+		p_q.baked_shapes.push_back(shape);
+
+		Transform2D xform;
+		xform.set_origin((_map_to_world(from.x, from.y) - p_q.pos + p_offset).floor() + size / 2);
+
+		if (p_debug_canvas_item.is_valid()) {
+			VisualServer::get_singleton()->canvas_item_add_set_transform(p_debug_canvas_item, xform);
+			shape->draw(p_debug_canvas_item, p_debug_color);
+			VisualServer::get_singleton()->canvas_item_add_set_transform(p_debug_canvas_item, Transform2D());
+		}
+
+		_add_shape(shape_idx, p_q, shape, shape_data, xform, Vector2(from.x, from.y));
+	}
+}
+
 void TileMap::update_dirty_quadrants() {
 
 	if (!pending_update)
@@ -334,7 +502,6 @@ void TileMap::update_dirty_quadrants() {
 	}
 
 	VisualServer *vs = VisualServer::get_singleton();
-	Physics2DServer *ps = Physics2DServer::get_singleton();
 	Vector2 tofs = get_cell_draw_offset();
 	Transform2D nav_rel;
 	if (navigation)
@@ -356,41 +523,38 @@ void TileMap::update_dirty_quadrants() {
 		debug_navigation_color = st->get_debug_navigation_color();
 	}
 
+	uint64_t budget_begin = OS::get_singleton()->get_ticks_usec();
+	bool rebuilt = false;
+
 	while (dirty_quadrant_list.first()) {
 
+		// When streaming, spread rebuilds over several frames instead of stalling on one.
+		if (streaming && rebuilt && OS::get_singleton()->get_ticks_usec() - budget_begin > (uint64_t)streaming_budget_usec) {
+			break;
+		}
+
 		Quadrant &q = *dirty_quadrant_list.first()->self();
 
-		for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
+		_unload_quadrant(q);
 
-			vs->free(E->get());
+		if (!_is_quadrant_streamed_in(q)) {
+			dirty_quadrant_list.remove(dirty_quadrant_list.first());
+			continue;
 		}
 
-		q.canvas_items.clear();
-
-		if (!use_parent) {
-			ps->body_clear_shapes(q.body);
-		} else if (collision_parent) {
-			collision_parent->shape_owner_clear_shapes(q.shape_owner_id);
-		}
 		int shape_idx = 0;
+		rebuilt = true;
 
-		if (navigation) {
-			for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
-
-				navigation->navpoly_remove(E->get().id);
-			}
-			q.navpoly_ids.clear();
-		}
-
-		for (Map<PosKey, Quadrant::Occluder>::Element *E = q.occluder_instances.front(); E; E = E->next()) {
-			VS::get_singleton()->free(E->get().id);
-		}
-		q.occluder_instances.clear();
 		Ref<ShaderMaterial> prev_material;
 		int prev_z_index = 0;
 		RID prev_canvas_item;
 		RID prev_debug_canvas_item;
 
+		// Solid full-cell shapes are only merged on the regular square grid.
+		bool merge_shapes = bake_quadrants && mode == MODE_SQUARE && half_offset == HALF_OFFSET_DISABLED;
+		Set<PosKey> solid_cells;
+		BakedBatch baked_batch;
+
 		for (int i = 0; i < q.cells.size(); i++) {
 
 			Map<PosKey, Cell>::Element *E = tile_map.find(q.cells[i]);
@@ -420,6 +584,8 @@ void TileMap::update_dirty_quadrants() {
 
 			if (prev_canvas_item == RID() || prev_material != mat || prev_z_index != z_index) {
 
+				_flush_baked_batch(baked_batch);
+
 				canvas_item = vs->canvas_item_create();
 				if (mat.is_valid())
 					vs->canvas_item_set_material(canvas_item, mat->get_rid());
@@ -546,14 +712,40 @@ void TileMap::update_dirty_quadrants() {
 			Color self_modulate = get_self_modulate();
 			modulate = Color(modulate.r * self_modulate.r, modulate.g * self_modulate.g,
 					modulate.b * self_modulate.b, modulate.a * self_modulate.a);
-			if (r == Rect2()) {
-				tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
-			} else {
-				tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, clip_uv);
+			// Triangle arrays can't clip the uv to the region, clipped tiles keep their own rect.
+			bool bake = bake_quadrants && !(clip_uv && r != Rect2());
+			if (!bake || !_bake_cell_rect(baked_batch, canvas_item, tex, normal_map, rect, r, modulate, c.transpose)) {
+				_flush_baked_batch(baked_batch);
+				if (r == Rect2()) {
+					tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
+				} else {
+					tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, clip_uv);
+				}
 			}
 
 			Vector<TileSet::ShapeData> shapes = tile_set->tile_get_shapes(c.id);
 
+			if (merge_shapes) {
+				int cell_shape = -1;
+				for (int j = 0; j < shapes.size(); j++) {
+					if (shapes[j].shape.is_valid() && (tile_set->tile_get_tile_mode(c.id) == TileSet::SINGLE_TILE || (shapes[j].autotile_coord.x == c.autotile_coord_x && shapes[j].autotile_coord.y == c.autotile_coord_y))) {
+						cell_shape = cell_shape == -1 ? j : -2;
+					}
+				}
+
+				if (cell_shape >= 0 && !shapes[cell_shape].one_way_collision) {
+					Transform2D xform;
+					xform.set_origin(offset.floor());
+					_fix_cell_transform(xform, c, shapes[cell_shape].shape_transform.get_origin(), s);
+					xform *= shapes[cell_shape].shape_transform.untranslated();
+
+					if (_is_full_cell_shape(shapes[cell_shape].shape, xform, Rect2(offset.floor(), cell_size))) {
+						solid_cells.insert(E->key());
+						shapes.clear();
+					}
+				}
+			}
+
 			for (int j = 0; j < shapes.size(); j++) {
 				Ref<Shape2D> shape = shapes[j].shape;
 				if (shape.is_valid()) {
@@ -693,11 +885,19 @@ void TileMap::update_dirty_quadrants() {
 			}
 		}
 
+		_flush_baked_batch(baked_batch);
+
+		if (solid_cells.size()) {
+			_add_merged_shapes(shape_idx, q, solid_cells, tofs, prev_debug_canvas_item, debug_collision_color);
+		}
+
+		q.loaded = true;
 		dirty_quadrant_list.remove(dirty_quadrant_list.first());
 		quadrant_order_dirty = true;
 	}
 
-	pending_update = false;
+	// Whatever is left over is picked up by the streaming process on the next frame.
+	pending_update = dirty_quadrant_list.first() != NULL;
 
 	if (quadrant_order_dirty) {
 
@@ -751,6 +951,7 @@ Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(cons
 	Transform2D xform;
 	//xform.set_origin(Point2(p_qk.x,p_qk.y)*cell_size*quadrant_size);
 	Quadrant q;
+	q.area = _get_quadrant_area(p_qk);
 	q.pos = _map_to_world(p_qk.x * _get_quadrant_size(), p_qk.y * _get_quadrant_size());
 	q.pos += get_cell_draw_offset();
 	if (tile_origin == TILE_ORIGIN_CENTER)
@@ -840,6 +1041,212 @@ void TileMap::_make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool updat
 	}
 }
 
+void TileMap::_unload_quadrant(Quadrant &q) {
+
+	for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
+
+		VisualServer::get_singleton()->free(E->get());
+	}
+
+	q.canvas_items.clear();
+
+	if (!use_parent) {
+		Physics2DServer::get_singleton()->body_clear_shapes(q.body);
+	} else if (collision_parent) {
+		collision_parent->shape_owner_clear_shapes(q.shape_owner_id);
+	}
+
+	if (navigation) {
+		for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
+
+			navigation->navpoly_remove(E->get().id);
+		}
+		q.navpoly_ids.clear();
+	}
+
+	for (Map<PosKey, Quadrant::Occluder>::Element *E = q.occluder_instances.front(); E; E = E->next()) {
+		VS::get_singleton()->free(E->get().id);
+	}
+	q.occluder_instances.clear();
+	q.baked_shapes.clear();
+	q.loaded = false;
+}
+
+Rect2 TileMap::_get_quadrant_area(const PosKey &p_qk) const {
+
+	int qs = _get_quadrant_size();
+	int x = p_qk.x * qs;
+	int y = p_qk.y * qs;
+
+	Rect2 area(_map_to_world(x, y), Size2());
+	area.expand_to(_map_to_world(x + qs, y));
+	area.expand_to(_map_to_world(x, y + qs));
+	area.expand_to(_map_to_world(x + qs, y + qs));
+
+	// Leave room for the draw offset and tiles larger than a cell.
+	return area.grow(MAX(cell_size.x, cell_size.y));
+}
+
+bool TileMap::_is_quadrant_streamed_in(const Quadrant &p_q) const {
+
+	if (!streaming || streaming_view_rect.has_no_area())
+		return true;
+
+	return p_q.area.intersects(streaming_view_rect);
+}
+
+void TileMap::_update_streaming() {
+
+	if (!streaming || !is_inside_tree())
+		return;
+
+	Transform2D to_local = (get_canvas_transform() * get_global_transform()).affine_inverse();
+	Rect2 view = to_local.xform(get_viewport_rect()).grow(streaming_margin);
+
+	if (view != streaming_view_rect) {
+
+		streaming_view_rect = view;
+
+		if (chunk_access) {
+
+			Rect2 cells(world_to_map(view.position), Size2());
+			cells.expand_to(world_to_map(view.position + Vector2(view.size.x, 0)));
+			cells.expand_to(world_to_map(view.position + Vector2(0, view.size.y)));
+			cells.expand_to(world_to_map(view.position + view.size));
+			cells.size += Vector2(1, 1);
+
+			// Chunks are kept one chunk past the view before being paged out, to avoid thrashing on the border.
+			Rect2 keep = cells.grow(chunk_size);
+
+			for (Map<PosKey, ChunkInfo>::Element *E = chunk_index.front(); E; E = E->next()) {
+
+				Rect2 chunk_rect(Vector2(E->key().x, E->key().y) * chunk_size, Vector2(chunk_size, chunk_size));
+				bool paged = paged_chunks.has(E->key());
+
+				if (!paged && cells.intersects(chunk_rect)) {
+					_page_in_chunk(E->key());
+				} else if (paged && !keep.intersects(chunk_rect) && !modified_chunks.has(E->key())) {
+					_page_out_chunk(E->key());
+				}
+			}
+		}
+
+		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+
+			Quadrant &q = E->get();
+			if (q.area.intersects(streaming_view_rect) != q.loaded) {
+				_make_quadrant_dirty(E, false);
+			}
+		}
+	}
+
+	update_dirty_quadrants();
+}
+
+Error TileMap::_open_chunk_file() {
+
+	_close_chunk_file();
+
+	if (streaming_chunk_file == "")
+		return OK;
+
+	Error err;
+	chunk_access = FileAccess::open(streaming_chunk_file, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(!chunk_access, err, "Cannot open TileMap chunk file '" + streaming_chunk_file + "'.");
+
+	uint8_t magic[4];
+	chunk_access->get_buffer(magic, 4);
+	uint32_t version = chunk_access->get_32();
+	chunk_size = chunk_access->get_32();
+	uint32_t chunk_count = chunk_access->get_32();
+
+	if (magic[0] != 'G' || magic[1] != 'D' || magic[2] != 'T' || magic[3] != 'C' || version != 1 || chunk_size < 1 || chunk_size > 256) {
+		_close_chunk_file();
+		ERR_FAIL_V_MSG(ERR_FILE_UNRECOGNIZED, "Unrecognized TileMap chunk file '" + streaming_chunk_file + "'.");
+	}
+
+	// Everything read from the file is checked against its length, chunks are paged in later on.
+	uint64_t len = chunk_access->get_len();
+	uint64_t cells_start = CHUNK_HEADER_SIZE + uint64_t(chunk_count) * CHUNK_INDEX_ENTRY_SIZE;
+	if (cells_start > len) {
+		_close_chunk_file();
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Corrupt TileMap chunk file '" + streaming_chunk_file + "', chunk index is truncated.");
+	}
+
+	for (uint32_t i = 0; i < chunk_count; i++) {
+
+		PosKey key((int16_t)chunk_access->get_16(), (int16_t)chunk_access->get_16());
+		ChunkInfo info;
+		info.cell_count = chunk_access->get_32();
+		info.offset = chunk_access->get_64();
+
+		if (info.cell_count > uint32_t(chunk_size * chunk_size) || info.offset < cells_start || info.offset > len || uint64_t(info.cell_count) * CHUNK_CELL_SIZE > len - info.offset) {
+			_close_chunk_file();
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Corrupt TileMap chunk file '" + streaming_chunk_file + "', chunk " + itos(i) + " is out of bounds.");
+		}
+
+		chunk_index[key] = info;
+	}
+
+	return OK;
+}
+
+void TileMap::_close_chunk_file() {
+
+	if (chunk_access) {
+		memdelete(chunk_access);
+		chunk_access = NULL;
+	}
+
+	chunk_index.clear();
+	paged_chunks.clear();
+	modified_chunks.clear();
+}
+
+void TileMap::_page_in_chunk(const PosKey &p_chunk) {
+
+	Map<PosKey, ChunkInfo>::Element *C = chunk_index.find(p_chunk);
+	ERR_FAIL_COND(!C || !chunk_access);
+
+	paged_chunks.insert(p_chunk);
+	paging_chunk = true;
+
+	chunk_access->seek(C->get().offset);
+	for (uint32_t i = 0; i < C->get().cell_count; i++) {
+
+		int x = p_chunk.x * chunk_size + chunk_access->get_8();
+		int y = p_chunk.y * chunk_size + chunk_access->get_8();
+		uint32_t v = chunk_access->get_32();
+		int16_t coord_x = chunk_access->get_16();
+		int16_t coord_y = chunk_access->get_16();
+
+		set_cell(x, y, v & ((1 << 29) - 1), v & (1 << 29), v & (1 << 30), v & (1 << 31), Vector2(coord_x, coord_y));
+	}
+
+	paging_chunk = false;
+}
+
+void TileMap::_page_out_chunk(const PosKey &p_chunk) {
+
+	Map<PosKey, ChunkInfo>::Element *C = chunk_index.find(p_chunk);
+	ERR_FAIL_COND(!C || !chunk_access);
+
+	paged_chunks.erase(p_chunk);
+	paging_chunk = true;
+
+	chunk_access->seek(C->get().offset);
+	for (uint32_t i = 0; i < C->get().cell_count; i++) {
+
+		int x = p_chunk.x * chunk_size + chunk_access->get_8();
+		int y = p_chunk.y * chunk_size + chunk_access->get_8();
+		chunk_access->seek(chunk_access->get_position() + 8);
+
+		set_cell(x, y, INVALID_CELL);
+	}
+
+	paging_chunk = false;
+}
+
 void TileMap::set_cellv(const Vector2 &p_pos, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose) {
 
 	set_cell(p_pos.x, p_pos.y, p_tile, p_flip_x, p_flip_y, p_transpose);
@@ -857,6 +1264,15 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 
 	PosKey pk(p_x, p_y);
 
+	if (chunk_access && !paging_chunk) {
+		// Edits are applied on top of the stored chunk, which then stays resident.
+		PosKey ck = pk.to_quadrant(chunk_size);
+		if (!paged_chunks.has(ck) && chunk_index.has(ck)) {
+			_page_in_chunk(ck);
+		}
+		modified_chunks.insert(ck);
+	}
+
 	Map<PosKey, Cell>::Element *E = tile_map.find(pk);
 	if (!E && p_tile == INVALID_CELL)
 		return; //nothing to do
@@ -1197,6 +1613,8 @@ void TileMap::clear() {
 
 	_clear_quadrants();
 	tile_map.clear();
+	paged_chunks.clear();
+	modified_chunks.clear();
 	used_size_cache_dirty = true;
 }
 
@@ -1210,6 +1628,10 @@ void TileMap::_set_tile_data(const PoolVector<int> &p_data) {
 	int offset = (format == FORMAT_2) ? 3 : 2;
 
 	clear();
+
+	// Saved cells are all a chunk holds once edited, nothing is paged in under them.
+	paging_chunk = true;
+
 	for (int i = 0; i < c; i += offset) {
 
 		const uint8_t *ptr = (const uint8_t *)&r[i];
@@ -1245,7 +1667,45 @@ void TileMap::_set_tile_data(const PoolVector<int> &p_data) {
 		}
 
 		set_cell(x, y, v, flip_h, flip_v, transpose, Vector2(coord_x, coord_y));
+
+		if (chunk_access) {
+			PosKey ck = PosKey(x, y).to_quadrant(chunk_size);
+			modified_chunks.insert(ck);
+			paged_chunks.insert(ck);
+		}
 	}
+
+	paging_chunk = false;
+}
+
+void TileMap::_set_modified_chunks(const PoolVector<int> &p_data) {
+
+	ERR_FAIL_COND(p_data.size() % 2);
+
+	// Also covers chunks whose cells were all erased, which left nothing in tile_data.
+	PoolVector<int>::Read r = p_data.read();
+	for (int i = 0; i < p_data.size(); i += 2) {
+		PosKey ck(r[i], r[i + 1]);
+		modified_chunks.insert(ck);
+		paged_chunks.insert(ck);
+	}
+}
+
+PoolVector<int> TileMap::_get_modified_chunks() const {
+
+	PoolVector<int> data;
+	data.resize(modified_chunks.size() * 2);
+	PoolVector<int>::Write w = data.write();
+
+	int idx = 0;
+	for (const Set<PosKey>::Element *E = modified_chunks.front(); E; E = E->next()) {
+		w[idx++] = E->get().x;
+		w[idx++] = E->get().y;
+	}
+
+	w.release();
+
+	return data;
 }
 
 PoolVector<int> TileMap::_get_tile_data() const {
@@ -1258,6 +1718,12 @@ PoolVector<int> TileMap::_get_tile_data() const {
 
 	int idx = 0;
 	for (const Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+		if (paged_chunks.size()) {
+			// Unmodified cells paged in from the chunk file are not duplicated into the scene.
+			PosKey ck = E->key().to_quadrant(chunk_size);
+			if (paged_chunks.has(ck) && !modified_chunks.has(ck))
+				continue;
+		}
 		uint8_t *ptr = (uint8_t *)&w[idx];
 		encode_uint16(E->key().x, &ptr[0]);
 		encode_uint16(E->key().y, &ptr[2]);
@@ -1275,6 +1741,7 @@ PoolVector<int> TileMap::_get_tile_data() const {
 	}
 
 	w.release();
+	data.resize(idx);
 
 	return data;
 }
@@ -1571,6 +2038,12 @@ bool TileMap::_set(const StringName &p_name, const Variant &p_value) {
 			return true;
 		}
 		return false;
+	} else if (p_name == "modified_chunks") {
+		if (p_value.is_array()) {
+			_set_modified_chunks(p_value);
+			return true;
+		}
+		return false;
 	}
 	return false;
 }
@@ -1583,6 +2056,9 @@ bool TileMap::_get(const StringName &p_name, Variant &r_ret) const {
 	} else if (p_name == "tile_data") {
 		r_ret = _get_tile_data();
 		return true;
+	} else if (p_name == "modified_chunks") {
+		r_ret = _get_modified_chunks();
+		return true;
 	}
 	return false;
 }
@@ -1594,6 +2070,12 @@ void TileMap::_get_property_list(List<PropertyInfo> *p_list) const {
 
 	p = PropertyInfo(Variant::OBJECT, "tile_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL);
 	p_list->push_back(p);
+
+	// After tile_data, which clears it.
+	if (modified_chunks.size()) {
+		p = PropertyInfo(Variant::POOL_INT_ARRAY, "modified_chunks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL);
+		p_list->push_back(p);
+	}
 }
 
 void TileMap::_validate_property(PropertyInfo &property) const {
@@ -1777,6 +2259,163 @@ bool TileMap::get_clip_uv() const {
 	return clip_uv;
 }
 
+void TileMap::set_bake_quadrants(bool p_enable) {
+
+	if (bake_quadrants == p_enable)
+		return;
+
+	_clear_quadrants();
+	bake_quadrants = p_enable;
+	_recreate_quadrants();
+}
+
+bool TileMap::is_bake_quadrants_enabled() const {
+
+	return bake_quadrants;
+}
+
+void TileMap::set_streaming_enabled(bool p_enable) {
+
+	if (streaming == p_enable)
+		return;
+
+	streaming = p_enable;
+	streaming_view_rect = Rect2();
+	set_process_internal(streaming);
+
+	if (!streaming) {
+		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+			if (!E->get().loaded)
+				_make_quadrant_dirty(E);
+		}
+	}
+}
+
+bool TileMap::is_streaming_enabled() const {
+
+	return streaming;
+}
+
+void TileMap::set_streaming_margin(float p_margin) {
+
+	streaming_margin = p_margin;
+	streaming_view_rect = Rect2();
+}
+
+float TileMap::get_streaming_margin() const {
+
+	return streaming_margin;
+}
+
+void TileMap::set_streaming_budget_usec(int p_usec) {
+
+	ERR_FAIL_COND(p_usec < 0);
+	streaming_budget_usec = p_usec;
+}
+
+int TileMap::get_streaming_budget_usec() const {
+
+	return streaming_budget_usec;
+}
+
+void TileMap::set_streaming_chunk_file(const String &p_path) {
+
+	if (streaming_chunk_file == p_path)
+		return;
+
+	// Drop what came from the previous file, edited chunks stay as regular cells.
+	while (paged_chunks.size()) {
+		PosKey ck = paged_chunks.front()->get();
+		if (modified_chunks.has(ck))
+			paged_chunks.erase(ck);
+		else
+			_page_out_chunk(ck);
+	}
+
+	streaming_chunk_file = p_path;
+	streaming_view_rect = Rect2();
+	_open_chunk_file();
+}
+
+String TileMap::get_streaming_chunk_file() const {
+
+	return streaming_chunk_file;
+}
+
+Error TileMap::save_chunk_file(const String &p_path, int p_chunk_size) {
+
+	ERR_FAIL_COND_V(p_chunk_size < 1 || p_chunk_size > 256, ERR_INVALID_PARAMETER);
+
+	// Everything has to be resident to be written out.
+	for (Map<PosKey, ChunkInfo>::Element *E = chunk_index.front(); E; E = E->next()) {
+		if (!paged_chunks.has(E->key()))
+			_page_in_chunk(E->key());
+	}
+
+	Map<PosKey, Vector<PosKey> > chunks;
+	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+		chunks[E->key().to_quadrant(p_chunk_size)].push_back(E->key());
+	}
+
+	bool reopen = chunk_access && p_path == streaming_chunk_file;
+	if (reopen) {
+		_close_chunk_file();
+	}
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot save TileMap chunk file '" + p_path + "'.");
+
+	f->store_buffer((const uint8_t *)"GDTC", 4);
+	f->store_32(1);
+	f->store_32(p_chunk_size);
+	f->store_32(chunks.size());
+
+	uint64_t offset = CHUNK_HEADER_SIZE + uint64_t(chunks.size()) * CHUNK_INDEX_ENTRY_SIZE;
+	for (Map<PosKey, Vector<PosKey> >::Element *E = chunks.front(); E; E = E->next()) {
+		f->store_16(E->key().x);
+		f->store_16(E->key().y);
+		f->store_32(E->get().size());
+		f->store_64(offset);
+		offset += E->get().size() * CHUNK_CELL_SIZE;
+	}
+
+	for (Map<PosKey, Vector<PosKey> >::Element *E = chunks.front(); E; E = E->next()) {
+
+		for (int i = 0; i < E->get().size(); i++) {
+
+			const PosKey &pk = E->get()[i];
+			const Cell &c = tile_map[pk];
+
+			uint32_t val = c.id;
+			if (c.flip_h)
+				val |= (1 << 29);
+			if (c.flip_v)
+				val |= (1 << 30);
+			if (c.transpose)
+				val |= (1 << 31);
+
+			f->store_8(pk.x - E->key().x * p_chunk_size);
+			f->store_8(pk.y - E->key().y * p_chunk_size);
+			f->store_32(val);
+			f->store_16(c.autotile_coord_x);
+			f->store_16(c.autotile_coord_y);
+		}
+	}
+
+	memdelete(f);
+
+	if (reopen) {
+		_open_chunk_file();
+		// The resident cells match the file we just wrote.
+		for (Map<PosKey, ChunkInfo>::Element *E = chunk_index.front(); E; E = E->next()) {
+			paged_chunks.insert(E->key());
+		}
+	}
+
+	return OK;
+}
+
 String TileMap::get_configuration_warning() const {
 
 	String warning = Node2D::get_configuration_warning();
@@ -1820,6 +2459,19 @@ void TileMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_clip_uv", "enable"), &TileMap::set_clip_uv);
 	ClassDB::bind_method(D_METHOD("get_clip_uv"), &TileMap::get_clip_uv);
 
+	ClassDB::bind_method(D_METHOD("set_bake_quadrants", "enable"), &TileMap::set_bake_quadrants);
+	ClassDB::bind_method(D_METHOD("is_bake_quadrants_enabled"), &TileMap::is_bake_quadrants_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_streaming_enabled", "enable"), &TileMap::set_streaming_enabled);
+	ClassDB::bind_method(D_METHOD("is_streaming_enabled"), &TileMap::is_streaming_enabled);
+	ClassDB::bind_method(D_METHOD("set_streaming_margin", "margin"), &TileMap::set_streaming_margin);
+	ClassDB::bind_method(D_METHOD("get_streaming_margin"), &TileMap::get_streaming_margin);
+	ClassDB::bind_method(D_METHOD("set_streaming_budget_usec", "usec"), &TileMap::set_streaming_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_streaming_budget_usec"), &TileMap::get_streaming_budget_usec);
+	ClassDB::bind_method(D_METHOD("set_streaming_chunk_file", "path"), &TileMap::set_streaming_chunk_file);
+	ClassDB::bind_method(D_METHOD("get_streaming_chunk_file"), &TileMap::get_streaming_chunk_file);
+	ClassDB::bind_method(D_METHOD("save_chunk_file", "path", "chunk_size"), &TileMap::save_chunk_file, DEFVAL(64));
+
 	ClassDB::bind_method(D_METHOD("set_y_sort_mode", "enable"), &TileMap::set_y_sort_mode);
 	ClassDB::bind_method(D_METHOD("is_y_sort_mode_enabled"), &TileMap::is_y_sort_mode_enabled);
 
@@ -1900,6 +2552,7 @@ void TileMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compatibility_mode"), "set_compatibility_mode", "is_compatibility_mode_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "centered_textures"), "set_centered_textures", "is_centered_textures_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_clip_uv"), "set_clip_uv", "get_clip_uv");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bake_quadrants"), "set_bake_quadrants", "is_bake_quadrants_enabled");
 
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_use_parent", PROPERTY_HINT_NONE, ""), "set_collision_use_parent", "get_collision_use_parent");
@@ -1909,6 +2562,12 @@ void TileMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_mask", "get_collision_mask");
 
+	ADD_GROUP("Streaming", "streaming_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "streaming_enabled"), "set_streaming_enabled", "is_streaming_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "streaming_margin", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_streaming_margin", "get_streaming_margin");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "streaming_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), "set_streaming_budget_usec", "get_streaming_budget_usec");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "streaming_chunk_file", PROPERTY_HINT_FILE, "*.tchunks"), "set_streaming_chunk_file", "get_streaming_chunk_file");
+
 	ADD_GROUP("Occluder", "occluder_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "occluder_light_mask", PROPERTY_HINT_LAYERS_2D_RENDER), "set_occluder_light_mask", "get_occluder_light_mask");
 
@@ -1963,6 +2622,13 @@ TileMap::TileMap() {
 	centered_textures = false;
 	occluder_light_mask = 1;
 	clip_uv = false;
+	bake_quadrants = false;
+	streaming = false;
+	streaming_margin = 256;
+	streaming_budget_usec = 2000;
+	chunk_access = NULL;
+	chunk_size = 64;
+	paging_chunk = false;
 	format = FORMAT_1; // Assume lowest possible format if none is present
 
 	fp_adjust = 0.00001;
@@ -1977,4 +2643,5 @@ TileMap::~TileMap() {
 		tile_set->remove_change_receptor(this);
 
 	clear();
+	_close_chunk_file();
 }
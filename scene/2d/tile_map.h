@@ -31,6 +31,7 @@
 #ifndef TILE_MAP_H
 #define TILE_MAP_H
 
+#include "core/os/file_access.h"
 #include "core/self_list.h"
 #include "core/vset.h"
 #include "scene/2d/navigation_2d.h"
@@ -132,6 +133,8 @@ private:
 	struct Quadrant {
 
 		Vector2 pos;
+		Rect2 area;
+		bool loaded;
 		List<RID> canvas_items;
 		RID body;
 		uint32_t shape_owner_id;
@@ -152,34 +155,54 @@ private:
 		Map<PosKey, Occluder> occluder_instances;
 
 		VSet<PosKey> cells;
+		Vector<Ref<Shape2D> > baked_shapes;
 
 		void operator=(const Quadrant &q) {
 			pos = q.pos;
+			area = q.area;
+			loaded = q.loaded;
 			canvas_items = q.canvas_items;
 			body = q.body;
 			shape_owner_id = q.shape_owner_id;
 			cells = q.cells;
 			navpoly_ids = q.navpoly_ids;
 			occluder_instances = q.occluder_instances;
+			baked_shapes = q.baked_shapes;
 		}
 		Quadrant(const Quadrant &q) :
 				dirty_list(this) {
 			pos = q.pos;
+			area = q.area;
+			loaded = q.loaded;
 			canvas_items = q.canvas_items;
 			body = q.body;
 			shape_owner_id = q.shape_owner_id;
 			cells = q.cells;
 			occluder_instances = q.occluder_instances;
 			navpoly_ids = q.navpoly_ids;
+			baked_shapes = q.baked_shapes;
 		}
 		Quadrant() :
-				dirty_list(this) {}
+				dirty_list(this) {
+			loaded = false;
+		}
 	};
 
 	Map<PosKey, Quadrant> quadrant_map;
 
 	SelfList<Quadrant>::List dirty_quadrant_list;
 
+	// Cells sharing a texture are accumulated here and drawn as a single triangle array.
+	struct BakedBatch {
+		RID canvas_item;
+		RID texture;
+		RID normal_map;
+		Vector<Vector2> points;
+		Vector<Vector2> uvs;
+		Vector<Color> colors;
+		Vector<int> indices;
+	};
+
 	bool pending_update;
 
 	Rect2 rect_cache;
@@ -191,7 +214,32 @@ private:
 	bool compatibility_mode;
 	bool centered_textures;
 	bool clip_uv;
+	bool bake_quadrants;
 	float fp_adjust;
+
+	// Chunk file layout: header, then one index entry per chunk, then the cells of each chunk.
+	enum {
+		CHUNK_HEADER_SIZE = 16,
+		CHUNK_INDEX_ENTRY_SIZE = 16,
+		CHUNK_CELL_SIZE = 10
+	};
+
+	struct ChunkInfo {
+		uint64_t offset;
+		uint32_t cell_count;
+	};
+
+	bool streaming;
+	float streaming_margin;
+	int streaming_budget_usec;
+	Rect2 streaming_view_rect;
+	String streaming_chunk_file;
+	FileAccess *chunk_access;
+	int chunk_size;
+	Map<PosKey, ChunkInfo> chunk_index;
+	Set<PosKey> paged_chunks;
+	Set<PosKey> modified_chunks;
+	bool paging_chunk;
 	float friction;
 	float bounce;
 	uint32_t collision_layer;
@@ -206,9 +254,23 @@ private:
 
 	void _add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata);
 
+	bool _bake_cell_rect(BakedBatch &p_batch, const RID &p_canvas_item, const Ref<Texture> &p_texture, const Ref<Texture> &p_normal_map, const Rect2 &p_rect, const Rect2 &p_region, const Color &p_modulate, bool p_transpose);
+	void _flush_baked_batch(BakedBatch &p_batch);
+	bool _is_full_cell_shape(const Ref<Shape2D> &p_shape, const Transform2D &p_xform, const Rect2 &p_cell_rect) const;
+	void _add_merged_shapes(int &shape_idx, Quadrant &p_q, Set<PosKey> &p_solid_cells, const Vector2 &p_offset, RID p_debug_canvas_item, const Color &p_debug_color);
+
 	Map<PosKey, Quadrant>::Element *_create_quadrant(const PosKey &p_qk);
 	void _erase_quadrant(Map<PosKey, Quadrant>::Element *Q);
 	void _make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update = true);
+	void _unload_quadrant(Quadrant &q);
+	Rect2 _get_quadrant_area(const PosKey &p_qk) const;
+	bool _is_quadrant_streamed_in(const Quadrant &p_q) const;
+	void _update_streaming();
+
+	Error _open_chunk_file();
+	void _close_chunk_file();
+	void _page_in_chunk(const PosKey &p_chunk);
+	void _page_out_chunk(const PosKey &p_chunk);
 	void _recreate_quadrants();
 	void _clear_quadrants();
 	void _update_quadrant_space(const RID &p_space);
@@ -222,6 +284,8 @@ private:
 
 	void _set_tile_data(const PoolVector<int> &p_data);
 	PoolVector<int> _get_tile_data() const;
+	void _set_modified_chunks(const PoolVector<int> &p_data);
+	PoolVector<int> _get_modified_chunks() const;
 
 	void _set_old_cell_size(int p_size) { set_cell_size(Size2(p_size, p_size)); }
 	int _get_old_cell_size() const { return cell_size.x; }
@@ -344,6 +408,23 @@ public:
 	void set_clip_uv(bool p_enable);
 	bool get_clip_uv() const;
 
+	void set_bake_quadrants(bool p_enable);
+	bool is_bake_quadrants_enabled() const;
+
+	void set_streaming_enabled(bool p_enable);
+	bool is_streaming_enabled() const;
+
+	void set_streaming_margin(float p_margin);
+	float get_streaming_margin() const;
+
+	void set_streaming_budget_usec(int p_usec);
+	int get_streaming_budget_usec() const;
+
+	void set_streaming_chunk_file(const String &p_path);
+	String get_streaming_chunk_file() const;
+
+	Error save_chunk_file(const String &p_path, int p_chunk_size = 64);
+
 	String get_configuration_warning() const;
 
 	void fix_invalid_tiles();
@@ -30,10 +30,13 @@
 
 #include "audio_stream_player_3d.h"
 #include "core/engine.h"
+#include "core/project_settings.h"
+#include "core/sort_array.h"
 #include "scene/3d/area.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/listener.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix.h"
 
 // Based on "A Novel Multichannel Panning Method for Standard and Arbitrary Loudspeaker Configurations" by Ramy Sadek and Chris Kyriakakis (2004)
 // Speaker-Placement Correction Amplitude Panning (SPCAP)
@@ -139,14 +142,70 @@ void AudioStreamPlayer3D::_mix_audio() {
 	if (setseek >= 0.0) {
 		stream_playback->start(setseek);
 		setseek = -1.0; //reset seek
+		voice_skip = 0;
 		started = true;
 	}
 
+	bool fade_in = stream_paused_fade_in;
+	bool fade_out = stream_paused_fade_out;
+	bool going_virtual = false;
+
+	if (voice_virtual_requested && !voice_virtual) {
+		voice_virtual = true;
+		voice_skip_limit = stream->get_length() - stream_playback->get_playback_position();
+		//ramp to silence first, unless nothing was heard yet
+		going_virtual = !started;
+		fade_out = going_virtual;
+	} else if (!voice_virtual_requested && voice_virtual) {
+		//catch up with the time spent virtual and fade in with fresh outputs
+		voice_virtual = false;
+		if (voice_skip > 0) {
+			stream_playback->skip(voice_skip);
+			voice_skip = 0;
+		}
+		prev_output_count = 0;
+		fade_in = true;
+	}
+
+	float rate_scale = pitch_scale;
+	if (output_count) {
+		//used for doppler, not realistic but good enough
+		float output_pitch_scale = 0.0;
+		for (int i = 0; i < output_count; i++) {
+			output_pitch_scale += outputs[i].pitch_scale;
+		}
+		rate_scale *= output_pitch_scale / float(output_count);
+	}
+	//stream seconds played per mixed frame
+	float frame_time = rate_scale / (AudioServer::get_singleton()->get_mix_rate() * AudioServer::get_singleton()->get_global_rate_scale());
+
+	if (voice_virtual && !going_virtual) {
+
+		//only advance the position, stopping or looping when the stream would
+		if (output_count > 0 || out_of_range_mode == OUT_OF_RANGE_MIX) {
+			voice_skip += mix_buffer.size() * frame_time;
+			if (voice_skip >= voice_skip_limit) {
+				stream_playback->skip(voice_skip);
+				voice_skip = 0;
+				voice_skip_limit = stream->get_length() - stream_playback->get_playback_position();
+			}
+		}
+
+		if (!stream_playback->is_playing()) {
+			active = false;
+		}
+
+		output_ready = false;
+		stream_paused_fade_in = false;
+		stream_paused_fade_out = false;
+		return;
+	}
+
 	//get data
 	AudioFrame *buffer = mix_buffer.ptrw();
 	int buffer_size = mix_buffer.size();
 
-	if (stream_paused_fade_out) {
+	if (fade_out) {
 		// Short fadeout ramp
 		buffer_size = MIN(buffer_size, 128);
 	}
@@ -154,18 +213,11 @@ void AudioStreamPlayer3D::_mix_audio() {
 	// Mix if we're not paused or we're fading out
 	if ((output_count > 0 || out_of_range_mode == OUT_OF_RANGE_MIX)) {
 
-		float output_pitch_scale = 0.0;
-		if (output_count) {
-			//used for doppler, not realistic but good enough
-			for (int i = 0; i < output_count; i++) {
-				output_pitch_scale += outputs[i].pitch_scale;
-			}
-			output_pitch_scale /= float(output_count);
-		} else {
-			output_pitch_scale = 1.0;
-		}
+		stream_playback->mix(buffer, rate_scale, buffer_size);
 
-		stream_playback->mix(buffer, pitch_scale * output_pitch_scale, buffer_size);
+		if (going_virtual) {
+			voice_skip += (mix_buffer.size() - buffer_size) * frame_time;
+		}
 	}
 
 	//write all outputs
@@ -202,8 +254,8 @@ void AudioStreamPlayer3D::_mix_audio() {
 		int buffers = AudioServer::get_singleton()->get_channel_count();
 
 		for (int k = 0; k < buffers; k++) {
-			AudioFrame target_volume = stream_paused_fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
-			AudioFrame vol_prev = stream_paused_fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol[k];
+			AudioFrame target_volume = fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
+			AudioFrame vol_prev = fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol[k];
 			AudioFrame vol_inc = (target_volume - vol_prev) / float(buffer_size);
 			AudioFrame vol = vol_prev;
 
@@ -261,22 +313,14 @@ void AudioStreamPlayer3D::_mix_audio() {
 
 				AudioFrame *rtarget = AudioServer::get_singleton()->thread_get_channel_mix_buffer(current.reverb_bus_index, k);
 
-				if (current.reverb_bus_index == prev_outputs[i].reverb_bus_index) {
-					AudioFrame rvol_inc = (current.reverb_vol[k] - prev_outputs[i].reverb_vol[k]) / float(buffer_size);
-					AudioFrame rvol = prev_outputs[i].reverb_vol[k];
-
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-						rvol += rvol_inc;
-					}
+				if (fade_in || fade_out || current.reverb_bus_index == prev_outputs[i].reverb_bus_index) {
+					AudioFrame rvol_target = fade_out ? AudioFrame(0.f, 0.f) : current.reverb_vol[k];
+					AudioFrame rvol_prev = fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].reverb_vol[k];
+					AudioFrame rvol_inc = (rvol_target - rvol_prev) / float(buffer_size);
+					AudioMix::add_ramp(rtarget, buffer, buffer_size, rvol_prev, rvol_inc);
 				} else {
 
-					AudioFrame rvol = current.reverb_vol[k];
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-					}
+					AudioMix::add_ramp(rtarget, buffer, buffer_size, current.reverb_vol[k], AudioFrame(0, 0));
 				}
 			}
 		}
@@ -284,7 +328,7 @@ void AudioStreamPlayer3D::_mix_audio() {
 		prev_outputs[i] = current;
 	}
 
-	prev_output_count = output_count;
+	prev_output_count = going_virtual ? 0 : output_count;
 
 	//stream is no longer active, disable this.
 	if (!stream_playback->is_playing()) {
@@ -329,11 +373,72 @@ float AudioStreamPlayer3D::_get_attenuation_db(float p_distance) const {
 void _update_sound() {
 }
 
+SelfList<AudioStreamPlayer3D>::List AudioStreamPlayer3D::voices;
+uint64_t AudioStreamPlayer3D::voices_frame = 0;
+
+struct AudioStreamPlayer3D::VoiceSort {
+
+	_FORCE_INLINE_ float _rank(const AudioStreamPlayer3D *p_voice) const {
+		//favor voices already playing so two close ones don't keep swapping
+		return p_voice->voice_virtual_requested ? p_voice->voice_audibility : p_voice->voice_audibility * 1.5;
+	}
+
+	_FORCE_INLINE_ bool operator()(const AudioStreamPlayer3D *p_a, const AudioStreamPlayer3D *p_b) const {
+		if (p_a->voice_priority != p_b->voice_priority) {
+			return p_a->voice_priority > p_b->voice_priority;
+		}
+		return _rank(p_a) > _rank(p_b);
+	}
+};
+
+bool AudioStreamPlayer3D::_can_virtualize() const {
+
+	//only streams with a known length can be moved forward without mixing
+	return stream.is_valid() && stream->get_length() > 0;
+}
+
+void AudioStreamPlayer3D::_update_voices() {
+
+	//run once per physics frame, by whichever player processes first
+	uint64_t frame = Engine::get_singleton()->get_physics_frames();
+	if (voices_frame == frame)
+		return;
+	voices_frame = frame;
+
+	int max_voices = GLOBAL_GET("audio/max_3d_voices");
+	float threshold = Math::db2linear(float(GLOBAL_GET("audio/virtual_voice_threshold_db")));
+
+	Vector<AudioStreamPlayer3D *> audible;
+
+	for (SelfList<AudioStreamPlayer3D> *E = voices.first(); E; E = E->next()) {
+
+		AudioStreamPlayer3D *voice = E->self();
+		if (!voice->active || !voice->_can_virtualize())
+			continue;
+
+		if (voice->voice_audibility < threshold) {
+			voice->voice_virtual_requested = true;
+		} else {
+			audible.push_back(voice);
+		}
+	}
+
+	if (max_voices > 0 && audible.size() > max_voices) {
+		SortArray<AudioStreamPlayer3D *, VoiceSort> sorter;
+		sorter.sort(audible.ptrw(), audible.size());
+	}
+
+	for (int i = 0; i < audible.size(); i++) {
+		audible[i]->voice_virtual_requested = max_voices > 0 && i >= max_voices;
+	}
+}
+
 void AudioStreamPlayer3D::_notification(int p_what) {
 
 	if (p_what == NOTIFICATION_ENTER_TREE) {
 
 		velocity_tracker->reset(get_global_transform().origin);
+		voices.add(&voice_list);
 		AudioServer::get_singleton()->add_callback(_mix_audios, this);
 		if (autoplay && !Engine::get_singleton()->is_editor_hint()) {
 			play();
@@ -343,6 +448,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 
 		AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+		voices.remove(&voice_list);
 	}
 
 	if (p_what == NOTIFICATION_PAUSED) {
@@ -366,8 +472,11 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS) {
 
 		//update anything related to position first, if possible of course
+		//virtual voices can't be heard, so they are updated less often
 
-		if (!output_ready) {
+		bool update_outputs = !voice_virtual_requested || (Engine::get_singleton()->get_physics_frames() + get_instance_id()) % VIRTUAL_UPDATE_INTERVAL == 0;
+
+		if (!output_ready && update_outputs) {
 
 			Vector3 linear_velocity;
 
@@ -380,6 +489,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 			ERR_FAIL_COND(world.is_null());
 
 			int new_output_count = 0;
+			float audibility = 0;
 
 			Vector3 global_pos = get_global_transform().origin;
 
@@ -605,6 +715,10 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 					}
 				}
 
+				for (int i = 0; i < vol_index_max; i++) {
+					audibility = MAX(audibility, MAX(MAX(output.vol[i].l, output.vol[i].r), MAX(output.reverb_vol[i].l, output.reverb_vol[i].r)));
+				}
+
 				outputs[new_output_count] = output;
 				new_output_count++;
 				if (new_output_count == MAX_OUTPUTS)
@@ -613,8 +727,11 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 
 			output_count = new_output_count;
 			output_ready = true;
+			voice_audibility = audibility;
 		}
 
+		_update_voices();
+
 		//start playing if requested
 		if (setplay >= 0.0) {
 			setseek = setplay;
@@ -710,6 +827,8 @@ void AudioStreamPlayer3D::play(float p_from_pos) {
 		active = true;
 		setplay = p_from_pos;
 		output_ready = false;
+		voice_virtual_requested = false;
+		voice_audibility = 1.0; //until the first update, so it can claim a voice
 		set_physics_process_internal(true);
 	}
 }
@@ -937,6 +1056,21 @@ Ref<AudioStreamPlayback> AudioStreamPlayer3D::get_stream_playback() {
 	return stream_playback;
 }
 
+void AudioStreamPlayer3D::set_voice_priority(int p_priority) {
+
+	voice_priority = p_priority;
+}
+
+int AudioStreamPlayer3D::get_voice_priority() const {
+
+	return voice_priority;
+}
+
+bool AudioStreamPlayer3D::is_voice_virtual() const {
+
+	return active && voice_virtual_requested;
+}
+
 void AudioStreamPlayer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &AudioStreamPlayer3D::set_stream);
@@ -1005,6 +1139,10 @@ void AudioStreamPlayer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_stream_playback"), &AudioStreamPlayer3D::get_stream_playback);
 
+	ClassDB::bind_method(D_METHOD("set_voice_priority", "priority"), &AudioStreamPlayer3D::set_voice_priority);
+	ClassDB::bind_method(D_METHOD("get_voice_priority"), &AudioStreamPlayer3D::get_voice_priority);
+	ClassDB::bind_method(D_METHOD("is_voice_virtual"), &AudioStreamPlayer3D::is_voice_virtual);
+
 	ClassDB::bind_method(D_METHOD("_bus_layout_changed"), &AudioStreamPlayer3D::_bus_layout_changed);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "stream", PROPERTY_HINT_RESOURCE_TYPE, "AudioStream"), "set_stream", "get_stream");
@@ -1020,6 +1158,7 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "out_of_range_mode", PROPERTY_HINT_ENUM, "Mix,Pause"), "set_out_of_range_mode", "get_out_of_range_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "area_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_area_mask", "get_area_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "voice_priority", PROPERTY_HINT_RANGE, "-100,100,1"), "set_voice_priority", "get_voice_priority");
 	ADD_GROUP("Emission Angle", "emission_angle");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "emission_angle_enabled"), "set_emission_angle_enabled", "is_emission_angle_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "emission_angle_degrees", PROPERTY_HINT_RANGE, "0.1,90,0.1"), "set_emission_angle", "get_emission_angle");
@@ -1045,7 +1184,8 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("finished"));
 }
 
-AudioStreamPlayer3D::AudioStreamPlayer3D() {
+AudioStreamPlayer3D::AudioStreamPlayer3D() :
+		voice_list(this) {
 
 	unit_db = 0;
 	unit_size = 1;
@@ -1071,6 +1211,12 @@ AudioStreamPlayer3D::AudioStreamPlayer3D() {
 	stream_paused = false;
 	stream_paused_fade_in = false;
 	stream_paused_fade_out = false;
+	voice_priority = 0;
+	voice_audibility = 0;
+	voice_virtual_requested = false;
+	voice_virtual = false;
+	voice_skip = 0;
+	voice_skip_limit = 0;
 
 	velocity_tracker.instance();
 	AudioServer::get_singleton()->connect("bus_layout_changed", this, "_bus_layout_changed");
@@ -31,6 +31,7 @@
 #ifndef AUDIO_STREAM_PLAYER_3D_H
 #define AUDIO_STREAM_PLAYER_3D_H
 
+#include "core/self_list.h"
 #include "scene/3d/spatial.h"
 #include "scene/3d/spatial_velocity_tracker.h"
 #include "servers/audio/audio_filter_sw.h"
@@ -64,8 +65,8 @@ public:
 private:
 	enum {
 		MAX_OUTPUTS = 8,
-		MAX_INTERSECT_AREAS = 32
-
+		MAX_INTERSECT_AREAS = 32,
+		VIRTUAL_UPDATE_INTERVAL = 4 //physics frames between output updates of virtual voices
 	};
 
 	struct Output {
@@ -142,6 +143,24 @@ private:
 
 	float _get_attenuation_db(float p_distance) const;
 
+	//voice management, the loudest voices are mixed and the rest only advance
+	struct VoiceSort;
+	static SelfList<AudioStreamPlayer3D>::List voices;
+	static uint64_t voices_frame;
+	SelfList<AudioStreamPlayer3D> voice_list;
+
+	int voice_priority;
+	float voice_audibility; //loudest output volume
+	volatile bool voice_virtual_requested;
+
+	//these are used by audio thread
+	bool voice_virtual;
+	float voice_skip; //seconds to skip when audible again
+	float voice_skip_limit; //seconds left in the stream when it went virtual
+
+	bool _can_virtualize() const;
+	static void _update_voices();
+
 protected:
 	void _validate_property(PropertyInfo &property) const;
 	void _notification(int p_what);
@@ -210,6 +229,11 @@ public:
 
 	Ref<AudioStreamPlayback> get_stream_playback();
 
+	void set_voice_priority(int p_priority);
+	int get_voice_priority() const;
+
+	bool is_voice_virtual() const;
+
 	AudioStreamPlayer3D();
 	~AudioStreamPlayer3D();
 };
@@ -30,6 +30,7 @@
 
 #include "cpu_particles.h"
 
+#include "core/os/threaded_array_processor.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/particles.h"
 #include "scene/resources/particles_material.h"
@@ -600,8 +601,6 @@ void CPUParticles::_particles_process(float p_delta) {
 	int pcount = particles.size();
 	PoolVector<Particle>::Write w = particles.write();
 
-	Particle *parray = w.ptr();
-
 	float prev_time = time;
 	time += p_delta;
 	if (time > lifetime) {
@@ -613,23 +612,63 @@ void CPUParticles::_particles_process(float p_delta) {
 		}
 	}
 
-	Transform emission_xform;
-	Basis velocity_xform;
+	ProcessData data;
+	data.particles = w.ptr();
+	data.count = pcount;
+	data.delta = p_delta;
+	data.prev_time = prev_time;
+	data.system_phase = time / lifetime;
 	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform.basis;
+		data.emission_xform = get_global_transform();
+		data.velocity_xform = data.emission_xform.basis;
+	}
+
+	// Math::rand() is not thread safe, so every block draws from its own
+	// generator, seeded here in order.
+	uint32_t block_count = (pcount + PROCESS_BLOCK_SIZE - 1) / PROCESS_BLOCK_SIZE;
+	Vector<uint32_t> block_seeds;
+	block_seeds.resize(block_count);
+	for (uint32_t i = 0; i < block_count; i++) {
+		block_seeds.write[i] = Math::rand();
 	}
+	data.block_seeds = block_seeds.ptr();
+
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0); // Sorts the points up front, so workers only read.
+	}
+
+	if (pcount >= PROCESS_THREADED_MIN_PARTICLES) {
+		thread_process_array(block_count, this, &CPUParticles::_particles_process_block, &data);
+	} else {
+		for (uint32_t i = 0; i < block_count; i++) {
+			_particles_process_block(i, &data);
+		}
+	}
+}
+
+void CPUParticles::_particles_process_block(uint32_t p_block, ProcessData *p_data) {
 
-	float system_phase = time / lifetime;
+	Particle *parray = p_data->particles;
+	int pcount = p_data->count;
+	float delta = p_data->delta;
+	float prev_time = p_data->prev_time;
+	float system_phase = p_data->system_phase;
+	const Transform &emission_xform = p_data->emission_xform;
+	const Basis &velocity_xform = p_data->velocity_xform;
 
-	for (int i = 0; i < pcount; i++) {
+	RandomPCG rng(p_data->block_seeds[p_block]);
+
+	int from = p_block * PROCESS_BLOCK_SIZE;
+	int to = MIN(from + PROCESS_BLOCK_SIZE, pcount);
+
+	for (int i = from; i < to; i++) {
 
 		Particle &p = parray[i];
 
 		if (!emitting && !p.active)
 			continue;
 
-		float local_delta = p_delta;
+		float local_delta = delta;
 
 		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
 		// While we use time in tests later on, for randomness we use the phase as done in the
@@ -703,28 +742,28 @@ void CPUParticles::_particles_process(float p_delta) {
 				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(0);
 			}
 
-			p.seed = Math::rand();
+			p.seed = rng.rand();
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+			p.angle_rand = rng.randf();
+			p.scale_rand = rng.randf();
+			p.hue_rot_rand = rng.randf();
+			p.anim_offset_rand = rng.randf();
 
 			if (flags[FLAG_DISABLE_Z]) {
-				float angle1_rad = Math::atan2(direction.y, direction.x) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+				float angle1_rad = Math::atan2(direction.y, direction.x) + (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
 				Vector3 rot = Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
-				p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+				p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(rng.randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
 			} else {
 				//initiate velocity spread in 3D
-				float angle1_rad = Math::atan2(direction.x, direction.z) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
-				float angle2_rad = Math::atan2(direction.y, Math::abs(direction.z)) + (Math::randf() * 2.0 - 1.0) * (1.0 - flatness) * Math_PI * spread / 180.0;
+				float angle1_rad = Math::atan2(direction.x, direction.z) + (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+				float angle2_rad = Math::atan2(direction.y, Math::abs(direction.z)) + (rng.randf() * 2.0 - 1.0) * (1.0 - flatness) * Math_PI * spread / 180.0;
 
 				Vector3 direction_xz = Vector3(Math::sin(angle1_rad), 0, Math::cos(angle1_rad));
 				Vector3 direction_yz = Vector3(0, Math::sin(angle2_rad), Math::cos(angle2_rad));
 				direction_yz.z = direction_yz.z / MAX(0.0001, Math::sqrt(ABS(direction_yz.z))); //better uniform distribution
 				Vector3 direction = Vector3(direction_xz.x * direction_yz.z, direction_yz.y, direction_xz.z * direction_yz.z);
 				direction.normalize();
-				p.velocity = direction * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+				p.velocity = direction * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(rng.randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
 			}
 
 			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
@@ -733,7 +772,7 @@ void CPUParticles::_particles_process(float p_delta) {
 			p.custom[2] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]); //animation offset (0-1)
 			p.transform = Transform();
 			p.time = 0;
-			p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+			p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
 			p.base_color = Color(1, 1, 1, 1);
 
 			switch (emission_shape) {
@@ -741,12 +780,12 @@ void CPUParticles::_particles_process(float p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					float s = 2.0 * Math::randf() - 1.0, t = 2.0 * Math_PI * Math::randf();
+					float s = 2.0 * rng.randf() - 1.0, t = 2.0 * Math_PI * rng.randf();
 					float radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
 					p.transform.origin = Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s);
 				} break;
 				case EMISSION_SHAPE_BOX: {
-					p.transform.origin = Vector3(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_box_extents;
+					p.transform.origin = Vector3(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_box_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -755,7 +794,7 @@ void CPUParticles::_particles_process(float p_delta) {
 					if (pc == 0)
 						break;
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = rng.rand() % pc;
 
 					p.transform.origin = emission_points.get(random_idx);
 
@@ -1066,46 +1105,19 @@ void CPUParticles::_update_particle_data_buffer() {
 			}
 		}
 
-		for (int i = 0; i < pc; i++) {
-
-			int idx = order ? order[i] : i;
-
-			Transform t = r[idx].transform;
+		DataBufferData data;
+		data.particles = r.ptr();
+		data.order = order;
+		data.data = ptr;
+		data.count = pc;
 
-			if (!local_coords) {
-				t = inv_emission_transform * t;
-			}
-
-			if (r[idx].active) {
-				ptr[0] = t.basis.elements[0][0];
-				ptr[1] = t.basis.elements[0][1];
-				ptr[2] = t.basis.elements[0][2];
-				ptr[3] = t.origin.x;
-				ptr[4] = t.basis.elements[1][0];
-				ptr[5] = t.basis.elements[1][1];
-				ptr[6] = t.basis.elements[1][2];
-				ptr[7] = t.origin.y;
-				ptr[8] = t.basis.elements[2][0];
-				ptr[9] = t.basis.elements[2][1];
-				ptr[10] = t.basis.elements[2][2];
-				ptr[11] = t.origin.z;
-			} else {
-				zeromem(ptr, sizeof(float) * 12);
+		uint32_t block_count = (pc + PROCESS_BLOCK_SIZE - 1) / PROCESS_BLOCK_SIZE;
+		if (pc >= PROCESS_THREADED_MIN_PARTICLES) {
+			thread_process_array(block_count, this, &CPUParticles::_update_particle_data_block, &data);
+		} else {
+			for (uint32_t i = 0; i < block_count; i++) {
+				_update_particle_data_block(i, &data);
 			}
-
-			Color c = r[idx].color;
-			uint8_t *data8 = (uint8_t *)&ptr[12];
-			data8[0] = CLAMP(c.r * 255.0, 0, 255);
-			data8[1] = CLAMP(c.g * 255.0, 0, 255);
-			data8[2] = CLAMP(c.b * 255.0, 0, 255);
-			data8[3] = CLAMP(c.a * 255.0, 0, 255);
-
-			ptr[13] = r[idx].custom[0];
-			ptr[14] = r[idx].custom[1];
-			ptr[15] = r[idx].custom[2];
-			ptr[16] = r[idx].custom[3];
-
-			ptr += 17;
 		}
 
 		can_update = true;
@@ -1116,6 +1128,58 @@ void CPUParticles::_update_particle_data_buffer() {
 #endif
 }
 
+void CPUParticles::_update_particle_data_block(uint32_t p_block, DataBufferData *p_data) {
+
+	const Particle *r = p_data->particles;
+	const int *order = p_data->order;
+
+	int from = p_block * PROCESS_BLOCK_SIZE;
+	int to = MIN(from + PROCESS_BLOCK_SIZE, p_data->count);
+	float *ptr = p_data->data + from * 17;
+
+	for (int i = from; i < to; i++) {
+
+		int idx = order ? order[i] : i;
+
+		Transform t = r[idx].transform;
+
+		if (!local_coords) {
+			t = inv_emission_transform * t;
+		}
+
+		if (r[idx].active) {
+			ptr[0] = t.basis.elements[0][0];
+			ptr[1] = t.basis.elements[0][1];
+			ptr[2] = t.basis.elements[0][2];
+			ptr[3] = t.origin.x;
+			ptr[4] = t.basis.elements[1][0];
+			ptr[5] = t.basis.elements[1][1];
+			ptr[6] = t.basis.elements[1][2];
+			ptr[7] = t.origin.y;
+			ptr[8] = t.basis.elements[2][0];
+			ptr[9] = t.basis.elements[2][1];
+			ptr[10] = t.basis.elements[2][2];
+			ptr[11] = t.origin.z;
+		} else {
+			zeromem(ptr, sizeof(float) * 12);
+		}
+
+		Color c = r[idx].color;
+		uint8_t *data8 = (uint8_t *)&ptr[12];
+		data8[0] = CLAMP(c.r * 255.0, 0, 255);
+		data8[1] = CLAMP(c.g * 255.0, 0, 255);
+		data8[2] = CLAMP(c.b * 255.0, 0, 255);
+		data8[3] = CLAMP(c.a * 255.0, 0, 255);
+
+		ptr[13] = r[idx].custom[0];
+		ptr[14] = r[idx].custom[1];
+		ptr[15] = r[idx].custom[2];
+		ptr[16] = r[idx].custom[3];
+
+		ptr += 17;
+	}
+}
+
 void CPUParticles::_set_redraw(bool p_redraw) {
 	if (redraw == p_redraw)
 		return;
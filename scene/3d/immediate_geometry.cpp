@@ -32,6 +32,24 @@
 
 void ImmediateGeometry::begin(Mesh::PrimitiveType p_primitive, const Ref<Texture> &p_texture) {
 
+	if (streaming) {
+		ERR_FAIL_COND_MSG(stream_building, "Already building a chunk, call end() first.");
+		if (p_texture.is_valid()) {
+			WARN_PRINT_ONCE("Textures passed to begin() are ignored in streaming mode, use a material override instead.");
+		}
+
+		if (stream_chunk_count == stream_chunks.size()) {
+			stream_chunks.resize(stream_chunk_count + 1);
+		}
+
+		StreamChunk &chunk = stream_chunks.write[stream_chunk_count];
+		chunk.primitive = p_primitive;
+		chunk.format = VS::ARRAY_FORMAT_VERTEX;
+		chunk.vertex_count = 0;
+		stream_building = true;
+		return;
+	}
+
 	VS::get_singleton()->immediate_begin(im, (VS::PrimitiveType)p_primitive, p_texture.is_valid() ? p_texture->get_rid() : RID());
 	if (p_texture.is_valid())
 		cached_textures.push_back(p_texture);
@@ -39,32 +57,94 @@ void ImmediateGeometry::begin(Mesh::PrimitiveType p_primitive, const Ref<Texture
 
 void ImmediateGeometry::set_normal(const Vector3 &p_normal) {
 
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+		stream_normal = p_normal;
+		stream_chunks.write[stream_chunk_count].format |= VS::ARRAY_FORMAT_NORMAL;
+		return;
+	}
+
 	VS::get_singleton()->immediate_normal(im, p_normal);
 }
 
 void ImmediateGeometry::set_tangent(const Plane &p_tangent) {
 
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+		stream_tangent = p_tangent;
+		stream_chunks.write[stream_chunk_count].format |= VS::ARRAY_FORMAT_TANGENT;
+		return;
+	}
+
 	VS::get_singleton()->immediate_tangent(im, p_tangent);
 }
 
 void ImmediateGeometry::set_color(const Color &p_color) {
 
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+		stream_color = p_color;
+		stream_chunks.write[stream_chunk_count].format |= VS::ARRAY_FORMAT_COLOR;
+		return;
+	}
+
 	VS::get_singleton()->immediate_color(im, p_color);
 }
 
 void ImmediateGeometry::set_uv(const Vector2 &p_uv) {
 
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+		stream_uv = p_uv;
+		stream_chunks.write[stream_chunk_count].format |= VS::ARRAY_FORMAT_TEX_UV;
+		return;
+	}
+
 	VS::get_singleton()->immediate_uv(im, p_uv);
 }
 
 void ImmediateGeometry::set_uv2(const Vector2 &p_uv2) {
 
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+		stream_uv2 = p_uv2;
+		stream_chunks.write[stream_chunk_count].format |= VS::ARRAY_FORMAT_TEX_UV2;
+		return;
+	}
+
 	VS::get_singleton()->immediate_uv2(im, p_uv2);
 }
 
 void ImmediateGeometry::add_vertex(const Vector3 &p_vertex) {
 
-	VS::get_singleton()->immediate_vertex(im, p_vertex);
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+
+		StreamChunk &chunk = stream_chunks.write[stream_chunk_count];
+		int idx = chunk.vertex_count++;
+
+		// Arrays only grow, so a chunk rebuilt every frame stops allocating.
+		if (idx >= chunk.vertices.size()) {
+			int capacity = MAX(idx * 2, 64);
+			chunk.vertices.resize(capacity);
+			chunk.normals.resize(capacity);
+			chunk.tangents.resize(capacity);
+			chunk.colors.resize(capacity);
+			chunk.uvs.resize(capacity);
+			chunk.uv2s.resize(capacity);
+		}
+
+		// Attributes keep their last value, like in the immediate path.
+		chunk.vertices.write[idx] = p_vertex;
+		chunk.normals.write[idx] = stream_normal;
+		chunk.tangents.write[idx] = stream_tangent;
+		chunk.colors.write[idx] = stream_color;
+		chunk.uvs.write[idx] = stream_uv;
+		chunk.uv2s.write[idx] = stream_uv2;
+	} else {
+		VS::get_singleton()->immediate_vertex(im, p_vertex);
+	}
+
 	if (empty) {
 		aabb.position = p_vertex;
 		aabb.size = Vector3();
@@ -76,16 +156,158 @@ void ImmediateGeometry::add_vertex(const Vector3 &p_vertex) {
 
 void ImmediateGeometry::end() {
 
+	if (streaming) {
+		ERR_FAIL_COND(!stream_building);
+		stream_building = false;
+		_stream_end();
+		return;
+	}
+
 	VS::get_singleton()->immediate_end(im);
 }
 
 void ImmediateGeometry::clear() {
 
-	VS::get_singleton()->immediate_clear(im);
+	if (streaming) {
+		stream_building = false;
+		stream_chunk_count = 0;
+
+		// Surfaces are kept for the next batch of chunks to reuse, the ones
+		// left over are removed once the frame's drawing is done.
+		if (!stream_trim_queued) {
+			stream_trim_queued = true;
+			call_deferred("_trim_stream_surfaces");
+		}
+	} else {
+		VS::get_singleton()->immediate_clear(im);
+	}
+
 	empty = true;
 	cached_textures.clear();
 }
 
+static _FORCE_INLINE_ void _stream_write_floats(uint8_t *p_dst, float p_a, float p_b, float p_c = 0, float p_d = 0, int p_count = 2) {
+
+	float v[4] = { p_a, p_b, p_c, p_d };
+	copymem(p_dst, v, sizeof(float) * p_count);
+}
+
+void ImmediateGeometry::_stream_end() {
+
+	StreamChunk &chunk = stream_chunks.write[stream_chunk_count];
+	if (chunk.vertex_count == 0) {
+		return;
+	}
+
+	VisualServer *vs = VS::get_singleton();
+
+	uint32_t offsets[VS::ARRAY_MAX];
+	int stride = vs->mesh_surface_make_offsets_from_format(chunk.format, chunk.vertex_count, 0, offsets);
+
+	chunk.buffer.resize(stride * chunk.vertex_count);
+
+	{
+		PoolVector<uint8_t>::Write w = chunk.buffer.write();
+		const Vector3 *vertices = chunk.vertices.ptr();
+		const Vector3 *normals = chunk.normals.ptr();
+		const Plane *tangents = chunk.tangents.ptr();
+		const Color *colors = chunk.colors.ptr();
+		const Vector2 *uvs = chunk.uvs.ptr();
+		const Vector2 *uv2s = chunk.uv2s.ptr();
+
+		for (int i = 0; i < chunk.vertex_count; i++) {
+
+			uint8_t *dst = &w[i * stride];
+
+			_stream_write_floats(&dst[offsets[VS::ARRAY_VERTEX]], vertices[i].x, vertices[i].y, vertices[i].z, 0, 3);
+			if (chunk.format & VS::ARRAY_FORMAT_NORMAL) {
+				_stream_write_floats(&dst[offsets[VS::ARRAY_NORMAL]], normals[i].x, normals[i].y, normals[i].z, 0, 3);
+			}
+			if (chunk.format & VS::ARRAY_FORMAT_TANGENT) {
+				_stream_write_floats(&dst[offsets[VS::ARRAY_TANGENT]], tangents[i].normal.x, tangents[i].normal.y, tangents[i].normal.z, tangents[i].d, 4);
+			}
+			if (chunk.format & VS::ARRAY_FORMAT_COLOR) {
+				_stream_write_floats(&dst[offsets[VS::ARRAY_COLOR]], colors[i].r, colors[i].g, colors[i].b, colors[i].a, 4);
+			}
+			if (chunk.format & VS::ARRAY_FORMAT_TEX_UV) {
+				_stream_write_floats(&dst[offsets[VS::ARRAY_TEX_UV]], uvs[i].x, uvs[i].y);
+			}
+			if (chunk.format & VS::ARRAY_FORMAT_TEX_UV2) {
+				_stream_write_floats(&dst[offsets[VS::ARRAY_TEX_UV2]], uv2s[i].x, uv2s[i].y);
+			}
+		}
+	}
+
+	int surface = stream_chunk_count++;
+
+	if (surface < stream_surfaces.size()) {
+		const StreamSurface &s = stream_surfaces[surface];
+		if (s.primitive == chunk.primitive && s.format == chunk.format && s.vertex_count == chunk.vertex_count) {
+			vs->mesh_surface_update_region(stream_mesh, surface, 0, chunk.buffer);
+			vs->mesh_set_custom_aabb(stream_mesh, aabb);
+			return;
+		}
+
+		// Layout changed, this surface and the following ones are rebuilt.
+		_stream_remove_surfaces(surface);
+	}
+
+	vs->mesh_add_surface_from_buffers(stream_mesh, (VS::PrimitiveType)chunk.primitive, chunk.format | VS::ARRAY_FLAG_USE_DYNAMIC_UPDATE, chunk.buffer, chunk.vertex_count);
+	vs->mesh_set_custom_aabb(stream_mesh, aabb);
+
+	StreamSurface s;
+	s.primitive = chunk.primitive;
+	s.format = chunk.format;
+	s.vertex_count = chunk.vertex_count;
+	stream_surfaces.push_back(s);
+}
+
+void ImmediateGeometry::_stream_remove_surfaces(int p_from) {
+
+	for (int i = stream_surfaces.size() - 1; i >= p_from; i--) {
+		VS::get_singleton()->mesh_remove_surface(stream_mesh, i);
+	}
+	stream_surfaces.resize(p_from);
+}
+
+void ImmediateGeometry::_trim_stream_surfaces() {
+
+	stream_trim_queued = false;
+	if (!streaming || stream_building) {
+		return;
+	}
+
+	_stream_remove_surfaces(stream_chunk_count);
+}
+
+void ImmediateGeometry::set_streaming(bool p_enable) {
+
+	if (streaming == p_enable) {
+		return;
+	}
+
+	clear();
+	streaming = p_enable;
+
+	if (streaming) {
+		stream_mesh = VS::get_singleton()->mesh_create();
+		set_base(stream_mesh);
+	} else {
+		set_base(im);
+		VS::get_singleton()->free(stream_mesh);
+		stream_mesh = RID();
+		stream_chunks.clear();
+		stream_surfaces.clear();
+		stream_chunk_count = 0;
+		stream_building = false;
+	}
+}
+
+bool ImmediateGeometry::is_streaming() const {
+
+	return streaming;
+}
+
 AABB ImmediateGeometry::get_aabb() const {
 
 	return aabb;
@@ -154,6 +376,12 @@ void ImmediateGeometry::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_sphere", "lats", "lons", "radius", "add_uv"), &ImmediateGeometry::add_sphere, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("end"), &ImmediateGeometry::end);
 	ClassDB::bind_method(D_METHOD("clear"), &ImmediateGeometry::clear);
+
+	ClassDB::bind_method(D_METHOD("set_streaming", "enable"), &ImmediateGeometry::set_streaming);
+	ClassDB::bind_method(D_METHOD("is_streaming"), &ImmediateGeometry::is_streaming);
+	ClassDB::bind_method(D_METHOD("_trim_stream_surfaces"), &ImmediateGeometry::_trim_stream_surfaces);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "streaming"), "set_streaming", "is_streaming");
 }
 
 ImmediateGeometry::ImmediateGeometry() {
@@ -161,9 +389,18 @@ ImmediateGeometry::ImmediateGeometry() {
 	im = VisualServer::get_singleton()->immediate_create();
 	set_base(im);
 	empty = true;
+
+	streaming = false;
+	stream_chunk_count = 0;
+	stream_building = false;
+	stream_trim_queued = false;
+	stream_color = Color(1, 1, 1, 1);
 }
 
 ImmediateGeometry::~ImmediateGeometry() {
 
 	VisualServer::get_singleton()->free(im);
+	if (stream_mesh.is_valid()) {
+		VisualServer::get_singleton()->free(stream_mesh);
+	}
 }
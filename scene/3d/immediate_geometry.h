@@ -45,10 +45,53 @@ class ImmediateGeometry : public GeometryInstance {
 	bool empty;
 	AABB aabb;
 
+	// Streaming mode keeps the chunks on the scene side and uploads them to a
+	// persistent mesh, rewriting the existing vertex buffers in place when the
+	// chunk layout did not change since the last clear().
+	struct StreamChunk {
+		Mesh::PrimitiveType primitive;
+		uint32_t format;
+		int vertex_count;
+		Vector<Vector3> vertices;
+		Vector<Vector3> normals;
+		Vector<Plane> tangents;
+		Vector<Color> colors;
+		Vector<Vector2> uvs;
+		Vector<Vector2> uv2s;
+		PoolVector<uint8_t> buffer;
+	};
+
+	struct StreamSurface {
+		Mesh::PrimitiveType primitive;
+		uint32_t format;
+		int vertex_count;
+	};
+
+	bool streaming;
+	RID stream_mesh;
+	Vector<StreamChunk> stream_chunks;
+	Vector<StreamSurface> stream_surfaces;
+	int stream_chunk_count;
+	bool stream_building;
+	bool stream_trim_queued;
+
+	Vector3 stream_normal;
+	Plane stream_tangent;
+	Color stream_color;
+	Vector2 stream_uv;
+	Vector2 stream_uv2;
+
+	void _stream_end();
+	void _stream_remove_surfaces(int p_from);
+	void _trim_stream_surfaces();
+
 protected:
 	static void _bind_methods();
 
 public:
+	void set_streaming(bool p_enable);
+	bool is_streaming() const;
+
 	void begin(Mesh::PrimitiveType p_primitive, const Ref<Texture> &p_texture = Ref<Texture>());
 	void set_normal(const Vector3 &p_normal);
 	void set_tangent(const Plane &p_tangent);
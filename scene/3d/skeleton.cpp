@@ -598,21 +598,43 @@ void Skeleton::_notification(int p_what) {
 					E->get()->skeleton_version = version;
 				}
 
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-
-					if (ImportFileFormat::DEFAULT == gdi_import_file_format) {
-						vs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
-					} 
-					else if (ImportFileFormat::ASSIMP_FBX == gdi_import_file_format) {
-						// 测试点：查看这里的骨骼transform影响
-						auto pose = skin->get_bind_pose(i);
-						auto global_pose = bonesptr[bone_index].pose_global;
-						auto final_pose = global_pose * pose;
-						vs->skeleton_bone_set_transform(skeleton, i, final_pose);
+				if (ImportFileFormat::DEFAULT != gdi_import_file_format && ImportFileFormat::ASSIMP_FBX != gdi_import_file_format) {
+					continue;
+				}
+
+				// Upload every bind at once; one call per bone goes through the command queue each time.
+				PoolVector<float> &bone_transforms = E->get()->bone_transforms;
+				if (bone_transforms.size() != int(bind_count * 12)) {
+					bone_transforms.resize(bind_count * 12);
+				}
+
+				{
+					PoolVector<float>::Write w = bone_transforms.write();
+					float *ptr = w.ptr();
+
+					for (uint32_t i = 0; i < bind_count; i++) {
+						uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
+						ERR_CONTINUE(bone_index >= (uint32_t)len);
+
+						Transform t = bonesptr[bone_index].pose_global * skin->get_bind_pose(i);
+
+						float *dst = &ptr[i * 12];
+						dst[0] = t.basis.elements[0][0];
+						dst[1] = t.basis.elements[0][1];
+						dst[2] = t.basis.elements[0][2];
+						dst[3] = t.origin.x;
+						dst[4] = t.basis.elements[1][0];
+						dst[5] = t.basis.elements[1][1];
+						dst[6] = t.basis.elements[1][2];
+						dst[7] = t.origin.y;
+						dst[8] = t.basis.elements[2][0];
+						dst[9] = t.basis.elements[2][1];
+						dst[10] = t.basis.elements[2][2];
+						dst[11] = t.origin.z;
 					}
 				}
+
+				vs->skeleton_set_as_bulk_array(skeleton, bone_transforms);
 			}
 
 			dirty = false;
@@ -54,6 +54,7 @@ class SkinReference : public Reference {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs;
+	PoolVector<float> bone_transforms;
 	void _skin_changed();
 
 protected:
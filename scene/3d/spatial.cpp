@@ -121,6 +121,33 @@ void Spatial::_propagate_transform_changed(Spatial *p_origin) {
 	data.children_lock--;
 }
 
+void Spatial::_queue_transform_changed() {
+
+	if (!is_inside_tree()) {
+		return;
+	}
+
+	// The subtree is invalidated once per batch by SceneTree::flush_pending_transforms(),
+	// no matter how many times the local transform is set before that.
+	if (!xform_pending.in_list()) {
+		get_tree()->xform_pending_list.add(&xform_pending);
+	}
+}
+
+void Spatial::_flush_pending_transform() {
+
+	// If a non-toplevel ancestor is pending too, its propagation covers this subtree.
+	const Spatial *s = this;
+	while (!s->data.toplevel_active && s->data.parent) {
+		s = s->data.parent;
+		if (s->xform_pending.in_list()) {
+			return;
+		}
+	}
+
+	_propagate_transform_changed(this);
+}
+
 void Spatial::_notification(int p_what) {
 
 	switch (p_what) {
@@ -156,6 +183,8 @@ void Spatial::_notification(int p_what) {
 			notification(NOTIFICATION_EXIT_WORLD, true);
 			if (xform_change.in_list())
 				get_tree()->xform_change_list.remove(&xform_change);
+			if (xform_pending.in_list())
+				get_tree()->xform_pending_list.remove(&xform_pending);
 			if (data.C)
 				data.parent->data.children.erase(data.C);
 			data.parent = NULL;
@@ -238,7 +267,7 @@ void Spatial::set_transform(const Transform &p_transform) {
 	_change_notify("rotation");
 	_change_notify("rotation_degrees");
 	_change_notify("scale");
-	_propagate_transform_changed(this);
+	_queue_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -267,6 +296,11 @@ Transform Spatial::get_global_transform() const {
 
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform());
 
+	SceneTree *tree = get_tree();
+	if (tree->xform_pending_list.first()) {
+		tree->flush_pending_transforms();
+	}
+
 	if (data.dirty & DIRTY_GLOBAL) {
 
 		if (data.dirty & DIRTY_LOCAL) {
@@ -324,7 +358,7 @@ void Spatial::set_translation(const Vector3 &p_translation) {
 
 	data.local_transform.origin = p_translation;
 	_change_notify("transform");
-	_propagate_transform_changed(this);
+	_queue_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -340,7 +374,7 @@ void Spatial::set_rotation(const Vector3 &p_euler_rad) {
 	data.rotation = p_euler_rad;
 	data.dirty |= DIRTY_LOCAL;
 	_change_notify("transform");
-	_propagate_transform_changed(this);
+	_queue_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -361,7 +395,7 @@ void Spatial::set_scale(const Vector3 &p_scale) {
 	data.scale = p_scale;
 	data.dirty |= DIRTY_LOCAL;
 	_change_notify("transform");
-	_propagate_transform_changed(this);
+	_queue_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -820,7 +854,8 @@ void Spatial::_bind_methods() {
 }
 
 Spatial::Spatial() :
-		xform_change(this)
+		xform_change(this),
+		xform_pending(this)
 {
 
 	data.dirty = DIRTY_NONE;
@@ -62,6 +62,7 @@ class Spatial : public Node {
 	};
 
 	mutable SelfList<Node> xform_change;
+	SelfList<Node> xform_pending;
 
 	struct Data {
 
@@ -101,6 +102,10 @@ class Spatial : public Node {
 	void _update_gizmo();
 	void _notify_dirty();
 	void _propagate_transform_changed(Spatial *p_origin);
+	void _queue_transform_changed();
+	void _flush_pending_transform();
+
+	friend class SceneTree;
 
 	void _propagate_visibility_changed();
 
@@ -366,6 +366,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 				pa.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
 				pa.special = SP_NONE;
 				pa.owner = p_anim->node_cache[i];
+				_resolve_property_setter(&pa);
 				if (false && p_anim->node_cache[i]->node_2d) {
 
 					if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_pos)
@@ -394,6 +395,149 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	}
 }
 
+void AnimationPlayer::_resolve_property_setter(TrackNodeCache::PropertyAnim *p_pa) {
+
+	p_pa->setter = NULL;
+	p_pa->setter_index = -1;
+	p_pa->setter_type = Variant::NIL;
+
+	// Only plain properties can skip Object::set(), nested subpaths still need set_indexed().
+	if (p_pa->subpath.size() != 1 || !p_pa->object)
+		return;
+
+	const StringName &property = p_pa->subpath[0];
+
+	ScriptInstance *si = p_pa->object->get_script_instance();
+	if (si) {
+		// Scripts get the first chance at Object::set(), keep that path if they may intercept.
+		bool script_valid = false;
+		si->get_property_type(property, &script_valid);
+		if (script_valid || si->has_method("_set"))
+			return;
+	}
+
+	StringName class_name = p_pa->object->get_class_name();
+	bool valid = false;
+	Variant::Type type = ClassDB::get_property_type(class_name, property, &valid);
+	if (!valid)
+		return;
+
+	StringName setter_name = ClassDB::get_property_setter(class_name, property);
+	if (setter_name == StringName())
+		return;
+
+	MethodBind *setter = ClassDB::get_method(class_name, setter_name);
+	if (!setter)
+		return;
+
+	int setter_index = ClassDB::get_property_index(class_name, property);
+
+#ifdef DEBUG_METHODS_ENABLED
+	// The declared property type may differ from what the setter takes (e.g. an int setter
+	// for a REAL property), leave those to Object::set() which converts the value.
+	Variant::Type arg_type = setter->get_argument_type(setter_index >= 0 ? 1 : 0);
+	if (arg_type != type) {
+		if (type == Variant::REAL || type == Variant::VECTOR2 || type == Variant::COLOR) {
+			WARN_PRINTS("Setter '" + String(class_name) + "::" + String(setter_name) + "' takes " + Variant::get_type_name(arg_type) + " but property '" + String(property) + "' is declared as " + Variant::get_type_name(type) + ", release builds will pass it the wrong type.");
+		}
+		return;
+	}
+#endif
+
+	p_pa->setter = setter;
+	p_pa->setter_index = setter_index;
+
+	// The cached setter is only valid as long as no script can intercept Object::set().
+	if (!p_pa->object->is_connected("script_changed", this, "_object_script_changed"))
+		p_pa->object->connect("script_changed", this, "_object_script_changed", varray(), CONNECT_ONESHOT);
+
+#ifdef PTRCALL_ENABLED
+	// Ptrcalls skip conversion entirely. Release builds have no argument types, so they
+	// rely on the declared property type, which debug builds check against the setter above.
+	if (p_pa->setter_index < 0 && setter->get_argument_count() == 1 && !setter->has_return() && !setter->is_vararg()) {
+		if (type == Variant::REAL || type == Variant::VECTOR2 || type == Variant::COLOR) {
+			p_pa->setter_type = type;
+		}
+	}
+#endif
+}
+
+void AnimationPlayer::_set_property_value(TrackNodeCache::PropertyAnim *p_pa, const Variant &p_value, bool *r_valid) {
+
+	if (!p_pa->setter) {
+		p_pa->object->set_indexed(p_pa->subpath, p_value, r_valid);
+		return;
+	}
+
+#ifdef PTRCALL_ENABLED
+	if (p_pa->setter_type == p_value.get_type()) {
+		switch (p_pa->setter_type) {
+			case Variant::REAL: {
+				double v = p_value; // PtrToArg<float> reads a double too.
+				const void *args[1] = { &v };
+				p_pa->setter->ptrcall(p_pa->object, args, NULL);
+				*r_valid = true;
+				return;
+			} break;
+			case Variant::VECTOR2: {
+				Vector2 v = p_value;
+				const void *args[1] = { &v };
+				p_pa->setter->ptrcall(p_pa->object, args, NULL);
+				*r_valid = true;
+				return;
+			} break;
+			case Variant::COLOR: {
+				Color v = p_value;
+				const void *args[1] = { &v };
+				p_pa->setter->ptrcall(p_pa->object, args, NULL);
+				*r_valid = true;
+				return;
+			} break;
+			default: {
+			}
+		}
+	}
+#endif
+
+	Variant::CallError ce;
+	if (p_pa->setter_index >= 0) {
+		Variant index = p_pa->setter_index;
+		const Variant *args[2] = { &index, &p_value };
+		p_pa->setter->call(p_pa->object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		p_pa->setter->call(p_pa->object, args, 1, ce);
+	}
+	*r_valid = ce.error == Variant::CallError::CALL_OK;
+}
+
+static _FORCE_INLINE_ void _blend_property_value(Variant &r_accum, const Variant &p_value, float p_interp) {
+
+	// Common UI tracks blend without going through Variant::interpolate().
+	if (r_accum.get_type() == p_value.get_type()) {
+		switch (p_value.get_type()) {
+			case Variant::REAL: {
+				real_t a = r_accum;
+				real_t b = p_value;
+				r_accum = a + (b - a) * p_interp;
+				return;
+			} break;
+			case Variant::VECTOR2: {
+				r_accum = r_accum.operator Vector2().linear_interpolate(p_value, p_interp);
+				return;
+			} break;
+			case Variant::COLOR: {
+				r_accum = r_accum.operator Color().linear_interpolate(p_value, p_interp);
+				return;
+			} break;
+			default: {
+			}
+		}
+	}
+
+	Variant::interpolate(r_accum, p_value, p_interp, r_accum);
+}
+
 void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started) {
 
 	_ensure_node_caches(p_anim);
@@ -527,7 +671,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 						pa->value_accum = value;
 						pa->accum_pass = accum_pass;
 					} else {
-						Variant::interpolate(pa->value_accum, value, p_interp, pa->value_accum);
+						_blend_property_value(pa->value_accum, value, p_interp);
 					}
 
 				} else if (p_is_current && p_delta != 0) {
@@ -542,7 +686,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 							case SP_NONE: {
 								bool valid;
-								pa->object->set_indexed(pa->subpath, value, &valid); //you are not speshul
+								_set_property_value(pa, value, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
 								if (!valid) {
 									ERR_PRINTS("Failed setting track value '" + String(pa->owner->path) + "'. Check if property exists or the type of key is valid. Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
@@ -993,7 +1137,7 @@ void AnimationPlayer::_animation_update_transforms() {
 
 			case SP_NONE: {
 				bool valid;
-				pa->object->set_indexed(pa->subpath, pa->value_accum, &valid); //you are not speshul
+				_set_property_value(pa, pa->value_accum, &valid); //you are not speshul
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					ERR_PRINTS("Failed setting key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "'. Check if property exists or the type of key is right for the property");
@@ -1515,6 +1659,11 @@ void AnimationPlayer::_node_removed(Node *p_node) {
 	clear_caches(); // nodes contained here ar being removed, clear the caches
 }
 
+void AnimationPlayer::_object_script_changed() {
+
+	clear_caches(); // cached setters may now bypass the script
+}
+
 void AnimationPlayer::clear_caches() {
 
 	_stop_playing_caches();
@@ -1732,6 +1881,7 @@ void AnimationPlayer::restore_animated_values(const AnimatedValuesBackup &p_back
 void AnimationPlayer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("_node_removed"), &AnimationPlayer::_node_removed);
+	ClassDB::bind_method(D_METHOD("_object_script_changed"), &AnimationPlayer::_object_script_changed);
 	ClassDB::bind_method(D_METHOD("_animation_changed"), &AnimationPlayer::_animation_changed);
 
 	ClassDB::bind_method(D_METHOD("add_animation", "name", "animation"), &AnimationPlayer::add_animation);
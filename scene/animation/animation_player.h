@@ -116,12 +116,18 @@ private:
 			Variant value_accum;
 			uint64_t accum_pass;
 			Variant capture;
+			MethodBind *setter; //resolved once from ClassDB, NULL falls back to set_indexed()
+			int setter_index;
+			Variant::Type setter_type; //REAL, VECTOR2 or COLOR when the setter can be ptrcalled
 
 			PropertyAnim() :
 					owner(NULL),
 					special(SP_NONE),
 					object(NULL),
-					accum_pass(0) {}
+					accum_pass(0),
+					setter(NULL),
+					setter_index(-1),
+					setter_type(Variant::NIL) {}
 		};
 
 		Map<StringName, PropertyAnim> property_anim;
@@ -257,12 +263,15 @@ private:
 	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false);
 
 	void _ensure_node_caches(AnimationData *p_anim);
+	void _resolve_property_setter(TrackNodeCache::PropertyAnim *p_pa);
+	void _set_property_value(TrackNodeCache::PropertyAnim *p_pa, const Variant &p_value, bool *r_valid);
 	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
 	void _animation_process2(float p_delta, bool p_started);
 	void _animation_update_transforms();
 	void _animation_process(float p_delta);
 
 	void _node_removed(Node *p_node);
+	void _object_script_changed();
 	void _stop_playing_caches();
 
 	// bind helpers
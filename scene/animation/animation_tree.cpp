@@ -725,6 +725,7 @@ bool AnimationTree::_update_caches(AnimationPlayer *player) {
 	}
 
 	state.track_count = idx;
+	animation_bindings.clear();
 
 	cache_valid = true;
 
@@ -740,9 +741,48 @@ void AnimationTree::_clear_caches() {
 	playing_caches.clear();
 
 	track_cache.clear();
+	animation_bindings.clear();
 	cache_valid = false;
 }
 
+AnimationTree::AnimationTrackBinding *AnimationTree::_get_animation_bindings(const Ref<Animation> &p_animation) {
+
+	int track_count = p_animation->get_track_count();
+	Vector<AnimationTrackBinding> *bindings = animation_bindings.getptr(p_animation->get_instance_id());
+
+	if (bindings && bindings->size() == track_count) {
+		return bindings->ptrw();
+	}
+
+	Vector<AnimationTrackBinding> new_bindings;
+	new_bindings.resize(track_count);
+
+	for (int i = 0; i < track_count; i++) {
+
+		NodePath path = p_animation->track_get_path(i);
+
+		ERR_CONTINUE(!track_cache.has(path));
+		ERR_CONTINUE(!state.track_map.has(path));
+
+		TrackCache *track = track_cache[path];
+		int blend_idx = state.track_map[path];
+
+		ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+
+		if (track->type != p_animation->track_get_type(i)) {
+			continue; //may happen should not
+		}
+
+		AnimationTrackBinding &binding = new_bindings.write[i];
+		binding.track = track;
+		binding.blend_idx = blend_idx;
+		binding.root_motion = root_motion_track == path;
+	}
+
+	animation_bindings[p_animation->get_instance_id()] = new_bindings;
+	return animation_bindings[p_animation->get_instance_id()].ptrw();
+}
+
 void AnimationTree::_process_graph(float p_delta) {
 
 	_update_properties(); //if properties need updating, update them
@@ -854,25 +894,18 @@ void AnimationTree::_process_graph(float p_delta) {
 			float delta = as.delta;
 			bool seeked = as.seeked;
 
-			for (int i = 0; i < a->get_track_count(); i++) {
+			AnimationTrackBinding *bindings = _get_animation_bindings(a);
 
-				NodePath path = a->track_get_path(i);
-
-				ERR_CONTINUE(!track_cache.has(path));
+			for (int i = 0; i < a->get_track_count(); i++) {
 
-				TrackCache *track = track_cache[path];
-				if (track->type != a->track_get_type(i)) {
-					continue; //may happen should not
+				TrackCache *track = bindings[i].track;
+				if (!track) {
+					continue;
 				}
 
-				track->root_motion = root_motion_track == path;
-
-				ERR_CONTINUE(!state.track_map.has(path));
-				int blend_idx = state.track_map[path];
-
-				ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+				track->root_motion = bindings[i].root_motion;
 
-				float blend = (*as.track_blends)[blend_idx];
+				float blend = (*as.track_blends)[bindings[i].blend_idx];
 
 				if (blend < CMP_EPSILON)
 					continue; //nothing to blend
@@ -943,7 +976,7 @@ void AnimationTree::_process_graph(float p_delta) {
 							Quat rot;
 							Vector3 scale;
 
-							Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
+							Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale, &bindings[i].cursor);
 							//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 							if (t->process_pass != process_pass) {
@@ -979,7 +1012,7 @@ void AnimationTree::_process_graph(float p_delta) {
 
 						if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
 
-							Variant value = a->value_track_interpolate(i, time);
+							Variant value = a->value_track_interpolate(i, time, &bindings[i].cursor);
 
 							if (value == Variant())
 								continue;
@@ -1382,6 +1415,7 @@ String AnimationTree::get_configuration_warning() const {
 
 void AnimationTree::set_root_motion_track(const NodePath &p_track) {
 	root_motion_track = p_track;
+	animation_bindings.clear();
 }
 
 NodePath AnimationTree::get_root_motion_track() const {
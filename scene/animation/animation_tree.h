@@ -258,6 +258,26 @@ private:
 	HashMap<NodePath, TrackCache *> track_cache;
 	Set<TrackCache *> playing_caches;
 
+	// Resolved track caches and blend indices for each track of an animation,
+	// so processing does not look paths up every frame. Cursors remember the
+	// last key used by each track to make sequential playback O(1).
+	struct AnimationTrackBinding {
+		TrackCache *track;
+		int blend_idx;
+		bool root_motion;
+		int cursor;
+
+		AnimationTrackBinding() {
+			track = NULL;
+			blend_idx = -1;
+			root_motion = false;
+			cursor = 0;
+		}
+	};
+
+	HashMap<ObjectID, Vector<AnimationTrackBinding> > animation_bindings;
+	AnimationTrackBinding *_get_animation_bindings(const Ref<Animation> &p_animation);
+
 	Ref<AnimationNode> root;
 
 	AnimationProcessMode process_mode;
@@ -30,14 +30,109 @@
 
 #include "http_request.h"
 
+Mutex *HTTPRequest::pool_mutex = NULL;
+HTTPRequest::ConnectionPool *HTTPRequest::connection_pool = NULL;
+
 void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
 Error HTTPRequest::_request() {
 
+	reused_connection = false;
+
+	if (use_connection_pool && connection_pool) {
+
+		Ref<HTTPClient> pooled;
+
+		pool_mutex->lock();
+		_evict_idle_clients(OS::get_singleton()->get_ticks_msec());
+		ConnectionPool::Element *E = connection_pool->find(_get_pool_key());
+		if (E) {
+			List<PooledClient> &idle = E->get();
+			while (!idle.empty() && pooled.is_null()) {
+				// Most recently used first, older ones are more likely to be closed.
+				PooledClient pc = idle.back()->get();
+				idle.pop_back();
+				pc.client->poll();
+				if (pc.client->get_status() == HTTPClient::STATUS_CONNECTED) {
+					pooled = pc.client;
+				}
+			}
+			if (idle.empty()) {
+				connection_pool->erase(E);
+			}
+		}
+		pool_mutex->unlock();
+
+		if (pooled.is_valid()) {
+			pooled->set_blocking_mode(client->is_blocking_mode_enabled());
+			pooled->set_read_chunk_size(client->get_read_chunk_size());
+			client = pooled;
+			reused_connection = true;
+			return OK;
+		}
+	}
+
 	return client->connect_to_host(url, port, use_ssl, validate_ssl);
 }
 
+bool HTTPRequest::_retry_fresh_connection() {
+
+	// A pooled connection might have been closed by the server while idle,
+	// send the request again on a new one.
+	if (!reused_connection || got_response)
+		return false;
+
+	reused_connection = false;
+	request_sent = false;
+	client->close();
+	return client->connect_to_host(url, port, use_ssl, validate_ssl) == OK;
+}
+
+String HTTPRequest::_get_pool_key() const {
+
+	return url + ":" + itos(port) + (use_ssl ? (validate_ssl ? ":ssl" : ":ssl_unverified") : "");
+}
+
+// Drops pooled connections that were idle for too long, whatever host they
+// are for, so they don't stay open until a request goes there again.
+// Must be called with pool_mutex locked.
+void HTTPRequest::_evict_idle_clients(uint64_t p_now) {
+
+	ConnectionPool::Element *E = connection_pool->front();
+	while (E) {
+		ConnectionPool::Element *next = E->next();
+		List<PooledClient> &idle = E->get();
+		// Oldest first, they were pushed in release order.
+		while (!idle.empty() && p_now - idle.front()->get().idle_since >= POOL_IDLE_TIMEOUT_MSEC) {
+			idle.pop_front();
+		}
+		if (idle.empty()) {
+			connection_pool->erase(E);
+		}
+		E = next;
+	}
+}
+
+void HTTPRequest::_release_client() {
+
+	PooledClient pc;
+	pc.client = client;
+	pc.idle_since = OS::get_singleton()->get_ticks_msec();
+
+	client.instance();
+	client->set_blocking_mode(pc.client->is_blocking_mode_enabled());
+	client->set_read_chunk_size(pc.client->get_read_chunk_size());
+
+	MutexLock lock(pool_mutex);
+	_evict_idle_clients(pc.idle_since);
+	List<PooledClient> &idle = (*connection_pool)[_get_pool_key()];
+	if (idle.size() >= POOL_MAX_IDLE_PER_HOST) {
+		idle.pop_front();
+	}
+	idle.push_back(pc);
+}
+
 Error HTTPRequest::_parse_url(const String &p_url) {
 
 	url = p_url;
@@ -151,6 +246,11 @@ void HTTPRequest::_thread_func(void *p_userdata) {
 
 void HTTPRequest::cancel_request() {
 
+	_finish_request(false);
+}
+
+void HTTPRequest::_finish_request(bool p_keep_connection) {
+
 	timer->stop();
 
 	if (!requesting)
@@ -169,7 +269,11 @@ void HTTPRequest::cancel_request() {
 		memdelete(file);
 		file = NULL;
 	}
-	client->close();
+	if (p_keep_connection && use_connection_pool && connection_pool && client->get_status() == HTTPClient::STATUS_CONNECTED && client->is_keep_alive()) {
+		_release_client();
+	} else {
+		client->close();
+	}
 	body.resize(0);
 	got_response = false;
 	response_code = -1;
@@ -300,6 +404,8 @@ bool HTTPRequest::_update_connection() {
 
 				Error err = client->request(method, request_string, headers, request_data);
 				if (err != OK) {
+					if (_retry_fresh_connection())
+						return false;
 					call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PoolStringArray(), PoolByteArray());
 					return true;
 				}
@@ -360,6 +466,14 @@ bool HTTPRequest::_update_connection() {
 					call_deferred("_request_done", RESULT_DOWNLOAD_FILE_WRITE_ERROR, response_code, response_headers, PoolByteArray());
 					return true;
 				}
+			} else if (stream_body) {
+				if (chunk.size()) {
+					if (use_threads) {
+						call_deferred("emit_signal", "body_chunk_received", chunk);
+					} else {
+						emit_signal("body_chunk_received", chunk);
+					}
+				}
 			} else {
 				body.append_array(chunk);
 			}
@@ -384,6 +498,8 @@ bool HTTPRequest::_update_connection() {
 
 		} break; // Request resulted in body: break which must be read
 		case HTTPClient::STATUS_CONNECTION_ERROR: {
+			if (_retry_fresh_connection())
+				return false;
 			call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PoolStringArray(), PoolByteArray());
 			return true;
 		} break;
@@ -398,7 +514,7 @@ bool HTTPRequest::_update_connection() {
 
 void HTTPRequest::_request_done(int p_status, int p_code, const PoolStringArray &headers, const PoolByteArray &p_data) {
 
-	cancel_request();
+	_finish_request(p_status == RESULT_SUCCESS);
 	emit_signal("request_completed", p_status, p_code, headers, p_data);
 }
 
@@ -458,6 +574,53 @@ String HTTPRequest::get_download_file() const {
 	return download_to_file;
 }
 
+void HTTPRequest::set_stream_body(bool p_enable) {
+
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+
+	stream_body = p_enable;
+}
+
+bool HTTPRequest::is_streaming_body() const {
+
+	return stream_body;
+}
+
+void HTTPRequest::set_use_connection_pool(bool p_enable) {
+
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+
+	use_connection_pool = p_enable;
+}
+
+bool HTTPRequest::is_using_connection_pool() const {
+
+	return use_connection_pool;
+}
+
+void HTTPRequest::initialize_connection_pool() {
+
+	pool_mutex = Mutex::create();
+	connection_pool = memnew(ConnectionPool);
+}
+
+void HTTPRequest::finish_connection_pool() {
+
+	memdelete(connection_pool);
+	connection_pool = NULL;
+	memdelete(pool_mutex);
+	pool_mutex = NULL;
+}
+
+void HTTPRequest::clear_connection_pool() {
+
+	if (!connection_pool)
+		return;
+
+	MutexLock lock(pool_mutex);
+	connection_pool->clear();
+}
+
 void HTTPRequest::set_download_chunk_size(int p_chunk_size) {
 
 	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
@@ -524,6 +687,12 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_redirects", "amount"), &HTTPRequest::set_max_redirects);
 	ClassDB::bind_method(D_METHOD("get_max_redirects"), &HTTPRequest::get_max_redirects);
 
+	ClassDB::bind_method(D_METHOD("set_stream_body", "enable"), &HTTPRequest::set_stream_body);
+	ClassDB::bind_method(D_METHOD("is_streaming_body"), &HTTPRequest::is_streaming_body);
+
+	ClassDB::bind_method(D_METHOD("set_use_connection_pool", "enable"), &HTTPRequest::set_use_connection_pool);
+	ClassDB::bind_method(D_METHOD("is_using_connection_pool"), &HTTPRequest::is_using_connection_pool);
+
 	ClassDB::bind_method(D_METHOD("set_download_file", "path"), &HTTPRequest::set_download_file);
 	ClassDB::bind_method(D_METHOD("get_download_file"), &HTTPRequest::get_download_file);
 
@@ -544,10 +713,13 @@ void HTTPRequest::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "download_file", PROPERTY_HINT_FILE), "set_download_file", "get_download_file");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_download_chunk_size", "get_download_chunk_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_connection_pool"), "set_use_connection_pool", "is_using_connection_pool");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "stream_body"), "set_stream_body", "is_streaming_body");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_redirects", PROPERTY_HINT_RANGE, "-1,64"), "set_max_redirects", "get_max_redirects");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "timeout", PROPERTY_HINT_RANGE, "0,86400"), "set_timeout", "get_timeout");
 
+	ADD_SIGNAL(MethodInfo("body_chunk_received", PropertyInfo(Variant::POOL_BYTE_ARRAY, "chunk")));
 	ADD_SIGNAL(MethodInfo("request_completed", PropertyInfo(Variant::INT, "result"), PropertyInfo(Variant::INT, "response_code"), PropertyInfo(Variant::POOL_STRING_ARRAY, "headers"), PropertyInfo(Variant::POOL_BYTE_ARRAY, "body")));
 
 	BIND_ENUM_CONSTANT(RESULT_SUCCESS);
@@ -586,6 +758,9 @@ HTTPRequest::HTTPRequest() {
 	downloaded = 0;
 	body_size_limit = -1;
 	file = NULL;
+	stream_body = false;
+	use_connection_pool = false;
+	reused_connection = false;
 
 	timer = memnew(Timer);
 	timer->set_one_shot(true);
@@ -33,6 +33,7 @@
 
 #include "core/io/http_client.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "node.h"
 #include "scene/main/timer.h"
@@ -60,6 +61,22 @@ public:
 	};
 
 private:
+	enum {
+		POOL_MAX_IDLE_PER_HOST = 8,
+		POOL_IDLE_TIMEOUT_MSEC = 30000
+	};
+
+	// Keep-alive connections left over by finished requests, shared by all
+	// HTTPRequest nodes and keyed by host, port and SSL settings.
+	struct PooledClient {
+		Ref<HTTPClient> client;
+		uint64_t idle_since;
+	};
+	typedef Map<String, List<PooledClient> > ConnectionPool;
+
+	static Mutex *pool_mutex;
+	static ConnectionPool *connection_pool;
+
 	bool requesting;
 
 	String request_string;
@@ -81,6 +98,9 @@ private:
 	PoolVector<String> response_headers;
 
 	String download_to_file;
+	bool stream_body;
+	bool use_connection_pool;
+	bool reused_connection;
 
 	FileAccess *file;
 
@@ -102,6 +122,12 @@ private:
 
 	Error _parse_url(const String &p_url);
 	Error _request();
+	bool _retry_fresh_connection();
+
+	String _get_pool_key() const;
+	static void _evict_idle_clients(uint64_t p_now);
+	void _release_client();
+	void _finish_request(bool p_keep_connection);
 
 	volatile bool thread_done;
 	volatile bool thread_request_quit;
@@ -145,6 +171,16 @@ public:
 	int get_downloaded_bytes() const;
 	int get_body_size() const;
 
+	void set_stream_body(bool p_enable);
+	bool is_streaming_body() const;
+
+	void set_use_connection_pool(bool p_enable);
+	bool is_using_connection_pool() const;
+
+	static void initialize_connection_pool();
+	static void finish_connection_pool();
+	static void clear_connection_pool();
+
 	HTTPRequest();
 	~HTTPRequest();
 };
@@ -40,7 +40,10 @@
 #include "core/project_settings.h"
 #include "main/input_default.h"
 #include "node.h"
+#include "scene/2d/canvas_item.h"
+#include "scene/3d/spatial.h"
 #include "scene/debugger/script_debugger_remote.h"
+#include "scene/main/http_request.h"
 #include "scene/resources/dynamic_font.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -151,8 +154,34 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 		E->get().changed = true;
 }
 
+void SceneTree::flush_pending_transforms() {
+
+	// Invalidate the subtree of every node whose local transform changed, each
+	// one only once. Nodes stay in the list until the end of the pass, so
+	// pending descendants can tell they are covered by a pending ancestor.
+	for (SelfList<Node> *n = xform_pending_list.first(); n; n = n->next()) {
+
+		Node *node = n->self();
+		Spatial *spatial = Object::cast_to<Spatial>(node);
+		if (spatial) {
+			spatial->_flush_pending_transform();
+			continue;
+		}
+		CanvasItem *ci = Object::cast_to<CanvasItem>(node);
+		if (ci) {
+			ci->_flush_pending_transform();
+		}
+	}
+
+	while (xform_pending_list.first()) {
+		xform_pending_list.remove(xform_pending_list.first());
+	}
+}
+
 void SceneTree::flush_transform_notifications() {
 
+	flush_pending_transforms();
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 
@@ -161,6 +190,9 @@ void SceneTree::flush_transform_notifications() {
 		xform_change_list.remove(n);
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
+		if (xform_pending_list.first()) {
+			flush_pending_transforms();
+		}
 	}
 }
 
@@ -475,7 +507,7 @@ bool SceneTree::iteration(float p_time) {
 	MainLoop::iteration(p_time);
 	physics_process_time = p_time;
 
-	emit_signal("physics_frame");
+	emit_signal(SNAME("physics_frame"));
 
 	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
@@ -488,6 +520,10 @@ bool SceneTree::iteration(float p_time) {
 	_flush_delete_queue();
 	_call_idle_callbacks();
 
+	if (multiplayer_poll) {
+		multiplayer->flush_rpc_batches(); // Don't hold the rpcs of this frame until the next poll.
+	}
+
 	return _quit;
 }
 
@@ -515,7 +551,7 @@ bool SceneTree::idle(float p_time) {
 		multiplayer->poll();
 	}
 
-	emit_signal("idle_frame");
+	emit_signal(SNAME("idle_frame"));
 
 	MessageQueue::get_singleton()->flush(); //small little hack
 
@@ -574,6 +610,10 @@ bool SceneTree::idle(float p_time) {
 
 	_call_idle_callbacks();
 
+	if (multiplayer_poll) {
+		multiplayer->flush_rpc_batches(); // Don't hold the rpcs of this frame until the next poll.
+	}
+
 #ifdef TOOLS_ENABLED
 
 	if (Engine::get_singleton()->is_editor_hint()) {
@@ -622,6 +662,9 @@ void SceneTree::finish() {
 		root = NULL;
 	}
 
+	// Pooled connections can use SSL from modules, which are unregistered before scene types.
+	HTTPRequest::clear_connection_pool();
+
 	// cleanup timers
 	for (List<Ref<SceneTreeTimer> >::Element *E = timers.front(); E; E = E->next()) {
 		E->get()->release_connections();
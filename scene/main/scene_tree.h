@@ -218,6 +218,8 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	// Spatials and CanvasItems whose local transform changed since the last flush.
+	SelfList<Node>::List xform_pending_list;
 
 	friend class ScriptDebuggerRemote;
 #ifdef DEBUG_ENABLED
@@ -289,6 +291,7 @@ public:
 	void notify_group(const StringName &p_group, int p_notification);
 	void set_group(const StringName &p_group, const String &p_name, const Variant &p_value);
 
+	void flush_pending_transforms();
 	void flush_transform_notifications();
 
 	virtual void input_text(const String &p_text);
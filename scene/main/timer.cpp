@@ -58,7 +58,7 @@ void Timer::_notification(int p_what) {
 				else
 					stop();
 
-				emit_signal("timeout");
+				emit_signal(SNAME("timeout"));
 			}
 
 		} break;
@@ -72,7 +72,7 @@ void Timer::_notification(int p_what) {
 					time_left += wait_time;
 				else
 					stop();
-				emit_signal("timeout");
+				emit_signal(SNAME("timeout"));
 			}
 
 		} break;
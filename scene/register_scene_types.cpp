@@ -265,6 +265,7 @@ void register_scene_types() {
 	ClassDB::register_class<Viewport>();
 	ClassDB::register_class<ViewportTexture>();
 	ClassDB::register_class<HTTPRequest>();
+	HTTPRequest::initialize_connection_pool();
 	ClassDB::register_class<Timer>();
 	ClassDB::register_class<CanvasLayer>();
 	ClassDB::register_class<CanvasModulate>();
@@ -784,6 +785,7 @@ void unregister_scene_types() {
 	resource_loader_stream_texture.unref();
 
 	DynamicFont::finish_dynamic_fonts();
+	HTTPRequest::finish_connection_pool();
 
 	ResourceSaver::remove_resource_format_saver(resource_saver_text);
 	resource_saver_text.unref();
@@ -31,6 +31,7 @@
 #include "animation.h"
 #include "scene/scene_string_names.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/geometry.h"
 
 #define ANIM_MIN_LENGTH 0.001
@@ -86,7 +87,12 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			track_set_imported(track, p_value);
 		else if (what == "enabled")
 			track_set_enabled(track, p_value);
-		else if (what == "keys" || what == "key_values") {
+		else if (what == "compressed_keys") {
+
+			ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+			return _set_compressed_keys(static_cast<TransformTrack *>(tracks[track]), p_value);
+
+		} else if (what == "keys" || what == "key_values") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -97,6 +103,8 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 
 				PoolVector<float>::Read r = values.read();
 
+				tt->compressed_keys.clear();
+				tt->compressed_pages.clear();
 				tt->transforms.resize(vcount / 12);
 
 				for (int i = 0; i < (vcount / 12); i++) {
@@ -376,7 +384,13 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = track_is_imported(track);
 		else if (what == "enabled")
 			r_ret = track_is_enabled(track);
-		else if (what == "keys") {
+		else if (what == "compressed_keys") {
+
+			ERR_FAIL_COND_V(!track_is_compressed(track), false);
+			r_ret = _get_compressed_keys(static_cast<const TransformTrack *>(tracks[track]));
+			return true;
+
+		} else if (what == "keys") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -629,7 +643,11 @@ void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/loop_wrap", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/imported", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
-		p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		if (track_is_compressed(i)) {
+			p_list->push_back(PropertyInfo(Variant::POOL_BYTE_ARRAY, "tracks/" + itos(i) + "/compressed_keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		} else {
+			p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 	// gdi
 	p_list->push_back(PropertyInfo(Variant::INT, "import_file_format"));
@@ -860,6 +878,22 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
+
+	if (tt->compressed_keys.size()) {
+
+		ERR_FAIL_INDEX_V(p_key, tt->compressed_keys.size(), ERR_INVALID_PARAMETER);
+
+		TransformKey tk = _get_compressed_key(tt, p_key);
+		if (r_loc)
+			*r_loc = tk.loc;
+		if (r_rot)
+			*r_rot = tk.rot;
+		if (r_scale)
+			*r_scale = tk.scale;
+
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
 
 	if (r_loc)
@@ -879,6 +913,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_transform_track_decompress(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -907,6 +942,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -960,6 +996,14 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed_keys.size()) {
+				int k = _find(tt->compressed_keys, p_time);
+				if (k < 0 || k >= tt->compressed_keys.size())
+					return -1;
+				if (tt->compressed_keys[k].time != p_time && p_exact)
+					return -1;
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size())
 				return -1;
@@ -1145,6 +1189,9 @@ int Animation::track_get_key_count(int p_track) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed_keys.size()) {
+				return tt->compressed_keys.size();
+			}
 			return tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
@@ -1188,9 +1235,21 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
 
 			Dictionary d;
+			if (tt->compressed_keys.size()) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.size(), Variant());
+
+				TransformKey tk = _get_compressed_key(tt, p_key_idx);
+				d["location"] = tk.loc;
+				d["rotation"] = tk.rot;
+				d["scale"] = tk.scale;
+
+				return d;
+			}
+
+			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+
 			d["location"] = tt->transforms[p_key_idx].value.loc;
 			d["rotation"] = tt->transforms[p_key_idx].value.rot;
 			d["scale"] = tt->transforms[p_key_idx].value.scale;
@@ -1264,6 +1323,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed_keys.size()) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.size(), -1);
+				return tt->compressed_keys[p_key_idx].time;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1317,6 +1380,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			TKey<TransformKey> key = tt->transforms[p_key_idx];
 			key.time = p_time;
@@ -1389,6 +1453,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed_keys.size()) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_keys.size(), -1);
+				return 1.0; // only tracks without easing are compressed
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1433,6 +1501,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
 			Dictionary d = p_value;
@@ -1519,6 +1588,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1582,6 +1652,35 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 	return middle;
 }
 
+// Same as _find(), but first tries the key found last time and the one after it.
+// Sequential playback almost always lands on one of those, so the binary search
+// only runs after seeks or large jumps. The cursor is just a hint and may be stale.
+template <class K>
+int Animation::_find_with_cursor(const Vector<K> &p_keys, float p_time, int *r_cursor) const {
+
+	if (!r_cursor)
+		return _find(p_keys, p_time);
+
+	int len = p_keys.size();
+	const K *keys = p_keys.ptr();
+	int cursor = *r_cursor;
+
+	for (int i = MAX(cursor, 0); i < len && i <= cursor + 1; i++) {
+
+		if (p_time < keys[i].time && !Math::is_equal_approx(p_time, keys[i].time))
+			break; // key is after the requested time, cursor went backwards
+
+		if (i + 1 == len || (p_time < keys[i + 1].time && !Math::is_equal_approx(p_time, keys[i + 1].time))) {
+			*r_cursor = i;
+			return i;
+		}
+	}
+
+	int idx = _find(p_keys, p_time);
+	*r_cursor = MAX(idx, 0);
+	return idx;
+}
+
 Animation::TransformKey Animation::_interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const {
 
 	TransformKey ret;
@@ -1728,17 +1827,22 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 	return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
+// Finds the keys to interpolate between at p_time and the weight of the second one.
+// Shared by regular and compressed tracks, so it only looks at key times.
+template <class K>
+bool Animation::_find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_cursor, int &r_len, int &r_idx, int &r_next, float &r_c) const {
 
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	int len;
+	if (p_keys.size() && p_keys[p_keys.size() - 1].time <= length) {
+		len = p_keys.size(); // common case, no keys past the end
+	} else {
+		len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
 		// meaning no keys, or only key time is larger than length
-		if (p_ok)
-			*p_ok = false;
-		return T();
+		return false;
 	}
 	// 注释点：这里的判断和下面的一些判断都存在bug，有两个key的情况下，它算出来的len为1没有问题
 	// 因为它应该是算的数组的上限，比如4个key，算出来是3
@@ -1747,14 +1851,15 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 	// 原流程代码：else if (len == 1)
 	else if (len == 1 && ImportFileFormat::ASSIMP_FBX != gdi_import_file_format) { // one key found (0+1), return it
 
-		if (p_ok)
-			*p_ok = true;
-		return p_keys[0].value;
+		r_len = len;
+		r_idx = r_next = 0;
+		r_c = 0;
+		return true;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find_with_cursor(p_keys, p_time, r_cursor);
 
-	ERR_FAIL_COND_V(idx == -2, T());
+	ERR_FAIL_COND_V(idx == -2, false);
 
 	bool result = true;
 	bool gdi_res = false;
@@ -1849,6 +1954,24 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 		}
 	}
 
+	r_len = len;
+	r_idx = idx;
+	r_next = next;
+	r_c = c;
+
+	return result;
+}
+
+template <class T>
+T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+
+	int len = 0;
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+
+	bool result = _find_interpolation_keys(p_keys, p_time, p_loop_wrap, r_cursor, len, idx, next, c);
+
 	if (p_ok)
 		*p_ok = result;
 	if (!result)
@@ -1893,7 +2016,7 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
@@ -1903,7 +2026,12 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	bool ok = false;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	TransformKey tk;
+	if (tt->compressed_keys.size()) {
+		tk = _interpolate_compressed(tt, p_time, &ok, r_cursor);
+	} else {
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor);
+	}
 
 	if (!ok)
 		return ERR_UNAVAILABLE;
@@ -1920,7 +2048,7 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 	return OK;
 }
 
-Variant Animation::value_track_interpolate(int p_track, float p_time) const {
+Variant Animation::value_track_interpolate(int p_track, float p_time, int *r_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *t = tracks[p_track];
@@ -1929,7 +2057,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok);
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, r_cursor);
 
 	if (ok) {
 
@@ -2095,8 +2223,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 				case TYPE_TRANSFORM: {
 
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->compressed_keys.size()) {
+						_track_get_key_indices_in_range(tt->compressed_keys, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->compressed_keys, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -2155,7 +2288,11 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 		case TYPE_TRANSFORM: {
 
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->compressed_keys.size()) {
+				_track_get_key_indices_in_range(tt->compressed_keys, from_time, to_time, p_indices);
+			} else {
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			}
 
 		} break;
 		case TYPE_VALUE: {
@@ -2854,6 +2991,8 @@ void Animation::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
+	ClassDB::bind_method(D_METHOD("compress", "max_linear_error", "max_angular_error"), &Animation::compress, DEFVAL(0.001), DEFVAL(0.001));
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "track_idx"), &Animation::track_is_compressed);
 
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
@@ -3064,6 +3203,7 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 	ERR_FAIL_INDEX(p_idx, tracks.size());
 	ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
 	TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+	_transform_track_decompress(tt);
 	bool prev_erased = false;
 	TKey<TransformKey> first_erased;
 
@@ -3111,6 +3251,435 @@ void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err
 	}
 }
 
+static _FORCE_INLINE_ uint16_t _quantize_unit(float p_value, float p_min, float p_range) {
+
+	if (p_range <= 0) {
+		return 0;
+	}
+	return uint16_t(CLAMP(Math::round((p_value - p_min) / p_range * 65535.0), 0, 65535));
+}
+
+static _FORCE_INLINE_ float _dequantize_unit(uint16_t p_value, float p_min, float p_range) {
+
+	return p_min + p_range * (p_value / 65535.0);
+}
+
+// Smallest three: the largest component is dropped and rebuilt from the unit length,
+// so the other three fit in [-sqrt(1/2), sqrt(1/2)].
+// With 20 bits each, a rotation moves by less than this (in radians) once quantized.
+static const float QUAT_QUANTIZATION_ERROR = 1e-5;
+
+static void _compress_quat(const Quat &p_quat, uint16_t *r_data) {
+
+	Quat q = p_quat.normalized();
+	const float comps[4] = { q.x, q.y, q.z, q.w };
+
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(comps[i]) > Math::abs(comps[largest])) {
+			largest = i;
+		}
+	}
+
+	float sign = comps[largest] < 0 ? -1.0 : 1.0; // q and -q are the same rotation
+
+	uint64_t bits = largest;
+	int shift = 2;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		float v = comps[i] * sign * Math_SQRT2; // -1 .. 1
+		uint64_t qv = uint64_t(CLAMP(Math::round((v + 1.0) * 0.5 * 0xFFFFF), 0, 0xFFFFF));
+		bits |= qv << shift;
+		shift += 20;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		r_data[i] = (bits >> (i * 16)) & 0xFFFF;
+	}
+}
+
+static Quat _decompress_quat(const uint16_t *p_data) {
+
+	uint64_t bits = uint64_t(p_data[0]) | (uint64_t(p_data[1]) << 16) | (uint64_t(p_data[2]) << 32) | (uint64_t(p_data[3]) << 48);
+
+	int largest = bits & 3;
+	int shift = 2;
+	float comps[4];
+	float sum = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		float v = (((bits >> shift) & 0xFFFFF) / float(0xFFFFF) * 2.0 - 1.0) * Math_SQRT12;
+		comps[i] = v;
+		sum += v * v;
+		shift += 20;
+	}
+	comps[largest] = Math::sqrt(MAX(0.0f, 1.0f - sum));
+
+	return Quat(comps[0], comps[1], comps[2], comps[3]);
+}
+
+Animation::TransformKey Animation::_get_compressed_key(const TransformTrack *p_track, int p_key) const {
+
+	const CompressedTransformKey &ck = p_track->compressed_keys[p_key];
+	const CompressedTransformPage &page = p_track->compressed_pages[p_key / COMPRESSED_PAGE_KEYS];
+
+	TransformKey tk;
+	for (int i = 0; i < 3; i++) {
+		tk.loc[i] = _dequantize_unit(ck.loc[i], page.loc_min[i], page.loc_range[i]);
+		tk.scale[i] = _dequantize_unit(ck.scale[i], page.scale_min[i], page.scale_range[i]);
+	}
+	tk.rot = _decompress_quat(ck.rot);
+
+	return tk;
+}
+
+Animation::TransformKey Animation::_interpolate_compressed(const TransformTrack *p_track, float p_time, bool *p_ok, int *r_cursor) const {
+
+	const Vector<CompressedTransformKey> &keys = p_track->compressed_keys;
+
+	int len = 0;
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+
+	bool result = _find_interpolation_keys(keys, p_time, p_track->loop_wrap, r_cursor, len, idx, next, c);
+
+	if (p_ok)
+		*p_ok = result;
+	if (!result)
+		return TransformKey();
+
+	// Compressed keys have no easing, only decode the keys that are actually needed.
+	if (idx == next || p_track->interpolation == INTERPOLATION_NEAREST) {
+		return _get_compressed_key(p_track, idx);
+	}
+
+	if (p_track->interpolation == INTERPOLATION_CUBIC) {
+		int pre = idx - 1;
+		if (pre < 0)
+			pre = 0;
+		int post = next + 1;
+		if (post >= len)
+			post = next;
+
+		return _cubic_interpolate(_get_compressed_key(p_track, pre), _get_compressed_key(p_track, idx), _get_compressed_key(p_track, next), _get_compressed_key(p_track, post), c);
+	}
+
+	return _interpolate(_get_compressed_key(p_track, idx), _get_compressed_key(p_track, next), c);
+}
+
+// Removes every key that linear interpolation between the kept keys reproduces within
+// the given error. Unlike optimize(), which only looks at three consecutive keys, the
+// error is checked against all the original keys a span replaces.
+void Animation::_transform_track_reduce(TransformTrack *p_track, float p_max_linear_err, float p_max_angular_err) {
+
+	const Vector<TKey<TransformKey> > &keys = p_track->transforms;
+	int count = keys.size();
+	if (count < 3) {
+		return;
+	}
+
+	Vector<TKey<TransformKey> > reduced;
+	reduced.push_back(keys[0]);
+
+	int from = 0;
+	while (from < count - 1) {
+
+		int to = from + 1;
+
+		while (to + 1 < count && to + 1 - from <= COMPRESSED_MAX_REDUCE_SPAN) {
+
+			const TKey<TransformKey> &a = keys[from];
+			const TKey<TransformKey> &b = keys[to + 1];
+			float span = b.time - a.time;
+
+			bool fits = true;
+			for (int i = from + 1; i <= to && fits; i++) {
+
+				float c = span > CMP_EPSILON ? (keys[i].time - a.time) / span : 0;
+				TransformKey v = _interpolate(a.value, b.value, c);
+				const TransformKey &k = keys[i].value;
+
+				if (v.loc.distance_to(k.loc) > p_max_linear_err || v.scale.distance_to(k.scale) > p_max_linear_err) {
+					fits = false;
+				} else {
+					float d = Math::abs(v.rot.normalized().dot(k.rot.normalized()));
+					fits = 2.0 * Math::acos(MIN(d, 1.0f)) <= p_max_angular_err;
+				}
+			}
+
+			if (!fits) {
+				break;
+			}
+			to++;
+		}
+
+		reduced.push_back(keys[to]);
+		from = to;
+	}
+
+	p_track->transforms = reduced;
+}
+
+bool Animation::_transform_track_compress(TransformTrack *p_track, float p_max_linear_err, float p_max_angular_err) {
+
+	if (p_track->compressed_keys.size() || p_track->transforms.empty()) {
+		return false;
+	}
+
+	for (int i = 0; i < p_track->transforms.size(); i++) {
+		if (p_track->transforms[i].transition != 1.0) {
+			return false; // easing is not stored in compressed keys
+		}
+	}
+
+	if (p_track->interpolation == INTERPOLATION_LINEAR) {
+
+		// Quantization moves every kept key by up to half a step on each axis, and
+		// interpolating between them can't move further than that, so it comes out
+		// of the error budget. Pages never span more than the whole track.
+		Vector3 loc_min = p_track->transforms[0].value.loc;
+		Vector3 loc_max = loc_min;
+		Vector3 scale_min = p_track->transforms[0].value.scale;
+		Vector3 scale_max = scale_min;
+		for (int i = 1; i < p_track->transforms.size(); i++) {
+			const TransformKey &k = p_track->transforms[i].value;
+			for (int j = 0; j < 3; j++) {
+				loc_min[j] = MIN(loc_min[j], k.loc[j]);
+				loc_max[j] = MAX(loc_max[j], k.loc[j]);
+				scale_min[j] = MIN(scale_min[j], k.scale[j]);
+				scale_max[j] = MAX(scale_max[j], k.scale[j]);
+			}
+		}
+		float linear_step = MAX((loc_max - loc_min).length(), (scale_max - scale_min).length()) * 0.5 / 65535.0;
+
+		_transform_track_reduce(p_track, MAX(0.0f, p_max_linear_err - linear_step), MAX(0.0f, p_max_angular_err - QUAT_QUANTIZATION_ERROR));
+	}
+
+	const TKey<TransformKey> *keys = p_track->transforms.ptr();
+	int count = p_track->transforms.size();
+	int page_count = (count + COMPRESSED_PAGE_KEYS - 1) / COMPRESSED_PAGE_KEYS;
+
+	p_track->compressed_keys.resize(count);
+	p_track->compressed_pages.resize(page_count);
+	CompressedTransformKey *ckeys = p_track->compressed_keys.ptrw();
+
+	for (int p = 0; p < page_count; p++) {
+
+		int from = p * COMPRESSED_PAGE_KEYS;
+		int to = MIN(from + COMPRESSED_PAGE_KEYS, count);
+
+		Vector3 loc_min = keys[from].value.loc;
+		Vector3 loc_max = loc_min;
+		Vector3 scale_min = keys[from].value.scale;
+		Vector3 scale_max = scale_min;
+
+		for (int i = from + 1; i < to; i++) {
+			for (int j = 0; j < 3; j++) {
+				loc_min[j] = MIN(loc_min[j], keys[i].value.loc[j]);
+				loc_max[j] = MAX(loc_max[j], keys[i].value.loc[j]);
+				scale_min[j] = MIN(scale_min[j], keys[i].value.scale[j]);
+				scale_max[j] = MAX(scale_max[j], keys[i].value.scale[j]);
+			}
+		}
+
+		CompressedTransformPage &page = p_track->compressed_pages.write[p];
+		page.loc_min = loc_min;
+		page.loc_range = loc_max - loc_min;
+		page.scale_min = scale_min;
+		page.scale_range = scale_max - scale_min;
+
+		for (int i = from; i < to; i++) {
+
+			CompressedTransformKey &ck = ckeys[i];
+			ck.time = keys[i].time;
+			for (int j = 0; j < 3; j++) {
+				ck.loc[j] = _quantize_unit(keys[i].value.loc[j], page.loc_min[j], page.loc_range[j]);
+				ck.scale[j] = _quantize_unit(keys[i].value.scale[j], page.scale_min[j], page.scale_range[j]);
+			}
+			_compress_quat(keys[i].value.rot, ck.rot);
+		}
+	}
+
+	p_track->transforms.clear();
+
+	return true;
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+
+	if (p_track->compressed_keys.empty()) {
+		return;
+	}
+
+	int count = p_track->compressed_keys.size();
+	p_track->transforms.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		TKey<TransformKey> &tk = p_track->transforms.write[i];
+		tk.time = p_track->compressed_keys[i].time;
+		tk.transition = 1.0;
+		tk.value = _get_compressed_key(p_track, i);
+	}
+
+	p_track->compressed_keys.clear();
+	p_track->compressed_pages.clear();
+}
+
+// Serialized as: key count, then 12 floats of bounds per page, then each key as its
+// time followed by the ten quantized components.
+PoolVector<uint8_t> Animation::_get_compressed_keys(const TransformTrack *p_track) const {
+
+	int count = p_track->compressed_keys.size();
+	int page_count = p_track->compressed_pages.size();
+
+	int64_t size = 4 + int64_t(page_count) * 12 * 4 + int64_t(count) * (4 + 10 * 2);
+	ERR_FAIL_COND_V(size > INT32_MAX, PoolVector<uint8_t>());
+
+	PoolVector<uint8_t> data;
+	data.resize(size);
+
+	PoolVector<uint8_t>::Write w = data.write();
+	uint8_t *ptr = w.ptr();
+
+	ptr += encode_uint32(count, ptr);
+
+	for (int i = 0; i < page_count; i++) {
+		const CompressedTransformPage &page = p_track->compressed_pages[i];
+		for (int j = 0; j < 3; j++) {
+			ptr += encode_float(page.loc_min[j], ptr);
+		}
+		for (int j = 0; j < 3; j++) {
+			ptr += encode_float(page.loc_range[j], ptr);
+		}
+		for (int j = 0; j < 3; j++) {
+			ptr += encode_float(page.scale_min[j], ptr);
+		}
+		for (int j = 0; j < 3; j++) {
+			ptr += encode_float(page.scale_range[j], ptr);
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		const CompressedTransformKey &ck = p_track->compressed_keys[i];
+		ptr += encode_float(ck.time, ptr);
+		for (int j = 0; j < 3; j++) {
+			ptr += encode_uint16(ck.loc[j], ptr);
+		}
+		for (int j = 0; j < 4; j++) {
+			ptr += encode_uint16(ck.rot[j], ptr);
+		}
+		for (int j = 0; j < 3; j++) {
+			ptr += encode_uint16(ck.scale[j], ptr);
+		}
+	}
+
+	return data;
+}
+
+bool Animation::_set_compressed_keys(TransformTrack *p_track, const PoolVector<uint8_t> &p_data) {
+
+	ERR_FAIL_COND_V(p_data.size() < 4, false);
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+	const uint8_t *ptr = r.ptr();
+
+	int64_t count = decode_uint32(ptr);
+	ptr += 4;
+	int64_t page_count = (count + COMPRESSED_PAGE_KEYS - 1) / COMPRESSED_PAGE_KEYS;
+
+	ERR_FAIL_COND_V(count <= 0 || int64_t(p_data.size()) != 4 + page_count * 12 * 4 + count * (4 + 10 * 2), false);
+
+	p_track->transforms.clear();
+	p_track->compressed_pages.resize(page_count);
+	p_track->compressed_keys.resize(count);
+
+	for (int i = 0; i < page_count; i++) {
+		CompressedTransformPage &page = p_track->compressed_pages.write[i];
+		for (int j = 0; j < 3; j++) {
+			page.loc_min[j] = decode_float(ptr);
+			ptr += 4;
+		}
+		for (int j = 0; j < 3; j++) {
+			page.loc_range[j] = decode_float(ptr);
+			ptr += 4;
+		}
+		for (int j = 0; j < 3; j++) {
+			page.scale_min[j] = decode_float(ptr);
+			ptr += 4;
+		}
+		for (int j = 0; j < 3; j++) {
+			page.scale_range[j] = decode_float(ptr);
+			ptr += 4;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		CompressedTransformKey &ck = p_track->compressed_keys.write[i];
+		ck.time = decode_float(ptr);
+		ptr += 4;
+		for (int j = 0; j < 3; j++) {
+			ck.loc[j] = decode_uint16(ptr);
+			ptr += 2;
+		}
+		for (int j = 0; j < 4; j++) {
+			ck.rot[j] = decode_uint16(ptr);
+			ptr += 2;
+		}
+		for (int j = 0; j < 3; j++) {
+			ck.scale[j] = decode_uint16(ptr);
+			ptr += 2;
+		}
+	}
+
+	return true;
+}
+
+void Animation::compress(float p_max_linear_err, float p_max_angular_err) {
+
+	bool changed = false;
+	for (int i = 0; i < tracks.size(); i++) {
+
+		if (tracks[i]->type == TYPE_TRANSFORM) {
+			changed = _transform_track_compress(static_cast<TransformTrack *>(tracks[i]), p_max_linear_err, p_max_angular_err) || changed;
+		}
+	}
+
+	if (changed) {
+		emit_changed();
+	}
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	if (tracks[p_track]->type != TYPE_TRANSFORM) {
+		return false;
+	}
+	return static_cast<const TransformTrack *>(tracks[p_track])->compressed_keys.size() > 0;
+}
+
+int Animation::get_transform_track_memory_usage() const {
+
+	int usage = 0;
+	for (int i = 0; i < tracks.size(); i++) {
+
+		if (tracks[i]->type != TYPE_TRANSFORM) {
+			continue;
+		}
+		const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[i]);
+		usage += tt->transforms.size() * sizeof(TKey<TransformKey>);
+		usage += tt->compressed_keys.size() * sizeof(CompressedTransformKey);
+		usage += tt->compressed_pages.size() * sizeof(CompressedTransformPage);
+	}
+
+	return usage;
+}
+
 void Animation::gdi_set_edit_anim_tracks_flag(bool flag) {
 	gdi_edit_anim_tracks_flag = flag;
 }
@@ -103,10 +103,38 @@ private:
 
 	/* TRANSFORM TRACK */
 
+	// Transform key quantized by compress(). Location and scale are stored in 16 bits
+	// relative to the bounds of the page the key belongs to, rotation keeps the three
+	// smallest components in 20 bits each plus the index of the largest one.
+	struct CompressedTransformKey {
+
+		float time;
+		uint16_t loc[3];
+		uint16_t rot[4];
+		uint16_t scale[3];
+	};
+
+	enum {
+		COMPRESSED_PAGE_KEYS = 256, // keys sharing the same quantization bounds
+		COMPRESSED_MAX_REDUCE_SPAN = 128 // keys checked when removing redundant ones
+	};
+
+	struct CompressedTransformPage {
+
+		Vector3 loc_min;
+		Vector3 loc_range;
+		Vector3 scale_min;
+		Vector3 scale_range;
+	};
+
 	struct TransformTrack : public Track {
 
 		Vector<TKey<TransformKey> > transforms;
 
+		// When not empty, the track is compressed and these replace transforms.
+		Vector<CompressedTransformKey> compressed_keys;
+		Vector<CompressedTransformPage> compressed_pages;
+
 		TransformTrack() { type = TYPE_TRANSFORM; }
 	};
 
@@ -202,6 +230,9 @@ private:
 	template <class K>
 	inline int _find(const Vector<K> &p_keys, float p_time) const;
 
+	template <class K>
+	inline int _find_with_cursor(const Vector<K> &p_keys, float p_time, int *r_cursor) const;
+
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
 	_FORCE_INLINE_ Vector3 _interpolate(const Vector3 &p_a, const Vector3 &p_b, float p_c) const;
@@ -215,8 +246,19 @@ private:
 	_FORCE_INLINE_ Variant _cubic_interpolate(const Variant &p_pre_a, const Variant &p_a, const Variant &p_b, const Variant &p_post_b, float p_c) const;
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
+	template <class K>
+	_FORCE_INLINE_ bool _find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_cursor, int &r_len, int &r_idx, int &r_next, float &r_c) const;
+
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = NULL) const;
+
+	TransformKey _interpolate_compressed(const TransformTrack *p_track, float p_time, bool *p_ok, int *r_cursor) const;
+	TransformKey _get_compressed_key(const TransformTrack *p_track, int p_key) const;
+	bool _transform_track_compress(TransformTrack *p_track, float p_max_linear_err, float p_max_angular_err);
+	void _transform_track_decompress(TransformTrack *p_track);
+	void _transform_track_reduce(TransformTrack *p_track, float p_max_linear_err, float p_max_angular_err);
+	PoolVector<uint8_t> _get_compressed_keys(const TransformTrack *p_track) const;
+	bool _set_compressed_keys(TransformTrack *p_track, const PoolVector<uint8_t> &p_data);
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -342,9 +384,9 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor = NULL) const;
 
-	Variant value_track_interpolate(int p_track, float p_time) const;
+	Variant value_track_interpolate(int p_track, float p_time, int *r_cursor = NULL) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -369,6 +411,9 @@ public:
 	void clear();
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
+	void compress(float p_max_linear_err = 0.001, float p_max_angular_err = 0.001);
+	bool track_is_compressed(int p_track) const;
+	int get_transform_track_memory_usage() const;
 
 	// ----gdi relevant
 	void gdi_set_edit_anim_tracks_flag(bool flag);
@@ -90,6 +90,69 @@ void AudioStreamPlaybackSample::seek(float p_time) {
 	offset = uint64_t(p_time * base->mix_rate) << MIX_FRAC_BITS;
 }
 
+void AudioStreamPlaybackSample::skip(float p_time) {
+
+	if (!active)
+		return;
+
+	int64_t frames = int64_t(p_time * base->mix_rate);
+	int64_t len = int64_t(base->get_length() * base->mix_rate);
+	int64_t pos = offset >> MIX_FRAC_BITS;
+	int64_t loop_begin = base->loop_begin;
+	int64_t loop_end = base->loop_end;
+	int64_t loop_len = loop_end - loop_begin;
+	AudioStreamSample::LoopMode loop_mode = loop_len > 0 ? base->loop_mode : AudioStreamSample::LOOP_DISABLED;
+
+	if (base->format == AudioStreamSample::FORMAT_IMA_ADPCM) {
+		//no seeking in ima-adpcm, only check if it would have ended
+		if (loop_mode == AudioStreamSample::LOOP_DISABLED && pos + frames >= len) {
+			active = false;
+		}
+		return;
+	}
+
+	switch (loop_mode) {
+		case AudioStreamSample::LOOP_DISABLED: {
+			pos += frames;
+			if (pos >= len) {
+				active = false;
+				return;
+			}
+		} break;
+		case AudioStreamSample::LOOP_FORWARD: {
+			pos += frames;
+			if (pos >= loop_end) {
+				pos = loop_begin + (pos - loop_begin) % loop_len;
+			}
+		} break;
+		case AudioStreamSample::LOOP_BACKWARD: {
+			sign = -1;
+			pos -= frames;
+			if (pos < loop_begin) {
+				pos = loop_end - 1 - (loop_end - 1 - pos) % loop_len;
+			}
+		} break;
+		case AudioStreamSample::LOOP_PING_PONG: {
+			if ((sign > 0 && pos + frames < loop_end) || (sign < 0 && pos - frames >= loop_begin)) {
+				pos += frames * sign;
+				break;
+			}
+			//position within one forward and backward pass over the loop
+			int64_t cycle = sign > 0 ? pos - loop_begin : 2 * loop_len - (pos - loop_begin);
+			cycle = (cycle + frames) % (2 * loop_len);
+			if (cycle < loop_len) {
+				pos = loop_begin + cycle;
+				sign = 1;
+			} else {
+				pos = loop_begin + 2 * loop_len - cycle;
+				sign = -1;
+			}
+		} break;
+	}
+
+	offset = pos << MIX_FRAC_BITS;
+}
+
 template <class Depth, bool is_stereo, bool is_ima_adpcm>
 void AudioStreamPlaybackSample::do_resample(const Depth *p_src, AudioFrame *p_dst, int64_t &offset, int32_t &increment, uint32_t amount, IMA_ADPCM_State *ima_adpcm) {
 
@@ -30,6 +30,7 @@
 
 #include "mesh.h"
 
+#include "core/method_bind_ext.gen.inc"
 #include "core/pair.h"
 #include "scene/resources/concave_polygon_shape.h"
 #include "scene/resources/convex_polygon_shape.h"
@@ -872,6 +873,22 @@ void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &
 	emit_changed();
 }
 
+void ArrayMesh::add_surface_from_buffers(PrimitiveType p_primitive, uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb) {
+
+	ERR_FAIL_COND(VisualServer::get_singleton()->mesh_surface_validate_buffers(p_format, p_vertex_array, p_vertex_count, p_index_array, p_index_count) != OK);
+
+	AABB aabb = p_aabb;
+	if (aabb == AABB()) {
+		aabb = VisualServer::get_singleton()->mesh_surface_get_buffer_aabb(p_format, p_vertex_array, p_vertex_count);
+	}
+
+	add_surface(p_format, p_primitive, p_vertex_array, p_vertex_count, p_index_array, p_index_count, aabb);
+
+	clear_cache();
+	_change_notify();
+	emit_changed();
+}
+
 Array ArrayMesh::surface_get_arrays(int p_surface) const {
 
 	ERR_FAIL_INDEX_V(p_surface, surfaces.size(), Array());
@@ -1013,6 +1030,41 @@ void ArrayMesh::surface_update_region(int p_surface, int p_offset, const PoolVec
 	emit_changed();
 }
 
+void ArrayMesh::surface_update_vertices(int p_surface, int p_first_vertex, const Array &p_arrays) {
+
+	ERR_FAIL_INDEX(p_surface, surfaces.size());
+
+	uint32_t format = surface_get_format(p_surface);
+	int array_len = surface_get_array_len(p_surface);
+
+	PoolVector<uint8_t> data;
+	int count = 0;
+	ERR_FAIL_COND(VS::get_singleton()->mesh_surface_pack_vertex_arrays(format, p_arrays, data, count) != OK);
+	ERR_FAIL_COND_MSG(p_first_vertex < 0 || p_first_vertex + count > array_len, "Vertex range is outside of the surface.");
+
+	int stride = data.size() / count;
+	VS::get_singleton()->mesh_surface_update_region(mesh, p_surface, p_first_vertex * stride, data);
+	emit_changed();
+}
+
+void ArrayMesh::surface_update_indices(int p_surface, int p_first_index, const PoolVector<int> &p_indices) {
+
+	ERR_FAIL_INDEX(p_surface, surfaces.size());
+
+	int index_len = surface_get_array_index_len(p_surface);
+	ERR_FAIL_COND_MSG(index_len == 0, "Surface has no index array.");
+	ERR_FAIL_COND_MSG(p_first_index < 0 || p_first_index + p_indices.size() > index_len, "Index range is outside of the surface.");
+
+	int array_len = surface_get_array_len(p_surface);
+
+	PoolVector<uint8_t> data;
+	ERR_FAIL_COND(VS::get_singleton()->mesh_surface_pack_index_array(array_len, p_indices, data) != OK);
+
+	int index_size = array_len < (1 << 16) ? 2 : 4;
+	VS::get_singleton()->mesh_surface_update_index_region(mesh, p_surface, p_first_index * index_size, data);
+	emit_changed();
+}
+
 void ArrayMesh::surface_set_custom_aabb(int p_idx, const AABB &p_aabb) {
 
 	ERR_FAIL_INDEX(p_idx, surfaces.size());
@@ -1294,8 +1346,11 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_blend_shape_mode"), &ArrayMesh::get_blend_shape_mode);
 
 	ClassDB::bind_method(D_METHOD("add_surface_from_arrays", "primitive", "arrays", "blend_shapes", "compress_flags"), &ArrayMesh::add_surface_from_arrays, DEFVAL(Array()), DEFVAL(ARRAY_COMPRESS_DEFAULT));
+	ClassDB::bind_method(D_METHOD("add_surface_from_buffers", "primitive", "format", "vertex_array", "vertex_count", "index_array", "index_count", "aabb"), &ArrayMesh::add_surface_from_buffers, DEFVAL(PoolVector<uint8_t>()), DEFVAL(0), DEFVAL(AABB()));
 	ClassDB::bind_method(D_METHOD("surface_remove", "surf_idx"), &ArrayMesh::surface_remove);
 	ClassDB::bind_method(D_METHOD("surface_update_region", "surf_idx", "offset", "data"), &ArrayMesh::surface_update_region);
+	ClassDB::bind_method(D_METHOD("surface_update_vertices", "surf_idx", "first_vertex", "arrays"), &ArrayMesh::surface_update_vertices);
+	ClassDB::bind_method(D_METHOD("surface_update_indices", "surf_idx", "first_index", "indices"), &ArrayMesh::surface_update_indices);
 	ClassDB::bind_method(D_METHOD("surface_get_array_len", "surf_idx"), &ArrayMesh::surface_get_array_len);
 	ClassDB::bind_method(D_METHOD("surface_get_array_index_len", "surf_idx"), &ArrayMesh::surface_get_array_index_len);
 	ClassDB::bind_method(D_METHOD("surface_get_format", "surf_idx"), &ArrayMesh::surface_get_format);
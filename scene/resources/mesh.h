@@ -187,6 +187,7 @@ protected:
 
 public:
 	void add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes = Array(), uint32_t p_flags = ARRAY_COMPRESS_DEFAULT);
+	void add_surface_from_buffers(PrimitiveType p_primitive, uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array = PoolVector<uint8_t>(), int p_index_count = 0, const AABB &p_aabb = AABB());
 	void add_surface(uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>());
 
 	Array surface_get_arrays(int p_surface) const;
@@ -201,6 +202,8 @@ public:
 	BlendShapeMode get_blend_shape_mode() const;
 
 	void surface_update_region(int p_surface, int p_offset, const PoolVector<uint8_t> &p_data);
+	void surface_update_vertices(int p_surface, int p_first_vertex, const Array &p_arrays);
+	void surface_update_indices(int p_surface, int p_first_index, const PoolVector<int> &p_indices);
 
 	int get_surface_count() const;
 	void surface_remove(int p_idx);
@@ -179,13 +179,12 @@ Error MeshDataTool::create_from_surface(const Ref<ArrayMesh> &p_mesh, int p_surf
 	return OK;
 }
 
-Error MeshDataTool::commit_to_surface(const Ref<ArrayMesh> &p_mesh) {
+Array MeshDataTool::_make_arrays(int p_from_vertex, int p_vertex_count, bool p_with_indices) const {
 
-	ERR_FAIL_COND_V(p_mesh.is_null(), ERR_INVALID_PARAMETER);
 	Array arr;
 	arr.resize(Mesh::ARRAY_MAX);
 
-	int vcount = vertices.size();
+	int vcount = p_vertex_count;
 
 	PoolVector<Vector3> v;
 	PoolVector<Vector3> n;
@@ -246,7 +245,7 @@ Error MeshDataTool::commit_to_surface(const Ref<ArrayMesh> &p_mesh) {
 
 		for (int i = 0; i < vcount; i++) {
 
-			const Vertex &vtx = vertices[i];
+			const Vertex &vtx = vertices[p_from_vertex + i];
 
 			vr[i] = vtx.vertex;
 			if (nr.ptr())
@@ -281,19 +280,22 @@ Error MeshDataTool::commit_to_surface(const Ref<ArrayMesh> &p_mesh) {
 			}
 		}
 
-		int fc = faces.size();
-		in.resize(fc * 3);
-		PoolVector<int>::Write iw = in.write();
-		for (int i = 0; i < fc; i++) {
+		if (p_with_indices) {
+			int fc = faces.size();
+			in.resize(fc * 3);
+			PoolVector<int>::Write iw = in.write();
+			for (int i = 0; i < fc; i++) {
 
-			iw[i * 3 + 0] = faces[i].v[0];
-			iw[i * 3 + 1] = faces[i].v[1];
-			iw[i * 3 + 2] = faces[i].v[2];
+				iw[i * 3 + 0] = faces[i].v[0];
+				iw[i * 3 + 1] = faces[i].v[1];
+				iw[i * 3 + 2] = faces[i].v[2];
+			}
 		}
 	}
 
 	arr[Mesh::ARRAY_VERTEX] = v;
-	arr[Mesh::ARRAY_INDEX] = in;
+	if (in.size())
+		arr[Mesh::ARRAY_INDEX] = in;
 	if (n.size())
 		arr[Mesh::ARRAY_NORMAL] = n;
 	if (c.size())
@@ -309,6 +311,15 @@ Error MeshDataTool::commit_to_surface(const Ref<ArrayMesh> &p_mesh) {
 	if (w.size())
 		arr[Mesh::ARRAY_WEIGHTS] = w;
 
+	return arr;
+}
+
+Error MeshDataTool::commit_to_surface(const Ref<ArrayMesh> &p_mesh) {
+
+	ERR_FAIL_COND_V(p_mesh.is_null(), ERR_INVALID_PARAMETER);
+
+	Array arr = _make_arrays(0, vertices.size(), true);
+
 	Ref<ArrayMesh> ncmesh = p_mesh;
 	int sc = ncmesh->get_surface_count();
 	ncmesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arr);
@@ -317,6 +328,28 @@ Error MeshDataTool::commit_to_surface(const Ref<ArrayMesh> &p_mesh) {
 	return OK;
 }
 
+Error MeshDataTool::commit_vertices_to_surface(const Ref<ArrayMesh> &p_mesh, int p_surface, int p_from_vertex, int p_vertex_count) {
+
+	ERR_FAIL_COND_V(p_mesh.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_INDEX_V(p_surface, p_mesh->get_surface_count(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_mesh->surface_get_array_len(p_surface) != vertices.size(), ERR_INVALID_PARAMETER, "Surface vertex count doesn't match the MeshDataTool's.");
+
+	if (p_vertex_count < 0) {
+		p_vertex_count = vertices.size() - p_from_vertex;
+	}
+	ERR_FAIL_COND_V(p_from_vertex < 0 || p_vertex_count <= 0 || p_from_vertex + p_vertex_count > vertices.size(), ERR_INVALID_PARAMETER);
+
+	uint32_t surface_format = p_mesh->surface_get_format(p_surface) & (Mesh::ARRAY_FORMAT_INDEX - 1);
+	ERR_FAIL_COND_V_MSG(surface_format != (format & (Mesh::ARRAY_FORMAT_INDEX - 1)), ERR_INVALID_PARAMETER, "Surface format doesn't match the MeshDataTool's.");
+
+	Array arr = _make_arrays(p_from_vertex, p_vertex_count, false);
+
+	Ref<ArrayMesh> ncmesh = p_mesh;
+	ncmesh->surface_update_vertices(p_surface, p_from_vertex, arr);
+
+	return OK;
+}
+
 int MeshDataTool::get_format() const {
 
 	return format;
@@ -522,6 +555,7 @@ void MeshDataTool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("clear"), &MeshDataTool::clear);
 	ClassDB::bind_method(D_METHOD("create_from_surface", "mesh", "surface"), &MeshDataTool::create_from_surface);
 	ClassDB::bind_method(D_METHOD("commit_to_surface", "mesh"), &MeshDataTool::commit_to_surface);
+	ClassDB::bind_method(D_METHOD("commit_vertices_to_surface", "mesh", "surface", "from_vertex", "vertex_count"), &MeshDataTool::commit_vertices_to_surface, DEFVAL(0), DEFVAL(-1));
 
 	ClassDB::bind_method(D_METHOD("get_format"), &MeshDataTool::get_format);
 
@@ -74,6 +74,8 @@ class MeshDataTool : public Reference {
 
 	Ref<Material> material;
 
+	Array _make_arrays(int p_from_vertex, int p_vertex_count, bool p_with_indices) const;
+
 protected:
 	static void _bind_methods();
 
@@ -81,6 +83,7 @@ public:
 	void clear();
 	Error create_from_surface(const Ref<ArrayMesh> &p_mesh, int p_surface);
 	Error commit_to_surface(const Ref<ArrayMesh> &p_mesh);
+	Error commit_vertices_to_surface(const Ref<ArrayMesh> &p_mesh, int p_surface, int p_from_vertex = 0, int p_vertex_count = -1);
 
 	int get_format() const;
 
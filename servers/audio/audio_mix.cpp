@@ -0,0 +1,164 @@
+/*************************************************************************/
+/*  audio_mix.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "audio_mix.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_MIX_SSE2
+#include <emmintrin.h>
+#endif
+
+// Two stereo frames fit in a SSE register, the scalar loops below handle
+// the odd frame left at the end.
+
+void AudioMix::clear(AudioFrame *p_dst, int p_frames) {
+
+	int i = 0;
+#ifdef AUDIO_MIX_SSE2
+	const __m128 z = _mm_setzero_ps();
+	for (; i + 2 <= p_frames; i += 2) {
+		_mm_storeu_ps(&p_dst[i].l, z);
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] = AudioFrame(0, 0);
+	}
+}
+
+void AudioMix::add(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames) {
+
+	int i = 0;
+#ifdef AUDIO_MIX_SSE2
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 d = _mm_loadu_ps(&p_dst[i].l);
+		__m128 s = _mm_loadu_ps(&p_src[i].l);
+		_mm_storeu_ps(&p_dst[i].l, _mm_add_ps(d, s));
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+void AudioMix::add_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_volume, const AudioFrame &p_volume_inc) {
+
+	AudioFrame vol = p_volume;
+	int i = 0;
+#ifdef AUDIO_MIX_SSE2
+	if (p_frames >= 2) {
+		__m128 v = _mm_setr_ps(vol.l, vol.r, vol.l + p_volume_inc.l, vol.r + p_volume_inc.r);
+		__m128 step = _mm_setr_ps(p_volume_inc.l * 2, p_volume_inc.r * 2, p_volume_inc.l * 2, p_volume_inc.r * 2);
+		for (; i + 2 <= p_frames; i += 2) {
+			__m128 d = _mm_loadu_ps(&p_dst[i].l);
+			__m128 s = _mm_loadu_ps(&p_src[i].l);
+			_mm_storeu_ps(&p_dst[i].l, _mm_add_ps(d, _mm_mul_ps(s, v)));
+			v = _mm_add_ps(v, step);
+		}
+		vol = AudioFrame(p_volume.l + p_volume_inc.l * i, p_volume.r + p_volume_inc.r * i);
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * vol;
+		vol += p_volume_inc;
+	}
+}
+
+void AudioMix::scale_ramp(AudioFrame *p_buffer, int p_frames, float p_volume, float p_volume_inc) {
+
+	float vol = p_volume;
+	int i = 0;
+#ifdef AUDIO_MIX_SSE2
+	if (p_frames >= 2) {
+		__m128 v = _mm_setr_ps(vol, vol, vol + p_volume_inc, vol + p_volume_inc);
+		__m128 step = _mm_set1_ps(p_volume_inc * 2);
+		for (; i + 2 <= p_frames; i += 2) {
+			_mm_storeu_ps(&p_buffer[i].l, _mm_mul_ps(_mm_loadu_ps(&p_buffer[i].l), v));
+			v = _mm_add_ps(v, step);
+		}
+		vol = p_volume + p_volume_inc * i;
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= vol;
+		vol += p_volume_inc;
+	}
+}
+
+AudioFrame AudioMix::scale_peak(AudioFrame *p_buffer, int p_frames, float p_volume) {
+
+	AudioFrame peak = AudioFrame(0, 0);
+	int i = 0;
+#ifdef AUDIO_MIX_SSE2
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 vol = _mm_set1_ps(p_volume);
+	__m128 vpeak = _mm_setzero_ps();
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 s = _mm_mul_ps(_mm_loadu_ps(&p_buffer[i].l), vol);
+		_mm_storeu_ps(&p_buffer[i].l, s);
+		vpeak = _mm_max_ps(vpeak, _mm_and_ps(s, abs_mask));
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, vpeak);
+	peak = AudioFrame(MAX(lanes[0], lanes[2]), MAX(lanes[1], lanes[3]));
+#endif
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= p_volume;
+		peak.l = MAX(peak.l, ABS(p_buffer[i].l));
+		peak.r = MAX(peak.r, ABS(p_buffer[i].r));
+	}
+	return peak;
+}
+
+void AudioMix::to_int32(int32_t *p_dst, int p_dst_stride, const AudioFrame *p_src, int p_frames) {
+
+	// Same as (int32_t)(sample * ((1 << 20) - 1)) << 11, keeping the sign.
+	int i = 0;
+#ifdef AUDIO_MIX_SSE2
+	const __m128 lo = _mm_set1_ps(-1.0f);
+	const __m128 hi = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps((1 << 20) - 1);
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 s = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[i].l), lo), hi);
+		__m128i v = _mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(s, scale)), 11);
+		if (p_dst_stride == 2) {
+			_mm_storeu_si128((__m128i *)(p_dst + i * 2), v);
+		} else {
+			_mm_storel_epi64((__m128i *)(p_dst + i * p_dst_stride), v);
+			_mm_storel_epi64((__m128i *)(p_dst + (i + 1) * p_dst_stride), _mm_srli_si128(v, 8));
+		}
+	}
+#endif
+	for (; i < p_frames; i++) {
+		float l = CLAMP(p_src[i].l, -1.0, 1.0);
+		float r = CLAMP(p_src[i].r, -1.0, 1.0);
+		p_dst[i * p_dst_stride + 0] = int32_t(l * ((1 << 20) - 1)) * (1 << 11);
+		p_dst[i * p_dst_stride + 1] = int32_t(r * ((1 << 20) - 1)) * (1 << 11);
+	}
+}
@@ -0,0 +1,53 @@
+/*************************************************************************/
+/*  audio_mix.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+#include "core/math/audio_frame.h"
+
+// Inner loops of the mixer, working on whole buffers so several frames can
+// be processed per instruction where the CPU allows it. Volume ramps start
+// at p_volume and increase by p_volume_inc every frame.
+class AudioMix {
+public:
+	static void clear(AudioFrame *p_dst, int p_frames);
+	static void add(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames);
+	static void add_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_volume, const AudioFrame &p_volume_inc);
+	static void scale_ramp(AudioFrame *p_buffer, int p_frames, float p_volume, float p_volume_inc);
+
+	// Returns the highest absolute value left and right, after scaling.
+	static AudioFrame scale_peak(AudioFrame *p_buffer, int p_frames, float p_volume);
+
+	// Clamps and converts to driver samples, one stereo pair every p_dst_stride samples.
+	static void to_int32(int32_t *p_dst, int p_dst_stride, const AudioFrame *p_src, int p_frames);
+};
+
+#endif // AUDIO_MIX_H
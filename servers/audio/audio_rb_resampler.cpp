@@ -146,6 +146,34 @@ bool AudioRBResampler::mix(AudioFrame *p_dest, int p_frames) {
 	return true;
 }
 
+// Reads frames as they were written, without resampling, for using this as a plain ring buffer
+int AudioRBResampler::read(AudioFrame *p_dest, int p_frames) {
+
+	if (!rb)
+		return 0;
+
+	ERR_FAIL_COND_V(channels > 2, 0);
+
+	int todo = MIN(get_reader_space(), p_frames);
+	int pos = rb_read_pos;
+
+	if (channels == 1) {
+		for (int i = 0; i < todo; i++) {
+			p_dest[i] = AudioFrame(rb[pos], rb[pos]);
+			pos = (pos + 1) & rb_mask;
+		}
+	} else {
+		for (int i = 0; i < todo; i++) {
+			p_dest[i] = AudioFrame(rb[(pos << 1) + 0], rb[(pos << 1) + 1]);
+			pos = (pos + 1) & rb_mask;
+		}
+	}
+
+	rb_read_pos = pos;
+
+	return todo;
+}
+
 int AudioRBResampler::get_num_of_ready_frames() {
 	if (!is_ready())
 		return 0;
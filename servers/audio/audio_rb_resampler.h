@@ -169,6 +169,7 @@ public:
 	Error setup(int p_channels, int p_src_mix_rate, int p_target_mix_rate, int p_buffer_msec, int p_minbuff_needed = -1);
 	void clear();
 	bool mix(AudioFrame *p_dest, int p_frames);
+	int read(AudioFrame *p_dest, int p_frames);
 	int get_num_of_ready_frames();
 
 	AudioRBResampler();
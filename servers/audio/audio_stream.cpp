@@ -35,6 +35,13 @@
 
 //////////////////////////////
 
+void AudioStreamPlayback::skip(float p_time) {
+
+	seek(get_playback_position() + p_time);
+}
+
+//////////////////////////////
+
 void AudioStreamPlaybackResampled::_begin_resample() {
 
 	//clear cubic interpolation history
@@ -353,6 +360,11 @@ void AudioStreamPlaybackRandomPitch::seek(float p_time) {
 		playing->seek(p_time);
 	}
 }
+void AudioStreamPlaybackRandomPitch::skip(float p_time) {
+	if (playing.is_valid()) {
+		playing->skip(p_time * pitch_scale);
+	}
+}
 
 void AudioStreamPlaybackRandomPitch::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	if (playing.is_valid()) {
@@ -49,6 +49,7 @@ public:
 
 	virtual float get_playback_position() const = 0;
 	virtual void seek(float p_time) = 0;
+	virtual void skip(float p_time); //advance without mixing, looping or stopping like mix() would
 
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) = 0;
 };
@@ -197,6 +198,7 @@ public:
 
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
+	virtual void skip(float p_time);
 
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames);
 
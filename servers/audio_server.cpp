@@ -34,8 +34,10 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/safe_refcount.h"
 #include "scene/resources/audio_stream_sample.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 
 #ifdef TOOLS_ENABLED
@@ -260,19 +262,7 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 			if (master->channels[k].active) {
 
 				const AudioFrame *buf = master->channels[k].buffer.ptr();
-
-				for (int j = 0; j < to_copy; j++) {
-
-					float l = CLAMP(buf[from + j].l, -1.0, 1.0);
-					int32_t vl = l * ((1 << 20) - 1);
-					int32_t vl2 = (vl < 0 ? -1 : 1) * (ABS(vl) << 11);
-					p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 0] = vl2;
-
-					float r = CLAMP(buf[from + j].r, -1.0, 1.0);
-					int32_t vr = r * ((1 << 20) - 1);
-					int32_t vr2 = (vr < 0 ? -1 : 1) * (ABS(vr) << 11);
-					p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 1] = vr2;
-				}
+				AudioMix::to_int32(&p_buffer[from_buf * (cs * 2) + k * 2], cs * 2, &buf[from], to_copy);
 
 			} else {
 				for (int j = 0; j < to_copy; j++) {
@@ -339,133 +329,244 @@ void AudioServer::_mix_step() {
 		E->get().callback(E->get().userdata);
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
-		Bus *bus = buses[i];
+	mix_solo_mode = solo_mode;
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+	if (mix_workers.size()) {
+		_mix_buses_threaded();
+	} else {
+		for (int i = buses.size() - 1; i >= 0; i--) {
+			//go bus by bus
+			_mix_bus(i, temp_buffer);
+			_send_bus(i);
+		}
+	}
 
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
+int AudioServer::_get_bus_send_index(int p_bus) const {
 
-					buf[j] = AudioFrame(0, 0);
-				}
-			}
+	if (p_bus == 0)
+		return -1; //everything has a send save for master bus
+
+	const Bus *bus = buses[p_bus];
+	const Map<StringName, Bus *>::Element *E = bus_map.find(bus->send);
+	if (!E || E->get()->index_cache >= bus->index_cache)
+		return 0; //invalid, send to master
+
+	return E->get()->index_cache;
+}
+
+void AudioServer::_mix_bus(int p_bus, Vector<Vector<AudioFrame> > &p_temp_buffer) {
+
+	Bus *bus = buses[p_bus];
+
+	for (int k = 0; k < bus->channels.size(); k++) {
+
+		if (bus->channels[k].active && !bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioMix::clear(bus->channels.write[k].buffer.ptrw(), buffer_size);
 		}
+	}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
+	//process effects
+	if (!bus->bypass) {
+		for (int j = 0; j < bus->effects.size(); j++) {
 
-				if (!bus->effects[j].enabled)
-					continue;
+			if (!bus->effects[j].enabled)
+				continue;
 
 #ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-				for (int k = 0; k < bus->channels.size(); k++) {
+			for (int k = 0; k < bus->channels.size(); k++) {
 
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
-				}
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), p_temp_buffer.write[k].ptrw(), buffer_size);
+			}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
+			//swap buffers, so internal buffer always has the right data
+			for (int k = 0; k < bus->channels.size(); k++) {
 
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
-				}
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				SWAP(bus->channels.write[k].buffer, p_temp_buffer.write[k]);
+			}
 
 #ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+			bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
 #endif
+		}
+	}
+
+	for (int k = 0; k < bus->channels.size(); k++) {
+
+		if (!bus->channels[k].active)
+			continue;
+
+		float volume = Math::db2linear(bus->volume_db);
+
+		if (mix_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (bus->mute) {
+				volume = 0.0;
 			}
 		}
 
-		//process send
+		//apply volume and compute peak
+		AudioFrame peak = AudioMix::scale_peak(bus->channels.write[k].buffer.ptrw(), buffer_size, volume);
 
-		Bus *send = NULL;
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false; //went inactive, don't mix.
 			}
 		}
+	}
+}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+void AudioServer::_send_bus(int p_bus) {
 
-			if (!bus->channels[k].active)
-				continue;
+	int send = _get_bus_send_index(p_bus);
+	if (send < 0)
+		return;
+
+	Bus *bus = buses[p_bus];
+	for (int k = 0; k < bus->channels.size(); k++) {
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+		if (!bus->channels[k].active)
+			continue;
 
-			AudioFrame peak = AudioFrame(0, 0);
+		AudioFrame *target_buf = thread_get_channel_mix_buffer(send, k);
+		AudioMix::add(target_buf, bus->channels[k].buffer.ptr(), buffer_size);
+	}
+}
 
-			float volume = Math::db2linear(bus->volume_db);
+void AudioServer::_mix_wave_work(Vector<Vector<AudioFrame> > &p_temp_buffer) {
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
-			}
+	while (true) {
+		uint32_t index = atomic_increment(&mix_wave_next) - 1;
+		if (index >= mix_wave_end)
+			break;
+		_mix_bus(mix_wave[index], p_temp_buffer);
+	}
+}
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
+void AudioServer::_mix_worker_func(void *p_userdata) {
 
-				buf[j] *= volume;
+	MixWorker *worker = (MixWorker *)p_userdata;
+	AudioServer *server = singleton;
 
-				float l = ABS(buf[j].l);
-				if (l > peak.l) {
-					peak.l = l;
-				}
-				float r = ABS(buf[j].r);
-				if (r > peak.r) {
-					peak.r = r;
-				}
-			}
+	while (true) {
+		worker->start->wait();
+		if (server->mix_workers_exit)
+			break;
+		server->_mix_wave_work(worker->temp_buffer);
+		server->mix_done->post();
+	}
+}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
+void AudioServer::_mix_buses_threaded() {
+
+	// A bus can be processed once every bus sending to it has been sent.
+	mix_pending_inputs.resize(buses.size());
+	for (int i = 0; i < buses.size(); i++) {
+		mix_pending_inputs.write[i] = 0;
+	}
+	for (int i = 1; i < buses.size(); i++) {
+		mix_pending_inputs.write[_get_bus_send_index(i)]++;
+	}
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+	// Every bus goes through mix_wave once, wave after wave.
+	mix_wave.resize(buses.size());
+	int queued = 0;
+	for (int i = buses.size() - 1; i >= 0; i--) {
+		if (mix_pending_inputs[i] == 0) {
+			mix_wave.write[queued++] = i;
+		}
+	}
 
-				if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
-			}
+	int begin = 0;
+	while (begin < queued) {
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+		int end = queued;
+		mix_wave_next = begin;
+		mix_wave_end = end;
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+		int helpers = MIN(mix_workers.size(), end - begin - 1);
+		for (int i = 0; i < helpers; i++) {
+			mix_workers[i]->start->post();
+		}
+		_mix_wave_work(temp_buffer);
+		for (int i = 0; i < helpers; i++) {
+			mix_done->wait();
+		}
+
+		// Sends add to shared buffers, so they are done on this thread.
+		for (int i = begin; i < end; i++) {
+			_send_bus(mix_wave[i]);
+			int send = _get_bus_send_index(mix_wave[i]);
+			if (send >= 0 && --mix_pending_inputs.write[send] == 0) {
+				mix_wave.write[queued++] = send;
 			}
 		}
+		begin = end;
 	}
+}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+void AudioServer::set_mix_thread_count(int p_count) {
+
+	ERR_FAIL_COND(p_count < 0);
+
+	if (mix_workers.size()) {
+		mix_workers_exit = true;
+		for (int i = 0; i < mix_workers.size(); i++) {
+			mix_workers[i]->start->post();
+		}
+		for (int i = 0; i < mix_workers.size(); i++) {
+			Thread::wait_to_finish(mix_workers[i]->thread);
+			memdelete(mix_workers[i]->thread);
+			memdelete(mix_workers[i]->start);
+			memdelete(mix_workers[i]);
+		}
+		mix_workers.clear();
+		memdelete(mix_done);
+		mix_done = NULL;
+		mix_workers_exit = false;
+	}
+
+	if (p_count == 0)
+		return;
+
+	mix_done = Semaphore::create();
+	ERR_FAIL_COND_MSG(!mix_done, "Threads are not supported on this platform, buses are mixed on the audio thread.");
+
+	for (int i = 0; i < p_count; i++) {
+		MixWorker *worker = memnew(MixWorker);
+		worker->start = Semaphore::create();
+		worker->temp_buffer.resize(channel_count);
+		for (int j = 0; j < channel_count; j++) {
+			worker->temp_buffer.write[j].resize(buffer_size);
+		}
+		worker->thread = Thread::create(_mix_worker_func, worker);
+		mix_workers.push_back(worker);
+	}
+}
+
+int AudioServer::get_mix_thread_count() const {
+
+	return mix_workers.size();
 }
 
 bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
@@ -962,6 +1063,14 @@ void AudioServer::init_channels_and_buffers() {
 		temp_buffer.write[i].resize(buffer_size);
 	}
 
+	for (int i = 0; i < mix_workers.size(); i++) {
+		Vector<Vector<AudioFrame> > &worker_buffer = mix_workers[i]->temp_buffer;
+		worker_buffer.resize(channel_count);
+		for (int j = 0; j < channel_count; j++) {
+			worker_buffer.write[j].resize(buffer_size);
+		}
+	}
+
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
@@ -983,6 +1092,14 @@ void AudioServer::init() {
 	set_bus_count(1);
 	set_bus_name(0, "Master");
 
+	GLOBAL_DEF("audio/max_3d_voices", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/max_3d_voices", PropertyInfo(Variant::INT, "audio/max_3d_voices", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
+	GLOBAL_DEF("audio/virtual_voice_threshold_db", -80.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/virtual_voice_threshold_db", PropertyInfo(Variant::REAL, "audio/virtual_voice_threshold_db", PROPERTY_HINT_RANGE, "-120,0,0.1"));
+
+	set_mix_thread_count(GLOBAL_DEF_RST("audio/mix_threads", 0));
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/mix_threads", PropertyInfo(Variant::INT, "audio/mix_threads", PROPERTY_HINT_RANGE, "0,16,1"));
+
 	if (AudioDriver::get_singleton())
 		AudioDriver::get_singleton()->start();
 
@@ -1078,6 +1195,8 @@ void AudioServer::finish() {
 		AudioDriverManager::get_driver(i)->finish();
 	}
 
+	set_mix_thread_count(0);
+
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1412,6 +1531,11 @@ AudioServer::AudioServer() {
 	mix_time = 0;
 	mix_size = 0;
 	global_rate_scale = 1;
+	mix_done = NULL;
+	mix_wave_next = 0;
+	mix_wave_end = 0;
+	mix_workers_exit = false;
+	mix_solo_mode = false;
 }
 
 AudioServer::~AudioServer() {
@@ -34,6 +34,8 @@
 #include "core/math/audio_frame.h"
 #include "core/object.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/variant.h"
 #include "servers/audio/audio_effect.h"
 
@@ -242,6 +244,32 @@ private:
 
 	void init_channels_and_buffers();
 
+	// Buses whose inputs are all mixed are independent of each other, so
+	// their effects and volume can be processed on several threads. Each
+	// wave of such buses is split between the mix workers and the audio
+	// thread, then sent to their targets on the audio thread.
+	struct MixWorker {
+		Thread *thread;
+		Semaphore *start;
+		Vector<Vector<AudioFrame> > temp_buffer;
+	};
+
+	Vector<MixWorker *> mix_workers;
+	Semaphore *mix_done;
+	Vector<int> mix_wave;
+	Vector<int> mix_pending_inputs;
+	volatile uint32_t mix_wave_next;
+	uint32_t mix_wave_end;
+	volatile bool mix_workers_exit;
+	bool mix_solo_mode;
+
+	static void _mix_worker_func(void *p_userdata);
+	void _mix_wave_work(Vector<Vector<AudioFrame> > &p_temp_buffer);
+	void _mix_buses_threaded();
+
+	int _get_bus_send_index(int p_bus) const;
+	void _mix_bus(int p_bus, Vector<Vector<AudioFrame> > &p_temp_buffer);
+	void _send_bus(int p_bus);
 	void _mix_step();
 
 	struct CallbackItem {
@@ -329,6 +357,9 @@ public:
 	void set_global_rate_scale(float p_scale);
 	float get_global_rate_scale() const;
 
+	void set_mix_thread_count(int p_count); // Call with the server locked
+	int get_mix_thread_count() const;
+
 	virtual void init();
 	virtual void finish();
 	virtual void update();
@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "visual_server_canvas.h"
+#include "core/project_settings.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 #include "visual_server_viewport.h"
@@ -37,18 +38,55 @@ static const int z_range = VS::CANVAS_ITEM_Z_MAX - VS::CANVAS_ITEM_Z_MIN + 1;
 
 void VisualServerCanvas::_render_canvas_item_tree(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights) {
 
-	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
-	memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
-
 	_render_canvas_item(p_canvas_item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, NULL, NULL);
 
 	VSG::canvas_render->canvas_render_items_begin(p_modulate, p_lights, p_transform);
-	for (int i = 0; i < z_range; i++) {
+	for (int i = z_list_min; i <= z_list_max; i++) {
 		if (!z_list[i])
 			continue;
 		VSG::canvas_render->canvas_render_items(z_list[i], VS::CANVAS_ITEM_Z_MIN + i, p_modulate, p_lights, p_transform);
 	}
 	VSG::canvas_render->canvas_render_items_end();
+
+	_clear_z_lists();
+}
+
+void VisualServerCanvas::_clear_z_lists() {
+
+	// Only the buckets that were used need resetting, most scenes use a handful of z indices.
+	if (z_list_min <= z_list_max) {
+		int count = z_list_max - z_list_min + 1;
+		memset(&z_list[z_list_min], 0, count * sizeof(RasterizerCanvas::Item *));
+		memset(&z_last_list[z_list_min], 0, count * sizeof(RasterizerCanvas::Item *));
+	}
+
+	z_list_min = z_range;
+	z_list_max = -1;
+}
+
+static bool _ysort_insertion_sort(VisualServerCanvas::Item **p_items, int p_count, int p_max_moves) {
+
+	// Cheap on the previous frame's order, where most items are already in
+	// place. Gives up once too many shifts are needed, leaving a valid permutation.
+	VisualServerCanvas::ItemPtrSort compare;
+	int moves = 0;
+
+	for (int i = 1; i < p_count; i++) {
+
+		VisualServerCanvas::Item *item = p_items[i];
+		int j = i;
+		while (j > 0 && compare(item, p_items[j - 1])) {
+			p_items[j] = p_items[j - 1];
+			j--;
+			if (++moves > p_max_moves) {
+				p_items[j] = item;
+				return false;
+			}
+		}
+		p_items[j] = item;
+	}
+
+	return true;
 }
 
 void _collect_ysort_children(VisualServerCanvas::Item *p_canvas_item, Transform2D p_transform, VisualServerCanvas::Item *p_material_owner, const Color p_modulate, VisualServerCanvas::Item **r_items, int &r_index) {
@@ -83,6 +121,308 @@ void _mark_ysort_dirty(VisualServerCanvas::Item *ysort_owner, RID_Owner<VisualSe
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+VisualServerCanvas::Item *VisualServerCanvas::_get_parent_item(Item *p_item) {
+
+	return canvas_item_owner.owns(p_item->parent) ? canvas_item_owner.getornull(p_item->parent) : NULL;
+}
+
+void VisualServerCanvas::_mark_item_rect_dirty(Item *p_item) {
+
+	// If an item is already dirty, so are its ancestors.
+	while (p_item && !p_item->subtree_rect_dirty) {
+
+		p_item->subtree_rect_dirty = true;
+
+		Item *parent = _get_parent_item(p_item);
+		if (parent && parent->child_grid && !p_item->grid_dirty) {
+			p_item->grid_dirty = true;
+			parent->child_grid->dirty.push_back(p_item);
+		}
+		p_item = parent;
+	}
+}
+
+void VisualServerCanvas::_item_bounds_changed(Item *p_item) {
+
+	// The item moved or changed visibility, which only affects its parent.
+	Item *parent = _get_parent_item(p_item);
+	if (!parent) {
+		return;
+	}
+
+	if (parent->child_grid && !p_item->grid_dirty) {
+		p_item->grid_dirty = true;
+		parent->child_grid->dirty.push_back(p_item);
+	}
+	_mark_item_rect_dirty(parent);
+}
+
+static _FORCE_INLINE_ uint64_t _child_grid_key(int p_x, int p_y) {
+
+	return (uint64_t(uint32_t(p_x)) << 32) | uint64_t(uint32_t(p_y));
+}
+
+static void _child_grid_gather(VisualServerCanvas::ChildGrid *p_grid, const Vector<VisualServerCanvas::Item *> &p_cell, uint32_t p_pass) {
+
+	// Children spanning several cells are only added once per query.
+	int needed = p_grid->found_count + p_cell.size();
+	if (needed > p_grid->found.size()) {
+		p_grid->found.resize(next_power_of_2(needed));
+	}
+
+	VisualServerCanvas::Item **found = p_grid->found.ptrw();
+	for (int i = 0; i < p_cell.size(); i++) {
+		VisualServerCanvas::Item *child = p_cell[i];
+		if (child->grid_pass != p_pass) {
+			child->grid_pass = p_pass;
+			found[p_grid->found_count++] = child;
+		}
+	}
+}
+
+void VisualServerCanvas::_child_grid_insert(ChildGrid *p_grid, Item *p_child) {
+
+	if (!p_child->visible || (p_child->subtree_cullable && p_child->subtree_rect_empty)) {
+		return; // Nothing to draw, it will be notified again when that changes.
+	}
+
+	p_child->in_grid = true;
+
+	if (!p_child->subtree_cullable) {
+		p_child->grid_always = true;
+		p_grid->always.push_back(p_child);
+		return;
+	}
+
+	Rect2 r = p_child->xform.xform(p_child->subtree_rect);
+	if (p_grid->bounds_empty) {
+		p_grid->bounds = r;
+		p_grid->bounds_empty = false;
+	} else {
+		p_grid->bounds = p_grid->bounds.merge(r);
+	}
+
+	double from_x = Math::floor(r.position.x / item_culling_cell_size);
+	double from_y = Math::floor(r.position.y / item_culling_cell_size);
+	double to_x = Math::floor((r.position.x + r.size.x) / item_culling_cell_size);
+	double to_y = Math::floor((r.position.y + r.size.y) / item_culling_cell_size);
+
+	if ((to_x - from_x + 1) * (to_y - from_y + 1) > CHILD_GRID_MAX_ITEM_CELLS) {
+		p_child->grid_always = true;
+		p_grid->always.push_back(p_child);
+		return;
+	}
+
+	p_child->grid_always = false;
+	p_child->grid_from_x = from_x;
+	p_child->grid_from_y = from_y;
+	p_child->grid_to_x = to_x;
+	p_child->grid_to_y = to_y;
+
+	for (int i = p_child->grid_from_x; i <= p_child->grid_to_x; i++) {
+		for (int j = p_child->grid_from_y; j <= p_child->grid_to_y; j++) {
+
+			uint64_t key = _child_grid_key(i, j);
+			Vector<Item *> *cell = p_grid->cells.getptr(key);
+			if (!cell) {
+				p_grid->cells[key] = Vector<Item *>();
+				cell = p_grid->cells.getptr(key);
+			}
+			cell->push_back(p_child);
+		}
+	}
+}
+
+void VisualServerCanvas::_child_grid_remove(ChildGrid *p_grid, Item *p_child) {
+
+	if (!p_child->in_grid) {
+		return;
+	}
+	p_child->in_grid = false;
+
+	if (p_child->grid_always) {
+		p_grid->always.erase(p_child);
+		return;
+	}
+
+	for (int i = p_child->grid_from_x; i <= p_child->grid_to_x; i++) {
+		for (int j = p_child->grid_from_y; j <= p_child->grid_to_y; j++) {
+
+			uint64_t key = _child_grid_key(i, j);
+			Vector<Item *> *cell = p_grid->cells.getptr(key);
+			ERR_CONTINUE(!cell);
+			cell->erase(p_child);
+			if (cell->empty()) {
+				p_grid->cells.erase(key);
+			}
+		}
+	}
+}
+
+void VisualServerCanvas::_child_grid_rebuild(Item *p_item) {
+
+	ChildGrid *grid = p_item->child_grid;
+	grid->cells.clear();
+	grid->always.clear();
+	grid->dirty.clear();
+	grid->bounds_empty = true;
+
+	for (int i = 0; i < p_item->child_items.size(); i++) {
+
+		Item *child = p_item->child_items[i];
+		child->in_grid = false;
+		child->grid_dirty = false;
+		_update_item_subtree_rect(child);
+		_child_grid_insert(grid, child);
+	}
+}
+
+void VisualServerCanvas::_child_grid_free(Item *p_item) {
+
+	if (!p_item->child_grid) {
+		return;
+	}
+
+	for (int i = 0; i < p_item->child_items.size(); i++) {
+		p_item->child_items[i]->in_grid = false;
+		p_item->child_items[i]->grid_dirty = false;
+	}
+
+	memdelete(p_item->child_grid);
+	p_item->child_grid = NULL;
+}
+
+void VisualServerCanvas::_child_grid_detach(Item *p_parent, Item *p_child) {
+
+	ChildGrid *grid = p_parent->child_grid;
+	if (grid) {
+		_child_grid_remove(grid, p_child);
+		if (p_child->grid_dirty) {
+			grid->dirty.erase(p_child);
+			p_child->grid_dirty = false;
+		}
+	}
+	_mark_item_rect_dirty(p_parent);
+}
+
+void VisualServerCanvas::_update_item_subtree_rect(Item *p_item) {
+
+	if (!p_item->subtree_rect_dirty) {
+		return;
+	}
+	p_item->subtree_rect_dirty = false;
+
+	bool cullable = !p_item->update_when_visible && !p_item->copy_back_buffer && !p_item->vp_render && !p_item->external_rect;
+	bool empty = p_item->commands.empty();
+	Rect2 rect = empty ? Rect2() : p_item->get_rect();
+
+	bool use_grid = use_item_culling && !p_item->sort_y && p_item->child_items.size() >= CHILD_GRID_MIN_CHILDREN;
+
+	if (use_grid) {
+
+		ChildGrid *grid = p_item->child_grid;
+		if (!grid || grid->dirty.size() * 2 > p_item->child_items.size()) {
+			// A full rebuild also shrinks the bounds back to the children.
+			if (!grid) {
+				p_item->child_grid = memnew(ChildGrid);
+				grid = p_item->child_grid;
+			}
+			_child_grid_rebuild(p_item);
+		} else {
+			for (int i = 0; i < grid->dirty.size(); i++) {
+
+				Item *child = grid->dirty[i];
+				child->grid_dirty = false;
+				_update_item_subtree_rect(child);
+				_child_grid_remove(grid, child);
+				_child_grid_insert(grid, child);
+			}
+			grid->dirty.clear();
+		}
+
+		for (int i = 0; i < grid->always.size(); i++) {
+			cullable = cullable && grid->always[i]->subtree_cullable;
+		}
+
+		if (!grid->bounds_empty) {
+			rect = empty ? grid->bounds : rect.merge(grid->bounds);
+			empty = false;
+		}
+
+	} else {
+
+		_child_grid_free(p_item);
+
+		for (int i = 0; i < p_item->child_items.size(); i++) {
+
+			Item *child = p_item->child_items[i];
+			if (!child->visible) {
+				continue;
+			}
+
+			_update_item_subtree_rect(child);
+			cullable = cullable && child->subtree_cullable;
+
+			if (child->subtree_rect_empty) {
+				continue;
+			}
+
+			Rect2 r = child->xform.xform(child->subtree_rect);
+			rect = empty ? r : rect.merge(r);
+			empty = false;
+		}
+	}
+
+	p_item->subtree_rect = rect;
+	p_item->subtree_rect_empty = empty;
+	p_item->subtree_cullable = cullable;
+}
+
+int VisualServerCanvas::_child_grid_cull(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect) {
+
+	ChildGrid *grid = p_item->child_grid;
+	grid->found_count = 0;
+
+	// Same test as in _render_canvas_item(), done in the item's local space.
+	Rect2 local_rect = p_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size));
+
+	double from_x = Math::floor(local_rect.position.x / item_culling_cell_size);
+	double from_y = Math::floor(local_rect.position.y / item_culling_cell_size);
+	double to_x = Math::floor((local_rect.position.x + local_rect.size.x) / item_culling_cell_size);
+	double to_y = Math::floor((local_rect.position.y + local_rect.size.y) / item_culling_cell_size);
+
+	grid_pass++;
+
+	if ((to_x - from_x + 1) * (to_y - from_y + 1) > grid->cells.size()) {
+		// Zoomed out over most of the grid, walk the used cells instead.
+		const uint64_t *key = NULL;
+		while ((key = grid->cells.next(key))) {
+			int x = int32_t(*key >> 32);
+			int y = int32_t(*key & 0xFFFFFFFF);
+			if (x < from_x || x > to_x || y < from_y || y > to_y) {
+				continue;
+			}
+			_child_grid_gather(grid, grid->cells[*key], grid_pass);
+		}
+	} else {
+		for (int i = from_x; i <= to_x; i++) {
+			for (int j = from_y; j <= to_y; j++) {
+				const Vector<Item *> *cell = grid->cells.getptr(_child_grid_key(i, j));
+				if (cell) {
+					_child_grid_gather(grid, *cell, grid_pass);
+				}
+			}
+		}
+	}
+
+	_child_grid_gather(grid, grid->always, grid_pass);
+
+	SortArray<Item *, ItemIndexSort> sorter;
+	sorter.sort(grid->found.ptrw(), grid->found_count);
+
+	return grid->found_count;
+}
+
 void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
 
 	Item *ci = p_canvas_item;
@@ -90,6 +430,22 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 	if (!ci->visible)
 		return;
 
+	if (use_item_culling) {
+
+		_update_item_subtree_rect(ci);
+
+		// Skip the whole subtree when none of it can be drawn.
+		if (ci->subtree_cullable) {
+			if (ci->subtree_rect_empty)
+				return;
+
+			Rect2 subtree_rect = (p_transform * ci->xform).xform(ci->subtree_rect);
+			subtree_rect.position += p_clip_rect.position;
+			if (!p_clip_rect.intersects(subtree_rect, true))
+				return;
+		}
+	}
+
 	if (ci->children_order_dirty) {
 
 		ci->child_items.sort_custom<ItemIndexSort>();
@@ -116,6 +472,11 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 	int child_item_count = ci->child_items.size();
 	Item **child_items = ci->child_items.ptrw();
 
+	if (ci->child_grid && !ci->sort_y && xform.basis_determinant() != 0) {
+		child_item_count = _child_grid_cull(ci, xform, p_clip_rect);
+		child_items = ci->child_grid->found.ptrw();
+	}
+
 	if (ci->clip) {
 		if (p_canvas_clip != NULL) {
 			ci->final_clip_rect = p_canvas_clip->final_clip_rect.clip(global_rect);
@@ -133,6 +494,7 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 		if (ci->ysort_children_count == -1) {
 			ci->ysort_children_count = 0;
 			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), NULL, ci->ysort_children_count);
+			ci->ysort_order.clear();
 		}
 
 		child_item_count = ci->ysort_children_count;
@@ -141,8 +503,21 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 		int i = 0;
 		_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i);
 
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+		if (ci->ysort_order.size() != child_item_count) {
+			// Children changed, sort from scratch.
+			ci->ysort_order.resize(child_item_count);
+			copymem(ci->ysort_order.ptrw(), child_items, child_item_count * sizeof(Item *));
+
+			SortArray<Item *, ItemPtrSort> sorter;
+			sorter.sort(ci->ysort_order.ptrw(), child_item_count);
+
+		} else if (!_ysort_insertion_sort(ci->ysort_order.ptrw(), child_item_count, child_item_count * 4)) {
+
+			SortArray<Item *, ItemPtrSort> sorter;
+			sorter.sort(ci->ysort_order.ptrw(), child_item_count);
+		}
+
+		child_items = ci->ysort_order.ptrw();
 	}
 
 	if (ci->z_relative)
@@ -180,6 +555,9 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 
 		int zidx = p_z - VS::CANVAS_ITEM_Z_MIN;
 
+		z_list_min = MIN(z_list_min, zidx);
+		z_list_max = MAX(z_list_max, zidx);
+
 		if (z_last_list[zidx]) {
 			z_last_list[zidx]->next = ci;
 			z_last_list[zidx] = ci;
@@ -247,19 +625,12 @@ void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_tr
 
 	if (!has_mirror) {
 
-		static const int z_range = VS::CANVAS_ITEM_Z_MAX - VS::CANVAS_ITEM_Z_MIN + 1;
-		RasterizerCanvas::Item *z_list[z_range];
-		RasterizerCanvas::Item *z_last_list[z_range];
-
-		memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
-		memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
-
 		for (int i = 0; i < l; i++) {
 			_render_canvas_item(ci[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, NULL, NULL);
 		}
 
 		VSG::canvas_render->canvas_render_items_begin(p_canvas->modulate, p_lights, p_transform);
-		for (int i = 0; i < z_range; i++) {
+		for (int i = z_list_min; i <= z_list_max; i++) {
 			if (!z_list[i])
 				continue;
 
@@ -270,6 +641,8 @@ void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_tr
 			VSG::canvas_render->canvas_render_items(z_list[i], VS::CANVAS_ITEM_Z_MIN + i, p_canvas->modulate, p_lights, p_transform);
 		}
 		VSG::canvas_render->canvas_render_items_end();
+
+		_clear_z_lists();
 	} else {
 
 		for (int i = 0; i < l; i++) {
@@ -362,6 +735,7 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 
 			Item *item_owner = canvas_item_owner.get(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_child_grid_detach(item_owner, canvas_item);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -396,6 +770,8 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 	}
 
 	canvas_item->parent = p_parent;
+
+	_item_bounds_changed(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible) {
 
@@ -405,6 +781,7 @@ void VisualServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible) {
 	canvas_item->visible = p_visible;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_item_bounds_changed(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_light_mask(RID p_item, int p_mask) {
 
@@ -420,6 +797,8 @@ void VisualServerCanvas::canvas_item_set_transform(RID p_item, const Transform2D
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+
+	_item_bounds_changed(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_clip(RID p_item, bool p_clip) {
 
@@ -442,6 +821,9 @@ void VisualServerCanvas::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	canvas_item->rect_dirty = true;
+
+	_mark_item_rect_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_modulate(RID p_item, const Color &p_color) {
 
@@ -472,6 +854,8 @@ void VisualServerCanvas::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -489,6 +873,7 @@ void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(line);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width, bool p_antialiased) {
@@ -574,6 +959,7 @@ void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point
 	}
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(pline);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, float p_width, bool p_antialiased) {
@@ -598,6 +984,7 @@ void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Poin
 
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(pline);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
@@ -612,6 +999,7 @@ void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(rect);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
@@ -626,6 +1014,7 @@ void VisualServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	circle->radius = p_radius;
 
 	canvas_item->commands.push_back(circle);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose, RID p_normal_map) {
@@ -662,6 +1051,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	rect->normal_map = p_normal_map;
 	canvas_item->rect_dirty = true;
 	canvas_item->commands.push_back(rect);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, RID p_normal_map, bool p_clip_uv) {
@@ -711,6 +1101,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const R
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(rect);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, VS::NinePatchAxisMode p_x_axis_mode, VS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate, RID p_normal_map) {
@@ -735,6 +1126,7 @@ void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(style);
+	_mark_item_rect_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, float p_width, RID p_normal_map) {
 
@@ -752,6 +1144,7 @@ void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(prim);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, RID p_normal_map, bool p_antialiased) {
@@ -783,6 +1176,7 @@ void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(polygon);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count, RID p_normal_map, bool p_antialiased, bool p_antialiasing_use_indices) {
@@ -829,6 +1223,7 @@ void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector
 	canvas_item->rect_dirty = true;
 
 	canvas_item->commands.push_back(polygon);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
@@ -841,6 +1236,7 @@ void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transfo
 	tr->xform = p_transform;
 
 	canvas_item->commands.push_back(tr);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture, RID p_normal_map) {
@@ -856,7 +1252,9 @@ void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 	m->transform = p_transform;
 	m->modulate = p_modulate;
 
+	canvas_item->external_rect = true;
 	canvas_item->commands.push_back(m);
+	_mark_item_rect_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture, RID p_normal) {
 
@@ -873,7 +1271,9 @@ void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles,
 	VSG::storage->particles_request_process(p_particles);
 
 	canvas_item->rect_dirty = true;
+	canvas_item->external_rect = true;
 	canvas_item->commands.push_back(part);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture, RID p_normal_map) {
@@ -888,7 +1288,9 @@ void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	mm->normal_map = p_normal_map;
 
 	canvas_item->rect_dirty = true;
+	canvas_item->external_rect = true;
 	canvas_item->commands.push_back(mm);
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
@@ -910,6 +1312,7 @@ void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	canvas_item->sort_y = p_enable;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_mark_item_rect_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_z_index(RID p_item, int p_z) {
 
@@ -953,6 +1356,8 @@ void VisualServerCanvas::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	_mark_item_rect_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_clear(RID p_item) {
@@ -961,6 +1366,9 @@ void VisualServerCanvas::canvas_item_clear(RID p_item) {
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->clear();
+	canvas_item->external_rect = false;
+
+	_mark_item_rect_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_draw_index(RID p_item, int p_index) {
 
@@ -1386,6 +1794,7 @@ bool VisualServerCanvas::free(RID p_rid) {
 
 				Item *item_owner = canvas_item_owner.get(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_child_grid_detach(item_owner, canvas_item);
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -1393,6 +1802,8 @@ bool VisualServerCanvas::free(RID p_rid) {
 			}
 		}
 
+		_child_grid_free(canvas_item);
+
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 
 			canvas_item->child_items[i]->parent = RID();
@@ -1474,8 +1885,18 @@ VisualServerCanvas::VisualServerCanvas() {
 
 	z_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
 	z_last_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
+	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+	memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+	z_list_min = z_range;
+	z_list_max = -1;
 
 	disable_scale = false;
+
+	use_item_culling = GLOBAL_DEF("rendering/quality/2d/use_item_culling_index", true);
+	item_culling_cell_size = GLOBAL_DEF("rendering/quality/2d/item_culling_cell_size", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/2d/item_culling_cell_size", PropertyInfo(Variant::INT, "rendering/quality/2d/item_culling_cell_size", PROPERTY_HINT_RANGE, "16,4096,1,or_greater"));
+	item_culling_cell_size = MAX(1.0f, item_culling_cell_size);
+	grid_pass = 0;
 }
 
 VisualServerCanvas::~VisualServerCanvas() {
@@ -36,6 +36,8 @@
 
 class VisualServerCanvas {
 public:
+	struct ChildGrid;
+
 	struct Item : public RasterizerCanvas::Item {
 
 		RID parent; // canvas it belongs to
@@ -52,9 +54,28 @@ public:
 		Color ysort_modulate;
 		Transform2D ysort_xform;
 		Vector2 ysort_pos;
+		Vector<Item *> ysort_order; // Last frame's sorted children, reused while they stay the same.
 
 		Vector<Item *> child_items;
 
+		// Bounds of this item and its visible descendants, in the item's own
+		// space. Refreshed lazily on render, after being marked dirty.
+		Rect2 subtree_rect;
+		bool subtree_rect_dirty;
+		bool subtree_rect_empty;
+		bool subtree_cullable;
+		bool external_rect; // Rect depends on meshes, multimeshes or particles.
+
+		// Grid of child bounds, only built for items with many children.
+		ChildGrid *child_grid;
+
+		// Membership in the parent's grid.
+		bool in_grid;
+		bool grid_always;
+		bool grid_dirty;
+		int grid_from_x, grid_from_y, grid_to_x, grid_to_y;
+		uint32_t grid_pass;
+
 		Item() {
 			children_order_dirty = true;
 			E = NULL;
@@ -68,6 +89,34 @@ public:
 			ysort_children_count = -1;
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
+			subtree_rect_dirty = true;
+			subtree_rect_empty = true;
+			subtree_cullable = true;
+			external_rect = false;
+			child_grid = NULL;
+			in_grid = false;
+			grid_always = false;
+			grid_dirty = false;
+			grid_from_x = grid_from_y = grid_to_x = grid_to_y = 0;
+			grid_pass = 0;
+		}
+	};
+
+	struct ChildGrid {
+
+		HashMap<uint64_t, Vector<Item *> > cells;
+		Vector<Item *> always; // Never culled, or too large for the grid.
+		Vector<Item *> dirty;
+		Rect2 bounds;
+		bool bounds_empty;
+
+		// Scratch list of children found by the last query.
+		Vector<Item *> found;
+		int found_count;
+
+		ChildGrid() {
+			bounds_empty = true;
+			found_count = 0;
 		}
 	};
 
@@ -157,12 +206,37 @@ public:
 	bool disable_scale;
 
 private:
+	enum {
+		CHILD_GRID_MIN_CHILDREN = 64,
+		CHILD_GRID_MAX_ITEM_CELLS = 16,
+	};
+
+	bool use_item_culling;
+	float item_culling_cell_size;
+	uint32_t grid_pass;
+
+	Item *_get_parent_item(Item *p_item);
+	void _mark_item_rect_dirty(Item *p_item);
+	void _item_bounds_changed(Item *p_item);
+	void _update_item_subtree_rect(Item *p_item);
+
+	void _child_grid_insert(ChildGrid *p_grid, Item *p_child);
+	void _child_grid_remove(ChildGrid *p_grid, Item *p_child);
+	void _child_grid_rebuild(Item *p_item);
+	void _child_grid_free(Item *p_item);
+	void _child_grid_detach(Item *p_parent, Item *p_child);
+	int _child_grid_cull(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect);
+
 	void _render_canvas_item_tree(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights);
 	void _render_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
 	void _light_mask_canvas_items(int p_z, RasterizerCanvas::Item *p_canvas_item, RasterizerCanvas::Light *p_masked_lights, int p_canvas_layer_id);
 
 	RasterizerCanvas::Item **z_list;
 	RasterizerCanvas::Item **z_last_list;
+	int z_list_min;
+	int z_list_max;
+
+	void _clear_z_lists();
 
 public:
 	void render_canvas(Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect, int p_canvas_layer_id);
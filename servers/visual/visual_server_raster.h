@@ -222,6 +222,7 @@ public:
 	BIND1RC(BlendShapeMode, mesh_get_blend_shape_mode, RID)
 
 	BIND4(mesh_surface_update_region, RID, int, int, const PoolVector<uint8_t> &)
+	BIND4(mesh_surface_update_index_region, RID, int, int, const PoolVector<uint8_t> &)
 
 	BIND3(mesh_surface_set_material, RID, int, RID)
 	BIND2RC(RID, mesh_surface_get_material, RID, int)
@@ -295,6 +296,7 @@ public:
 	BIND1RC(int, skeleton_get_bone_count, RID)
 	BIND3(skeleton_bone_set_transform, RID, int, const Transform &)
 	BIND2RC(Transform, skeleton_bone_get_transform, RID, int)
+	BIND2(skeleton_set_as_bulk_array, RID, const PoolVector<float> &)
 	BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
 	BIND2(skeleton_set_base_transform_2d, RID, const Transform2D &)
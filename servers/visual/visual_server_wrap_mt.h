@@ -158,6 +158,7 @@ public:
 	FUNC1RC(BlendShapeMode, mesh_get_blend_shape_mode, RID)
 
 	FUNC4(mesh_surface_update_region, RID, int, int, const PoolVector<uint8_t> &)
+	FUNC4(mesh_surface_update_index_region, RID, int, int, const PoolVector<uint8_t> &)
 
 	FUNC3(mesh_surface_set_material, RID, int, RID)
 	FUNC2RC(RID, mesh_surface_get_material, RID, int)
@@ -231,6 +232,7 @@ public:
 	FUNC1RC(int, skeleton_get_bone_count, RID)
 	FUNC3(skeleton_bone_set_transform, RID, int, const Transform &)
 	FUNC2RC(Transform, skeleton_bone_get_transform, RID, int)
+	FUNC2(skeleton_set_as_bulk_array, RID, const PoolVector<float> &)
 	FUNC3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
 	FUNC2(skeleton_set_base_transform_2d, RID, const Transform2D &)
@@ -1165,6 +1165,134 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 	mesh_add_surface(p_mesh, format, p_primitive, vertex_array, array_len, index_array, index_array_len, aabb, blend_shape_data, bone_aabb);
 }
 
+Error VisualServer::mesh_surface_validate_buffers(uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count) const {
+
+	ERR_FAIL_COND_V_MSG(!(p_format & ARRAY_FORMAT_VERTEX), ERR_INVALID_PARAMETER, "Vertex array format must include ARRAY_FORMAT_VERTEX.");
+	ERR_FAIL_COND_V(p_vertex_count <= 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(bool(p_format & ARRAY_FORMAT_INDEX) != (p_index_count > 0), ERR_INVALID_PARAMETER, "ARRAY_FORMAT_INDEX must be set if and only if an index count is given.");
+
+	uint32_t offsets[ARRAY_MAX];
+	int stride = mesh_surface_make_offsets_from_format(p_format, p_vertex_count, p_index_count, offsets);
+
+	ERR_FAIL_COND_V_MSG(p_vertex_array.size() != stride * p_vertex_count, ERR_INVALID_PARAMETER, "Vertex buffer size (" + itos(p_vertex_array.size()) + ") does not match format stride (" + itos(stride) + ") times vertex count (" + itos(p_vertex_count) + ").");
+	if (p_index_count > 0) {
+		ERR_FAIL_COND_V_MSG(p_index_array.size() != (int)offsets[ARRAY_INDEX] * p_index_count, ERR_INVALID_PARAMETER, "Index buffer size (" + itos(p_index_array.size()) + ") does not match index size (" + itos(offsets[ARRAY_INDEX]) + ") times index count (" + itos(p_index_count) + ").");
+	}
+
+	return OK;
+}
+
+AABB VisualServer::mesh_surface_get_buffer_aabb(uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count) const {
+
+	ERR_FAIL_COND_V(!(p_format & ARRAY_FORMAT_VERTEX), AABB());
+
+	uint32_t offsets[ARRAY_MAX];
+	int stride = mesh_surface_make_offsets_from_format(p_format & ~ARRAY_FORMAT_INDEX, p_vertex_count, 0, offsets);
+	ERR_FAIL_COND_V(p_vertex_array.size() < stride * p_vertex_count, AABB());
+
+	bool is_2d = p_format & ARRAY_FLAG_USE_2D_VERTICES;
+	bool compressed = p_format & ARRAY_COMPRESS_VERTEX;
+	const uint8_t *src = p_vertex_array.ptr();
+
+	// Vertex position is always the first attribute.
+	AABB aabb;
+	for (int i = 0; i < p_vertex_count; i++) {
+
+		Vector3 pos;
+		if (compressed) {
+			const uint16_t *v = (const uint16_t *)&src[i * stride];
+			pos = Vector3(Math::half_to_float(v[0]), Math::half_to_float(v[1]), is_2d ? 0 : Math::half_to_float(v[2]));
+		} else {
+			const float *v = (const float *)&src[i * stride];
+			pos = Vector3(v[0], v[1], is_2d ? 0 : v[2]);
+		}
+
+		if (i == 0) {
+			aabb.position = pos;
+		} else {
+			aabb.expand_to(pos);
+		}
+	}
+
+	return aabb;
+}
+
+Error VisualServer::mesh_surface_pack_vertex_arrays(uint32_t p_format, const Array &p_arrays, PoolVector<uint8_t> &r_vertex_array, int &r_vertex_count) {
+
+	ERR_FAIL_COND_V(p_arrays.size() != ARRAY_MAX, ERR_INVALID_PARAMETER);
+
+	// Only vertex attributes are packed, in the exact layout of an existing surface.
+	uint32_t format = p_format & ~ARRAY_FORMAT_INDEX;
+	ERR_FAIL_COND_V(!(format & ARRAY_FORMAT_VERTEX), ERR_INVALID_PARAMETER);
+
+	for (int i = 0; i < ARRAY_INDEX; i++) {
+		ERR_FAIL_COND_V_MSG(bool(format & (1 << i)) != (p_arrays[i].get_type() != Variant::NIL), ERR_INVALID_PARAMETER, "Arrays don't match the surface format.");
+	}
+
+	int vertex_count;
+	if (format & ARRAY_FLAG_USE_2D_VERTICES) {
+		vertex_count = PoolVector<Vector2>(p_arrays[ARRAY_VERTEX]).size();
+	} else {
+		vertex_count = PoolVector<Vector3>(p_arrays[ARRAY_VERTEX]).size();
+	}
+	ERR_FAIL_COND_V(vertex_count == 0, ERR_INVALID_PARAMETER);
+
+	uint32_t offsets[ARRAY_MAX];
+	int stride = mesh_surface_make_offsets_from_format(format, vertex_count, 0, offsets);
+
+	r_vertex_array.resize(stride * vertex_count);
+
+	PoolVector<uint8_t> noindex;
+	AABB aabb;
+	Vector<AABB> bone_aabb;
+	Error err = _surface_set_data(p_arrays, format, offsets, stride, r_vertex_array, vertex_count, noindex, 0, aabb, bone_aabb);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	r_vertex_count = vertex_count;
+	return OK;
+}
+
+Error VisualServer::mesh_surface_pack_index_array(int p_vertex_count, const PoolVector<int> &p_indices, PoolVector<uint8_t> &r_index_array) const {
+
+	// Same rule as _surface_set_data(): 16 bits indices unless there are too many vertices.
+	int index_size = p_vertex_count < (1 << 16) ? 2 : 4;
+	int count = p_indices.size();
+	r_index_array.resize(count * index_size);
+
+	const int *src = p_indices.ptr();
+	uint8_t *dst = r_index_array.ptrw();
+
+	for (int i = 0; i < count; i++) {
+
+		ERR_FAIL_INDEX_V(src[i], p_vertex_count, ERR_INVALID_PARAMETER);
+
+		if (index_size == 2) {
+			uint16_t v = src[i];
+			copymem(&dst[i * 2], &v, 2);
+		} else {
+			uint32_t v = src[i];
+			copymem(&dst[i * 4], &v, 4);
+		}
+	}
+
+	return OK;
+}
+
+void VisualServer::mesh_add_surface_from_buffers(RID p_mesh, PrimitiveType p_primitive, uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb) {
+
+	ERR_FAIL_INDEX(p_primitive, VS::PRIMITIVE_MAX);
+	ERR_FAIL_COND(mesh_surface_validate_buffers(p_format, p_vertex_array, p_vertex_count, p_index_array, p_index_count) != OK);
+
+	// The buffers are already in the rasterizer layout, so they are passed
+	// through by reference, without being unpacked or repacked.
+	AABB aabb = p_aabb;
+	if (aabb == AABB()) {
+		aabb = mesh_surface_get_buffer_aabb(p_format, p_vertex_array, p_vertex_count);
+	}
+
+	mesh_add_surface(p_mesh, p_format, p_primitive, p_vertex_array, p_vertex_count, p_index_array, p_index_count, aabb);
+}
+
 Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_t> p_vertex_data, int p_vertex_len, PoolVector<uint8_t> p_index_data, int p_index_len) const {
 
 	uint32_t offsets[ARRAY_MAX];
@@ -1694,11 +1822,13 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_format_offset", "format", "vertex_len", "index_len", "array_index"), &VisualServer::mesh_surface_get_format_offset);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_format_stride", "format", "vertex_len", "index_len"), &VisualServer::mesh_surface_get_format_stride);
 	ClassDB::bind_method(D_METHOD("mesh_add_surface_from_arrays", "mesh", "primitive", "arrays", "blend_shapes", "compress_format"), &VisualServer::mesh_add_surface_from_arrays, DEFVAL(Array()), DEFVAL(ARRAY_COMPRESS_DEFAULT));
+	ClassDB::bind_method(D_METHOD("mesh_add_surface_from_buffers", "mesh", "primitive", "format", "vertex_array", "vertex_count", "index_array", "index_count", "aabb"), &VisualServer::mesh_add_surface_from_buffers, DEFVAL(PoolVector<uint8_t>()), DEFVAL(0), DEFVAL(AABB()));
 	ClassDB::bind_method(D_METHOD("mesh_set_blend_shape_count", "mesh", "amount"), &VisualServer::mesh_set_blend_shape_count);
 	ClassDB::bind_method(D_METHOD("mesh_get_blend_shape_count", "mesh"), &VisualServer::mesh_get_blend_shape_count);
 	ClassDB::bind_method(D_METHOD("mesh_set_blend_shape_mode", "mesh", "mode"), &VisualServer::mesh_set_blend_shape_mode);
 	ClassDB::bind_method(D_METHOD("mesh_get_blend_shape_mode", "mesh"), &VisualServer::mesh_get_blend_shape_mode);
 	ClassDB::bind_method(D_METHOD("mesh_surface_update_region", "mesh", "surface", "offset", "data"), &VisualServer::mesh_surface_update_region);
+	ClassDB::bind_method(D_METHOD("mesh_surface_update_index_region", "mesh", "surface", "offset", "data"), &VisualServer::mesh_surface_update_index_region);
 	ClassDB::bind_method(D_METHOD("mesh_surface_set_material", "mesh", "surface", "material"), &VisualServer::mesh_surface_set_material);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_material", "mesh", "surface"), &VisualServer::mesh_surface_get_material);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_array_len", "mesh", "surface"), &VisualServer::mesh_surface_get_array_len);
@@ -1755,6 +1885,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("skeleton_get_bone_count", "skeleton"), &VisualServer::skeleton_get_bone_count);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform", "skeleton", "bone", "transform"), &VisualServer::skeleton_bone_set_transform);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform", "skeleton", "bone"), &VisualServer::skeleton_bone_get_transform);
+	ClassDB::bind_method(D_METHOD("skeleton_set_as_bulk_array", "skeleton", "array"), &VisualServer::skeleton_set_as_bulk_array);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform_2d", "skeleton", "bone", "transform"), &VisualServer::skeleton_bone_set_transform_2d);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform_2d", "skeleton", "bone"), &VisualServer::skeleton_bone_get_transform_2d);
 
@@ -2256,6 +2387,8 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_ITEMS_JOINED_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -284,6 +284,11 @@ public:
 	/// Returns stride
 	virtual uint32_t mesh_surface_make_offsets_from_format(uint32_t p_format, int p_vertex_len, int p_index_len, uint32_t *r_offsets) const;
 	virtual void mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes = Array(), uint32_t p_compress_format = ARRAY_COMPRESS_DEFAULT);
+	virtual void mesh_add_surface_from_buffers(RID p_mesh, PrimitiveType p_primitive, uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array = PoolVector<uint8_t>(), int p_index_count = 0, const AABB &p_aabb = AABB());
+	virtual Error mesh_surface_validate_buffers(uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count) const;
+	virtual AABB mesh_surface_get_buffer_aabb(uint32_t p_format, const PoolVector<uint8_t> &p_vertex_array, int p_vertex_count) const;
+	virtual Error mesh_surface_pack_vertex_arrays(uint32_t p_format, const Array &p_arrays, PoolVector<uint8_t> &r_vertex_array, int &r_vertex_count);
+	virtual Error mesh_surface_pack_index_array(int p_vertex_count, const PoolVector<int> &p_indices, PoolVector<uint8_t> &r_index_array) const;
 	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>()) = 0;
 
 	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_amount) = 0;
@@ -298,6 +303,7 @@ public:
 	virtual BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const = 0;
 
 	virtual void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) = 0;
+	virtual void mesh_surface_update_index_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) = 0;
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) = 0;
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const = 0;
@@ -395,6 +401,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) = 0;
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
+	virtual void skeleton_set_as_bulk_array(RID p_skeleton, const PoolVector<float> &p_array) = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) = 0;
@@ -1024,6 +1031,8 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_BATCHES_IN_FRAME,
+		INFO_2D_ITEMS_JOINED_IN_FRAME,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;